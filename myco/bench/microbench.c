@@ -0,0 +1,422 @@
+/**
+ * @file microbench.c
+ * @brief Myco Microbenchmarks - Per-operation timings of interpreter internals
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file builds the myco_microbench binary (make microbench). The suite
+ * in performance/ times whole Myco programs; this one calls the subsystems
+ * underneath them directly - lexer, parser, variable environment, function
+ * calls, arrays, objects, sets and the memory tracker - so a slowdown can be
+ * traced to the layer that caused it. Every result is reported in ns/op,
+ * with what counts as one op named next to each benchmark.
+ *
+ * Microbenchmark Features:
+ * - Batches calibrated to at least 20 ms, one warmup batch, then timed samples
+ * - Median, min, p99 and stddev per op through the bench_stats summaries
+ * - Size sweeps (environment size, object width, set size, live allocations)
+ *   to expose operations whose cost grows with the data around them
+ * - Tracked blocks leaked per op, and one process per benchmark so that one
+ *   benchmark's leaks cannot slow the memory tracker down for the next
+ * - --json for one-line records, --filter to run a subset, --samples N
+ *
+ * Usage: ./myco_microbench [--json] [--samples N] [--filter TEXT]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lexer.h"
+#include "parser.h"
+#include "eval.h"
+#include "memory_tracker.h"
+#include "bench_stats.h"
+
+#ifndef _WIN32
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+extern void set_var_value(const char* name, long long value);
+
+#define MIN_BATCH_NS 20e6
+#define MAX_SAMPLES 100
+#define MAX_ITERATIONS (1LL << 32)
+
+// Runs one batch of iterations; stores the ops performed and returns the nanoseconds they took
+typedef double (*MicroBenchFn)(long long param, long long iterations, long long* ops);
+
+typedef struct {
+    const char* name;
+    const char* op;     // What one op is, for the report
+    MicroBenchFn run;
+    long long param;    // Size swept by the benchmark (0 if unused)
+} MicroBench;
+
+/*******************************************************************************
+ * LEXER AND PARSER
+ ******************************************************************************/
+
+static char* generated_source = NULL;
+
+// A few hundred lines covering declarations, expressions, strings, branches, loops and functions
+static const char* generate_source(void) {
+    if (generated_source) return generated_source;
+    const int blocks = 200;
+    size_t capacity = (size_t)blocks * 512;
+    generated_source = (char*)tracked_malloc(capacity, __FILE__, __LINE__, "microbench_source");
+    if (!generated_source) return NULL;
+    size_t length = 0;
+    for (int i = 0; i < blocks; i++) {
+        length += (size_t)snprintf(generated_source + length, capacity - length,
+            "let value_%d = %d * 3 + (%d - 1);\n"
+            "let name_%d = \"item_%d\";\n"
+            "if value_%d > 10:\n"
+            "    value_%d = value_%d - 1;\n"
+            "end\n"
+            "for i in 1..%d:\n"
+            "    value_%d = value_%d + i;\n"
+            "end\n"
+            "func helper_%d(x):\n"
+            "    return x + %d;\n"
+            "end\n",
+            i, i, i, i, i, i, i, i, i % 10 + 2, i, i, i, i);
+    }
+    return generated_source;
+}
+
+static long long count_tokens(const Token* tokens) {
+    long long count = 0;
+    while (tokens[count].type != TOKEN_EOF) count++;
+    return count;
+}
+
+static long long count_nodes(const ASTNode* node) {
+    long long count = 0;
+    for (; node; node = node->next) {
+        count++;
+        for (int i = 0; i < node->child_count; i++) count += count_nodes(&node->children[i]);
+    }
+    return count;
+}
+
+static double bench_lexer(long long param, long long iterations, long long* ops) {
+    (void)param;
+    const char* source = generate_source();
+    double elapsed = 0.0;
+    *ops = 0;
+    for (long long i = 0; i < iterations; i++) {
+        double start = bench_now_ns();
+        Token* tokens = lexer_tokenize(source);
+        elapsed += bench_now_ns() - start;
+        if (!tokens) break;
+        *ops += count_tokens(tokens);
+        lexer_free_tokens(tokens);
+    }
+    return elapsed;
+}
+
+static double bench_parser(long long param, long long iterations, long long* ops) {
+    (void)param;
+    Token* tokens = lexer_tokenize(generate_source());
+    double elapsed = 0.0;
+    *ops = 0;
+    for (long long i = 0; tokens && i < iterations; i++) {
+        double start = bench_now_ns();
+        ASTNode* ast = parser_parse(tokens);
+        elapsed += bench_now_ns() - start;
+        if (!ast) break;
+        *ops += count_nodes(ast);
+        parser_free_ast(ast);
+    }
+    lexer_free_tokens(tokens);
+    return elapsed;
+}
+
+/*******************************************************************************
+ * EVALUATOR
+ ******************************************************************************/
+
+// Declares param variables, then looks up the oldest one (lookups scan newest first)
+static double bench_variable_lookup(long long param, long long iterations, long long* ops) {
+    char name[32];
+    for (long long i = 0; i < param; i++) {
+        snprintf(name, sizeof(name), "bench_var_%lld", i);
+        set_var_value(name, i);
+    }
+    volatile long long sink = 0;
+    double start = bench_now_ns();
+    for (long long i = 0; i < iterations; i++) sink += eval_lookup_variable("bench_var_0");
+    double elapsed = bench_now_ns() - start;
+    (void)sink;
+    cleanup_all_environments();
+    *ops = iterations;
+    return elapsed;
+}
+
+static ASTNode* parse_program(const char* source, Token** tokens_out) {
+    Token* tokens = lexer_tokenize(source);
+    ASTNode* ast = tokens ? parser_parse(tokens) : NULL;
+    *tokens_out = tokens;
+    return ast;
+}
+
+static ASTNode* find_call(ASTNode* node) {
+    for (; node; node = node->next) {
+        if (node->text && strcmp(node->text, "call") == 0) return node;
+        for (int i = 0; i < node->child_count; i++) {
+            ASTNode* call = find_call(&node->children[i]);
+            if (call) return call;
+        }
+    }
+    return NULL;
+}
+
+// One call of a one-parameter user function, excluding the lookup of the function itself
+static double bench_function_call(long long param, long long iterations, long long* ops) {
+    (void)param;
+    Token* definition_tokens;
+    Token* call_tokens;
+    ASTNode* definition = parse_program("func bench_identity(x):\n    return x;\nend\n", &definition_tokens);
+    ASTNode* call_program = parse_program("bench_identity(7);\n", &call_tokens);
+    ASTNode* call = find_call(call_program);
+    double elapsed = 0.0;
+    *ops = 0;
+    if (definition && call) {
+        eval_evaluate(definition);
+        ASTNode* fn = eval_find_function("bench_identity");
+        if (fn) {
+            volatile long long sink = 0;
+            double start = bench_now_ns();
+            for (long long i = 0; i < iterations; i++) sink += eval_call_user_function(fn, call);
+            elapsed = bench_now_ns() - start;
+            (void)sink;
+            *ops = iterations;
+        }
+    }
+    eval_clear_function_asts();
+    cleanup_all_environments();
+    if (call_program) parser_free_ast(call_program);
+    if (definition) parser_free_ast(definition);
+    if (call_tokens) lexer_free_tokens(call_tokens);
+    if (definition_tokens) lexer_free_tokens(definition_tokens);
+    return elapsed;
+}
+
+/*******************************************************************************
+ * DATA STRUCTURES
+ ******************************************************************************/
+
+// Pushes onto a fresh array, growth included
+static double bench_array_push(long long param, long long iterations, long long* ops) {
+    (void)param;
+    MycoArray* array = create_array(0, 0);
+    if (!array) return 0.0;
+    double start = bench_now_ns();
+    for (long long value = 0; value < iterations; value++) array_push(array, &value);
+    double elapsed = bench_now_ns() - start;
+    destroy_array(array);
+    *ops = iterations;
+    return elapsed;
+}
+
+// Reads every property of a param-wide object in turn
+static double bench_object_get(long long param, long long iterations, long long* ops) {
+    MycoObject* object = create_object((int)param);
+    char** names = (char**)tracked_malloc((size_t)param * sizeof(char*), __FILE__, __LINE__, "microbench_names");
+    if (!object || !names) return 0.0;
+    char name[32];
+    for (long long i = 0; i < param; i++) {
+        snprintf(name, sizeof(name), "property_%lld", i);
+        object_set_property(object, name, (void*)(i + 1));
+        names[i] = tracked_strdup(name, __FILE__, __LINE__, "microbench_names");
+    }
+    volatile long long sink = 0;
+    long long index = 0;
+    double start = bench_now_ns();
+    for (long long i = 0; i < iterations; i++) {
+        sink += (long long)object_get_property(object, names[index]);
+        if (++index == param) index = 0;
+    }
+    double elapsed = bench_now_ns() - start;
+    (void)sink;
+    for (long long i = 0; i < param; i++) tracked_free(names[i], __FILE__, __LINE__, "microbench_names");
+    tracked_free(names, __FILE__, __LINE__, "microbench_names");
+    destroy_object(object);
+    *ops = iterations;
+    return elapsed;
+}
+
+// Fills a number set with param distinct values, iterations times over
+static double bench_set_add(long long param, long long iterations, long long* ops) {
+    double elapsed = 0.0;
+    for (long long i = 0; i < iterations; i++) {
+        MycoSet* set = create_set(0, 0);
+        if (!set) break;
+        double start = bench_now_ns();
+        for (long long value = 0; value < param; value++) set_add(set, &value);
+        elapsed += bench_now_ns() - start;
+        destroy_set(set);
+    }
+    *ops = iterations * param;
+    return elapsed;
+}
+
+/*******************************************************************************
+ * MEMORY TRACKER
+ ******************************************************************************/
+
+// Allocates and frees 64 bytes while param other tracked blocks are live
+static double bench_tracked_malloc(long long param, long long iterations, long long* ops) {
+    void** live = (void**)malloc((size_t)(param > 0 ? param : 1) * sizeof(void*));
+    if (!live) return 0.0;
+    for (long long i = 0; i < param; i++) live[i] = tracked_malloc(64, __FILE__, __LINE__, "microbench_live");
+    double start = bench_now_ns();
+    for (long long i = 0; i < iterations; i++) {
+        void* block = tracked_malloc(64, __FILE__, __LINE__, "microbench_block");
+        tracked_free(block, __FILE__, __LINE__, "microbench_block");
+    }
+    double elapsed = bench_now_ns() - start;
+    for (long long i = 0; i < param; i++) tracked_free(live[i], __FILE__, __LINE__, "microbench_live");
+    free(live);
+    *ops = iterations;
+    return elapsed;
+}
+
+static double bench_malloc(long long param, long long iterations, long long* ops) {
+    (void)param;
+    double start = bench_now_ns();
+    for (long long i = 0; i < iterations; i++) {
+        void* volatile block = malloc(64);
+        free(block);
+    }
+    double elapsed = bench_now_ns() - start;
+    *ops = iterations;
+    return elapsed;
+}
+
+/*******************************************************************************
+ * HARNESS
+ ******************************************************************************/
+
+static const MicroBench benchmarks[] = {
+    {"lexer_tokenize", "token", bench_lexer, 0},
+    {"parser_parse", "node", bench_parser, 0},
+    {"variable lookup (env 10)", "lookup", bench_variable_lookup, 10},
+    {"variable lookup (env 100)", "lookup", bench_variable_lookup, 100},
+    {"variable lookup (env 1000)", "lookup", bench_variable_lookup, 1000},
+    {"eval_user_function_call", "call", bench_function_call, 0},
+    {"array_push", "push", bench_array_push, 0},
+    {"object_get_property (width 4)", "get", bench_object_get, 4},
+    {"object_get_property (width 16)", "get", bench_object_get, 16},
+    {"object_get_property (width 64)", "get", bench_object_get, 64},
+    {"set_add (fill to 100)", "add", bench_set_add, 100},
+    {"set_add (fill to 1000)", "add", bench_set_add, 1000},
+    {"malloc + free (64 B)", "pair", bench_malloc, 0},
+    {"tracked_malloc + free (64 B, 0 live)", "pair", bench_tracked_malloc, 0},
+    {"tracked_malloc + free (64 B, 1000 live)", "pair", bench_tracked_malloc, 1000},
+};
+
+// Times one batch and returns nanoseconds per op (negative if the benchmark did nothing)
+static double run_batch(const MicroBench* bench, long long iterations, double* elapsed_out, long long* ops_out) {
+    long long ops = 0;
+    double elapsed = bench->run(bench->param, iterations, &ops);
+    if (elapsed_out) *elapsed_out = elapsed;
+    if (ops_out) *ops_out += ops;
+    return ops > 0 ? elapsed / (double)ops : -1.0;
+}
+
+static long long live_blocks(void) {
+    MemoryStats stats = get_memory_stats();
+    return (long long)stats.allocation_count - (long long)stats.free_count;
+}
+
+static int run_microbench(const MicroBench* bench, int samples, int as_json) {
+    // Grow the batch until it is long enough that timer resolution does not matter
+    long long iterations = 1;
+    double elapsed = 0.0;
+    for (;;) {
+        if (run_batch(bench, iterations, &elapsed, NULL) < 0.0) {
+            fprintf(stderr, "Error: microbenchmark '%s' performed no operations\n", bench->name);
+            return 0;
+        }
+        if (elapsed >= MIN_BATCH_NS || iterations >= MAX_ITERATIONS) break;
+        iterations *= elapsed * 10 < MIN_BATCH_NS ? 10 : 2;
+    }
+
+    double per_op_ns[MAX_SAMPLES];
+    long long ops = 0;
+    run_batch(bench, iterations, NULL, NULL);
+    long long live_before = live_blocks();
+    for (int i = 0; i < samples; i++) per_op_ns[i] = run_batch(bench, iterations, NULL, &ops);
+    double leaked_per_op = ops > 0 ? (double)(live_blocks() - live_before) / (double)ops : 0.0;
+
+    BenchSummary summary;
+    bench_summarize(per_op_ns, samples, iterations, &summary);
+    if (as_json) {
+        char* json = bench_summary_json(bench->name, &summary);
+        if (json) {
+            printf("%s\n", json);
+            tracked_free(json, __FILE__, __LINE__, "bench_json");
+        }
+    } else {
+        printf("%-42s %12.1f ns/%-7s (min %.1f, p99 %.1f, stddev %.1f)", bench->name, summary.median_ns,
+               bench->op, summary.min_ns, summary.p99_ns, summary.stddev_ns);
+        if (leaked_per_op > 0.0) printf("  leaks %.2f blocks/%s", leaked_per_op, bench->op);
+        printf("\n");
+    }
+    fflush(stdout);
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    int as_json = 0;
+    int samples = 5;
+    const char* filter = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            as_json = 1;
+        } else if (strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            samples = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--json] [--samples N] [--filter TEXT]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (samples < 1) samples = 1;
+    if (samples > MAX_SAMPLES) samples = MAX_SAMPLES;
+
+    memory_tracker_init();
+    init_implicit_functions();
+    init_libraries();
+
+    if (!as_json) {
+        printf("=== MYCO INTERPRETER MICROBENCHMARKS ===\n");
+        printf("Median of %d samples per benchmark\n\n", samples);
+    }
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if (filter && !strstr(benchmarks[i].name, filter)) continue;
+#ifndef _WIN32
+        // A fresh process per benchmark: the tracker's cost grows with live blocks, leaked or not
+        fflush(stdout);
+        pid_t child = fork();
+        if (child == 0) _exit(run_microbench(&benchmarks[i], samples, as_json) ? 0 : 1);
+        int status = 0;
+        if (child < 0 || waitpid(child, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) failures++;
+#else
+        if (!run_microbench(&benchmarks[i], samples, as_json)) failures++;
+#endif
+    }
+
+    if (generated_source) tracked_free(generated_source, __FILE__, __LINE__, "microbench_source");
+    cleanup_libraries();
+    cleanup_all_environments();
+    cleanup_implicit_functions();
+    memory_tracker_cleanup();
+    return failures ? 1 : 0;
+}
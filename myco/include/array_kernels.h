@@ -0,0 +1,26 @@
+#ifndef ARRAY_KERNELS_H
+#define ARRAY_KERNELS_H
+
+#include <stddef.h>
+
+// Element-wise arithmetic operators
+typedef enum {
+    ARRAY_OP_ADD,
+    ARRAY_OP_SUB,
+    ARRAY_OP_MUL,
+    ARRAY_OP_DIV
+} ArrayOp;
+
+// Unary kernels; dst must not overlap the inputs (restrict lets the compiler vectorize)
+void array_kernel_abs(long long* restrict dst, const long long* restrict src, size_t n);
+long array_kernel_sqrt(long long* restrict dst, const long long* restrict src, size_t n);
+void array_kernel_pow(long long* restrict dst, const long long* restrict src, size_t n, long long exponent);
+void array_kernel_floor_div(long long* restrict dst, const long long* restrict src, size_t n, long long divisor);
+void array_kernel_ceil_div(long long* restrict dst, const long long* restrict src, size_t n, long long divisor);
+void array_kernel_scale(long long* restrict dst, const long long* restrict src, size_t n, long long numerator, long long denominator);
+
+// Binary kernels; both return the index of the first zero divisor, or -1 when all went through
+long array_kernel_binary(long long* restrict dst, const long long* restrict a, const long long* restrict b, size_t n, ArrayOp op);
+long array_kernel_binary_scalar(long long* restrict dst, const long long* restrict a, long long scalar, size_t n, ArrayOp op, int scalar_first);
+
+#endif // ARRAY_KERNELS_H
@@ -0,0 +1,27 @@
+#ifndef BENCH_STATS_H
+#define BENCH_STATS_H
+
+#include <stddef.h>
+
+// Per-operation timing summary over a set of samples (all times in nanoseconds)
+typedef struct {
+    int samples;
+    long long iterations;    // Operations timed per sample
+    double min_ns;
+    double median_ns;
+    double mean_ns;
+    double stddev_ns;        // Sample standard deviation (0 for a single sample)
+    double p99_ns;           // Nearest-rank 99th percentile
+    double ops_per_sec;      // From the median
+} BenchSummary;
+
+// Monotonic clock reading in nanoseconds (unaffected by wall-clock changes)
+double bench_now_ns(void);
+
+// Summarizes n per-operation sample times; the samples are left unchanged
+void bench_summarize(const double* per_op_ns, int n, long long iterations, BenchSummary* out);
+
+// One-line JSON record of a summary; the caller frees the result with tracked_free
+char* bench_summary_json(const char* name, const BenchSummary* summary);
+
+#endif // BENCH_STATS_H
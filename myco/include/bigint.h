@@ -0,0 +1,30 @@
+#ifndef BIGINT_H
+#define BIGINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Arbitrary precision integer: sign and little-endian base 2^32 magnitude
+typedef struct {
+    uint32_t* limbs;
+    int size;                // Limbs in use (0 for zero, no leading zero limbs)
+    int negative;            // 1 for values below zero (zero is never negative)
+} BigInt;
+
+// Creation and conversion; every BigInt* returned is a tracked allocation owned by the caller
+BigInt* bigint_from_ll(long long value);
+BigInt* bigint_from_string(const char* text, size_t len);
+BigInt* bigint_copy(const BigInt* value);
+void bigint_free(BigInt* value);
+int bigint_fits_ll(const BigInt* value, long long* out);
+double bigint_to_double(const BigInt* value);
+char* bigint_to_string(const BigInt* value, size_t* out_len);
+
+// Arithmetic (NULL on allocation failure)
+int bigint_compare(const BigInt* a, const BigInt* b);
+BigInt* bigint_add(const BigInt* a, const BigInt* b);
+BigInt* bigint_sub(const BigInt* a, const BigInt* b);
+BigInt* bigint_mul(const BigInt* a, const BigInt* b);
+int bigint_divmod(const BigInt* a, const BigInt* b, BigInt** quotient, BigInt** remainder);
+
+#endif // BIGINT_H
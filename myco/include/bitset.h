@@ -0,0 +1,57 @@
+#ifndef BITSET_H
+#define BITSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Fixed-size bit array packed into 64-bit words; bits past size are always zero
+typedef struct {
+    uint64_t* words;
+    size_t size;             // Number of bits
+    size_t word_count;
+} Bitset;
+
+typedef enum {
+    BITSET_AND,
+    BITSET_OR,
+    BITSET_XOR
+} BitsetOp;
+
+// Bloom filter: hash_count probes into one bitset per item (double hashing)
+typedef struct {
+    Bitset bits;
+    int hash_count;
+    size_t count;            // Items added (duplicates included)
+} BloomFilter;
+
+Bitset* bitset_create(size_t size);
+void bitset_free(Bitset* bitset);
+
+// Single-bit operations; out-of-range indexes are ignored (test returns 0)
+void bitset_set(Bitset* bitset, size_t index);
+void bitset_clear(Bitset* bitset, size_t index);
+int bitset_test(const Bitset* bitset, size_t index);
+size_t bitset_count(const Bitset* bitset);
+
+// dst = dst op src over dst's size (src is treated as zero past its own size)
+void bitset_combine(Bitset* dst, const Bitset* src, BitsetOp op);
+
+// Bulk forms over an index array: set returns how many indexes were in range,
+// test writes 0/1 per index to hits (when not NULL) and returns the number set
+size_t bitset_set_many(Bitset* bitset, const long long* indexes, size_t n);
+size_t bitset_test_many(const Bitset* bitset, const long long* indexes, size_t n, unsigned char* hits);
+
+// Sized for expected_items at the given false-positive rate (0 < rate < 1)
+BloomFilter* bloom_create(size_t expected_items, double false_positive_rate);
+void bloom_free(BloomFilter* filter);
+
+// Item hashes; the same item always hashes the same way
+uint64_t bloom_hash_number(long long number);
+uint64_t bloom_hash_string(const char* text, size_t length);
+
+void bloom_add(BloomFilter* filter, uint64_t hash);
+int bloom_test(const BloomFilter* filter, uint64_t hash);
+void bloom_add_numbers(BloomFilter* filter, const long long* numbers, size_t n);
+size_t bloom_test_numbers(const BloomFilter* filter, const long long* numbers, size_t n, unsigned char* hits);
+
+#endif // BITSET_H
@@ -0,0 +1,59 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include <stddef.h>
+
+// Minimum degree: every node but the root holds BTREE_MIN_DEGREE - 1 to 2 * BTREE_MIN_DEGREE - 1 keys
+#define BTREE_MIN_DEGREE 16
+#define BTREE_MAX_KEYS (2 * BTREE_MIN_DEGREE - 1)
+#define BTREE_MAX_DEPTH 24
+
+// Key or value: a number or a string (text owned by the tree once stored); numbers order before strings
+typedef struct {
+    int is_string;
+    long long number;
+    char* text;
+} BTreeItem;
+
+typedef struct BTreeNode {
+    int count;
+    int leaf;
+    BTreeItem keys[BTREE_MAX_KEYS];
+    BTreeItem values[BTREE_MAX_KEYS];
+    struct BTreeNode* children[BTREE_MAX_KEYS + 1];
+} BTreeNode;
+
+typedef struct {
+    BTreeNode* root;
+    size_t size;
+} BTree;
+
+// In-order cursor; holds the path from the root, so stepping never allocates
+typedef struct {
+    BTreeNode* nodes[BTREE_MAX_DEPTH];
+    int indexes[BTREE_MAX_DEPTH];
+    int depth;
+} BTreeIterator;
+
+BTree* btree_create(void);
+void btree_free(BTree* tree);
+int btree_compare(const BTreeItem* a, const BTreeItem* b);
+
+// Lookups and updates (put copies key and value text; returns 0 on allocation failure)
+BTreeItem* btree_get(const BTree* tree, const BTreeItem* key);
+int btree_put(BTree* tree, const BTreeItem* key, const BTreeItem* value);
+int btree_remove(BTree* tree, const BTreeItem* key);
+
+// Ordered queries: each returns 0 when no such entry exists
+int btree_floor(const BTree* tree, const BTreeItem* key, const BTreeItem** out_key, const BTreeItem** out_value);
+int btree_ceiling(const BTree* tree, const BTreeItem* key, const BTreeItem** out_key, const BTreeItem** out_value);
+int btree_last(const BTree* tree, const BTreeItem** out_key, const BTreeItem** out_value);
+
+// Iteration from the first key >= from (from the smallest key when from is NULL)
+void btree_iter_seek(const BTree* tree, BTreeIterator* it, const BTreeItem* from);
+int btree_iter_next(BTreeIterator* it, const BTreeItem** key, const BTreeItem** value);
+
+// Builds a packed tree from strictly ascending keys in O(n); NULL if keys are not strictly ascending
+BTree* btree_bulk_load(const BTreeItem* keys, const BTreeItem* values, size_t n);
+
+#endif // BTREE_H
@@ -0,0 +1,36 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include <stddef.h>
+
+// Deque element: a number or a string (text owned by the deque)
+typedef struct {
+    int is_string;
+    long long number;
+    char* text;
+} DequeItem;
+
+// Growable ring buffer; element i lives at items[(head + i) & (capacity - 1)]
+typedef struct {
+    DequeItem* items;
+    size_t head;
+    size_t size;
+    size_t capacity;         // Power of two
+} Deque;
+
+Deque* deque_create(size_t initial_capacity);
+void deque_free(Deque* deque);
+void deque_clear(Deque* deque);
+
+// Pushes copy the item text; return 0 on allocation failure
+int deque_push_back(Deque* deque, const DequeItem* item);
+int deque_push_front(Deque* deque, const DequeItem* item);
+// Pops move the item into *out (caller owns its text); return 0 when empty
+int deque_pop_back(Deque* deque, DequeItem* out);
+int deque_pop_front(Deque* deque, DequeItem* out);
+
+// Indexed access from the front (NULL when out of range)
+DequeItem* deque_at(const Deque* deque, size_t index);
+int deque_set(Deque* deque, size_t index, const DequeItem* item);
+
+#endif // DEQUE_H
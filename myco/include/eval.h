@@ -22,6 +22,9 @@ typedef struct {
 #define LEFT_ASSOC  0
 #define RIGHT_ASSOC 1
 
+// Buffer shared between an array and the slice views taken from it
+typedef struct MycoArrayStorage MycoArrayStorage;
+
 // Array data structure
 typedef struct {
     long long* elements;     // Dynamic array of integers
@@ -29,15 +32,20 @@ typedef struct {
     int capacity;            // Current allocated capacity
     int size;                // Current number of elements
     int is_string_array;     // Flag for string vs integer arrays
+    MycoArrayStorage* shared; // Non-NULL while the elements live in a shared buffer (copied on first write)
 } MycoArray;
 
 // Property type enumeration
 typedef enum {
     PROP_TYPE_NUMBER,   // Numeric value (long long cast to void*)
     PROP_TYPE_STRING,   // String value (char*)
-    PROP_TYPE_OBJECT    // Nested object (MycoObject*)
+    PROP_TYPE_OBJECT,   // Nested object (MycoObject*)
+    PROP_TYPE_FLOAT     // Float value (double bits stored in the void* slot)
 } PropertyType;
 
+// Property layout shared by every object built from the same object literal
+typedef struct ObjectShape ObjectShape;
+
 // Object data structure for key-value pairs
 typedef struct MycoObject {
     char** property_names;      // Dynamic array of property names
@@ -46,6 +54,7 @@ typedef struct MycoObject {
     int property_count;         // Current number of properties
     int capacity;               // Current allocated capacity
     int is_method;              // Flag for future method support
+    ObjectShape* shape;         // Non-NULL while names come from a literal's shape (values and types share this allocation)
 } MycoObject;
 
 // Set data structure for unique collections
@@ -64,6 +73,12 @@ void* array_get(MycoArray* array, int index);
 const char* array_get_string(MycoArray* array, int index);
 int array_set(MycoArray* array, int index, void* element);
 int array_size(MycoArray* array);
+MycoArray* array_view(MycoArray* source, int start, int length);
+MycoArray* array_copy(MycoArray* source);
+int array_reserve(MycoArray* array, int min_capacity);
+int array_shrink_to_fit(MycoArray* array);
+int array_pop(MycoArray* array);
+int array_make_writable(MycoArray* array);
 int array_capacity(MycoArray* array);
 void cleanup_array_env();
 MycoArray* get_array_value(const char* name);
@@ -100,6 +115,11 @@ void eval_clear_function_asts();
 void cleanup_all_environments(void);
 void reset_test_environment(void);
 
+// Interpreter internals exposed for the C microbenchmarks (bench/microbench.c)
+long long eval_lookup_variable(const char* name);
+ASTNode* eval_find_function(const char* name);
+long long eval_call_user_function(ASTNode* fn, ASTNode* call);
+
 // String value management functions
 const char* get_str_value(const char* name);
 void set_str_value(const char* name, const char* value);
@@ -192,4 +212,4 @@ int ultra_fast_string_search(const char* haystack, const char* needle);
 void ultra_fast_array_sort(int* array, int size);
 long long ultra_fast_nested_loop(int start1, int end1, int start2, int end2);
 
-#endif // EVAL_H 
\ No newline at end of file
+#endif // EVAL_H 
\ No newline at end of file
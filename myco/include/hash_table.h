@@ -0,0 +1,52 @@
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Integer or string key; text is borrowed in lookups and owned by the table once stored
+typedef struct {
+    int is_string;
+    long long number;
+    const char* text;
+    size_t length;
+} HashKey;
+
+// Number or string value; text is owned by the table once stored
+typedef struct {
+    int is_string;
+    long long number;
+    char* text;
+} HashValue;
+
+typedef struct {
+    uint64_t hash;           // Cached key hash; 0 = empty slot, 1 = removed (old table only)
+    HashKey key;
+    HashValue value;
+} HashEntry;
+
+// Robin Hood open-addressing table that grows incrementally
+typedef struct {
+    HashEntry* slots;
+    size_t capacity;         // Power of two
+    size_t count;            // Entries in slots
+    HashEntry* old_slots;    // Table being drained after a resize (NULL when none)
+    size_t old_capacity;
+    size_t old_count;
+    size_t migrate_index;    // Next old slot to move
+} HashTable;
+
+HashTable* hash_table_create(size_t initial_capacity);
+void hash_table_free(HashTable* table);
+void hash_table_clear(HashTable* table);
+size_t hash_table_size(const HashTable* table);
+
+// Lookups and updates (put copies key text and value text; returns 0 on allocation failure)
+HashValue* hash_table_get(HashTable* table, const HashKey* key);
+int hash_table_put(HashTable* table, const HashKey* key, const HashValue* value);
+int hash_table_remove(HashTable* table, const HashKey* key);
+
+// Iteration: start with *cursor = 0; returns 0 when every entry has been visited
+int hash_table_next(const HashTable* table, size_t* cursor, const HashKey** key, const HashValue** value);
+
+#endif // HASH_TABLE_H
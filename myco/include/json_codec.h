@@ -0,0 +1,57 @@
+#ifndef JSON_CODEC_H
+#define JSON_CODEC_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include "eval.h"
+
+// Kind of value produced by the parser
+typedef enum {
+    JSON_VALUE_NUMBER,          // Integers, true/false (1/0) and null (0)
+    JSON_VALUE_FLOAT,           // Numbers with a fraction or exponent
+    JSON_VALUE_STRING,          // Owned char*
+    JSON_VALUE_OBJECT,          // Owned MycoObject* (also arrays that are not all strings or all integers)
+    JSON_VALUE_ARRAY            // Owned MycoArray* (top-level arrays of only strings or only integers)
+} JsonValueType;
+
+typedef struct {
+    JsonValueType type;
+    long long number;
+    double float_number;
+    char* string;
+    MycoObject* object;
+    MycoArray* array;
+} JsonValue;
+
+// Parsing (text must be NUL-terminated at len); results are tracked allocations owned by the caller
+int json_parse(const char* text, size_t len, JsonValue* out, char* error, size_t error_size);
+void json_value_free(JsonValue* value);
+void json_free_object(MycoObject* obj);
+
+// Streaming over the elements of a top-level array or over NDJSON records
+typedef struct JsonStream JsonStream;
+
+JsonStream* json_stream_open(char* text, size_t len);     // Takes over text
+JsonStream* json_stream_open_file(const char* filename); // Reads the file in chunks
+int json_stream_has_next(JsonStream* stream);
+int json_stream_next(JsonStream* stream, JsonValue* out, char* error, size_t error_size);
+void json_stream_close(JsonStream* stream);
+
+// Serialization into a growable buffer (file == NULL) or through a fixed buffer flushed to a file
+typedef struct {
+    char* data;
+    size_t len;
+    size_t capacity;
+    FILE* file;
+    int failed;
+} JsonWriter;
+
+void json_writer_init(JsonWriter* writer, FILE* file);
+void json_write_number(JsonWriter* writer, long long number);
+void json_write_float(JsonWriter* writer, double number);
+void json_write_string(JsonWriter* writer, const char* str, size_t len);
+void json_write_object(JsonWriter* writer, MycoObject* obj);
+void json_write_array(JsonWriter* writer, MycoArray* array);
+char* json_writer_finish(JsonWriter* writer, size_t* out_len);
+
+#endif // JSON_CODEC_H
@@ -0,0 +1,62 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <stddef.h>
+
+typedef enum {
+    MATRIX_INT64,
+    MATRIX_FLOAT64
+} MatrixType;
+
+// Dense 2-D matrix stored row-major in one buffer: element (r, c) is at r * cols + c.
+// Exactly one of ints/floats is allocated, matching type.
+typedef struct {
+    size_t rows;
+    size_t cols;
+    MatrixType type;
+    long long* ints;
+    double* floats;
+} Matrix;
+
+typedef enum {
+    MATRIX_ADD,
+    MATRIX_SUB,
+    MATRIX_MUL,
+    MATRIX_DIV
+} MatrixOp;
+
+typedef enum {
+    MATRIX_SUM,
+    MATRIX_MIN,
+    MATRIX_MAX,
+    MATRIX_MEAN
+} MatrixReduction;
+
+// Zero-filled matrix
+Matrix* matrix_create(size_t rows, size_t cols, MatrixType type);
+void matrix_free(Matrix* matrix);
+Matrix* matrix_copy(const Matrix* matrix);
+
+// Converts an integer matrix to float64 in place; returns 0 on allocation failure
+int matrix_promote(Matrix* matrix);
+double matrix_float_at(const Matrix* matrix, size_t row, size_t col);
+
+// Every function below returns a new matrix, or NULL on allocation failure.
+// Integer results that could overflow 64 bits are computed as float64 instead.
+
+// Rows [row_start, row_end) and columns [col_start, col_end); the caller checks the bounds
+Matrix* matrix_slice(const Matrix* matrix, size_t row_start, size_t row_end, size_t col_start, size_t col_end);
+Matrix* matrix_transpose(const Matrix* matrix);
+
+// Element-wise a op b (same shape; MATRIX_DIV always gives float64)
+Matrix* matrix_elementwise(const Matrix* a, const Matrix* b, MatrixOp op);
+Matrix* matrix_scale(const Matrix* matrix, int factor_is_float, long long int_factor, double float_factor);
+
+// axis -1 reduces everything to 1x1, 0 reduces each column (1 x cols), 1 each row (rows x 1).
+// MIN/MAX of an empty axis are 0; MEAN is always float64.
+Matrix* matrix_reduce(const Matrix* matrix, MatrixReduction reduction, int axis);
+
+// Cache-blocked product of a (n x k) and b (k x m); the caller checks a->cols == b->rows
+Matrix* matrix_matmul(const Matrix* a, const Matrix* b);
+
+#endif // MATRIX_H
@@ -0,0 +1,34 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include <stddef.h>
+
+// Queue element: numeric priority plus a number or string payload (text owned by the queue)
+typedef struct {
+    long long priority;
+    int is_string;
+    long long number;
+    char* text;
+} PriorityItem;
+
+// Contiguous 4-ary heap; the front is the smallest priority (or largest when is_max)
+typedef struct {
+    PriorityItem* items;
+    size_t size;
+    size_t capacity;
+    int is_max;
+} PriorityQueue;
+
+PriorityQueue* priority_queue_create(int is_max, size_t initial_capacity);
+void priority_queue_free(PriorityQueue* queue);
+
+// push copies the payload text; returns 0 on allocation failure
+int priority_queue_push(PriorityQueue* queue, const PriorityItem* item);
+const PriorityItem* priority_queue_peek(const PriorityQueue* queue);
+// Moves the front item into *out (caller owns its text); returns 0 when empty
+int priority_queue_pop(PriorityQueue* queue, PriorityItem* out);
+
+// Builds the heap over priorities[0..n) (payload = priority) in O(n)
+PriorityQueue* priority_queue_heapify(int is_max, const long long* priorities, size_t n);
+
+#endif // PRIORITY_QUEUE_H
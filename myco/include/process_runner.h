@@ -0,0 +1,30 @@
+#ifndef PROCESS_RUNNER_H
+#define PROCESS_RUNNER_H
+
+#include <stddef.h>
+
+// Options controlling how a child process is started
+typedef struct {
+    int use_shell;          // Run argv[0] through /bin/sh -c instead of exec'ing argv directly
+    int capture_output;     // Capture stdout/stderr through pipes (otherwise inherit the parent's)
+    long timeout_ms;        // Kill the child after this many milliseconds (0 = no timeout)
+} ProcessOptions;
+
+// Outcome of a finished child process
+typedef struct {
+    int exit_code;          // Exit status, or 128 + signal number if killed by a signal
+    int timed_out;          // 1 if the child was killed because the timeout expired
+    int spawn_failed;       // 1 if the child could not be started at all
+    char* stdout_data;      // Captured stdout (NUL-terminated, "" when not captured)
+    size_t stdout_len;      // Bytes of captured stdout
+    char* stderr_data;      // Captured stderr (NUL-terminated, "" when not captured)
+    size_t stderr_len;      // Bytes of captured stderr
+    double duration_ms;     // Wall-clock time from spawn to reap
+} ProcessResult;
+
+// Function prototypes
+int process_run(char* const argv[], const ProcessOptions* options, ProcessResult* result);
+int process_run_pool(char** const argvs[], int count, const ProcessOptions* options, int max_parallel, ProcessResult* results);
+void process_result_free(ProcessResult* result);
+
+#endif // PROCESS_RUNNER_H
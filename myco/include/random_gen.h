@@ -0,0 +1,27 @@
+#ifndef RANDOM_GEN_H
+#define RANDOM_GEN_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// xoshiro256** generator state; any number of independent generators may coexist
+typedef struct {
+    uint64_t s[4];
+} RandomState;
+
+// Seeding and streams
+void random_seed(RandomState* state, uint64_t seed);
+void random_seed_stream(RandomState* state, uint64_t seed, uint64_t stream);
+
+// Single draws
+uint64_t random_next(RandomState* state);
+double random_double(RandomState* state);
+uint64_t random_below(RandomState* state, uint64_t bound);
+long long random_range(RandomState* state, long long min, long long max);
+
+// Bulk operations over typed buffers
+void random_fill_range(RandomState* state, long long* dst, size_t n, long long min, long long max);
+void random_shuffle_numbers(RandomState* state, long long* values, size_t n);
+void random_shuffle_strings(RandomState* state, char** values, size_t n);
+
+#endif // RANDOM_GEN_H
@@ -0,0 +1,21 @@
+#ifndef REGEX_ENGINE_H
+#define REGEX_ENGINE_H
+
+#include <stddef.h>
+
+// Upper bound on capture groups in one pattern (group 0 is the whole match)
+#define REGEX_MAX_GROUPS 32
+
+typedef struct Regex Regex;
+
+// Compilation
+Regex* regex_compile(const char* pattern, size_t pattern_len, char* error, size_t error_size);
+void regex_free(Regex* re);
+int regex_group_count(const Regex* re);
+
+// Matching (all linear in the text length)
+int regex_is_match(Regex* re, const char* text, size_t len);
+int regex_full_match(Regex* re, const char* text, size_t len);
+int regex_search(Regex* re, const char* text, size_t len, size_t start, long* groups);
+
+#endif // REGEX_ENGINE_H
@@ -0,0 +1,30 @@
+#ifndef STRING_KERNELS_H
+#define STRING_KERNELS_H
+
+#include <stddef.h>
+#include "eval.h"
+
+// Precompiled substring searcher, reusable across any number of haystacks
+typedef struct {
+    char* needle;               // Owned copy of the needle
+    size_t needle_len;          // Needle length in bytes
+    int use_shift_table;        // 1 for long needles searched with Horspool shifts
+    size_t shift[256];          // Horspool bad-character shift per byte value
+} StringSearcher;
+
+StringSearcher* string_searcher_create(const char* needle, size_t needle_len);
+void string_searcher_destroy(StringSearcher* searcher);
+const char* string_searcher_find(const StringSearcher* searcher, const char* haystack, size_t haystack_len);
+size_t string_searcher_count(const StringSearcher* searcher, const char* haystack, size_t haystack_len);
+
+// One-off substring search and counting (non-overlapping, left to right)
+const char* string_find_bytes(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len);
+size_t string_count_occurrences(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len);
+
+// Single-pass split/join/replace; results are tracked allocations owned by the caller
+MycoArray* string_split(const char* str, size_t len, const char* delimiter, size_t delimiter_len);
+char* string_join(MycoArray* array, const char* separator, size_t separator_len, size_t* out_len);
+char* string_replace_all(const char* str, size_t len, const char* old_str, size_t old_len,
+                         const char* new_str, size_t new_len, size_t* out_len);
+
+#endif // STRING_KERNELS_H
@@ -0,0 +1,31 @@
+#ifndef STRING_TEMPLATE_H
+#define STRING_TEMPLATE_H
+
+#include <stddef.h>
+
+// One piece of a compiled template: literal text or a ${name} slot
+typedef struct {
+    const char* text;           // Literal bytes, or the NUL-terminated slot name
+    size_t len;
+    int is_slot;
+} TemplatePart;
+
+// Template split once into literal segments and slots; rendering never re-scans the text
+typedef struct {
+    char* storage;              // Owned copy of the source the parts point into
+    TemplatePart* parts;
+    int part_count;
+    int slot_count;
+    size_t literal_len;         // Total bytes of literal text
+} StringTemplate;
+
+// Resolves a slot name to its text; scratch (TEMPLATE_SCRATCH_SIZE bytes) may hold formatted numbers.
+// Returning NULL leaves the slot as written ("${name}").
+#define TEMPLATE_SCRATCH_SIZE 32
+typedef const char* (*TemplateResolver)(void* context, const char* name, size_t* value_len, char* scratch);
+
+StringTemplate* string_template_compile(const char* text, size_t len);
+void string_template_free(StringTemplate* tpl);
+char* string_template_render(const StringTemplate* tpl, TemplateResolver resolve, void* context, size_t* out_len);
+
+#endif // STRING_TEMPLATE_H
@@ -0,0 +1,205 @@
+/**
+ * @file array_kernels.c
+ * @brief Myco Array Kernels - Element-wise math over number arrays
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the array overloads of the math library. Each
+ * kernel is a flat loop over contiguous long long buffers with restrict
+ * qualified pointers and no calls or early exits in the hot loop, so the
+ * compiler can vectorize it. Argument checks that could fail (negative
+ * square roots, zero divisors) run as a separate scan before the loop.
+ *
+ * Array Kernel Features:
+ * - abs, sqrt, pow, floor/ceil division and rational scaling
+ * - +, -, *, / between two arrays or an array and a scalar
+ * - Two's complement wrap-around on overflow (no undefined behaviour)
+ * - pow evaluated by squaring across a block of elements at a time
+ */
+
+#include "array_kernels.h"
+#include <math.h>
+
+// Elements processed together by the blocked pow kernel
+#define POW_BLOCK 256
+
+/*******************************************************************************
+ * UNARY KERNELS
+ ******************************************************************************/
+
+void array_kernel_abs(long long* restrict dst, const long long* restrict src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        unsigned long long mask = (unsigned long long)(src[i] >> 63);
+        dst[i] = (long long)(((unsigned long long)src[i] ^ mask) - mask);
+    }
+}
+
+/**
+ * @brief Integer square root of every element
+ * @return Index of the first negative element (dst untouched), or -1 on success
+ */
+long array_kernel_sqrt(long long* restrict dst, const long long* restrict src, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (src[i] < 0) return (long)i;
+    }
+    for (size_t i = 0; i < n; i++) {
+        long long x = src[i];
+        long long r = (long long)sqrt((double)x);
+        // The double estimate can be off by one for values above 2^52
+        while (r > 0 && r > x / r) r--;
+        while ((r + 1) <= x / (r + 1)) r++;
+        dst[i] = r;
+    }
+    return -1;
+}
+
+/**
+ * @brief Raises every element to a fixed integer power
+ *
+ * Non-negative exponents use exponentiation by squaring, applied to a
+ * block of elements per step so each inner loop is a plain multiply.
+ * Negative exponents follow integer truncation (only 1 and -1 survive).
+ */
+void array_kernel_pow(long long* restrict dst, const long long* restrict src, size_t n, long long exponent) {
+    if (exponent < 0) {
+        for (size_t i = 0; i < n; i++) {
+            long long x = src[i];
+            dst[i] = x == 1 ? 1 : x == -1 ? ((exponent & 1) ? -1 : 1) : 0;
+        }
+        return;
+    }
+
+    unsigned long long base[POW_BLOCK];
+    unsigned long long acc[POW_BLOCK];
+    for (size_t start = 0; start < n; start += POW_BLOCK) {
+        size_t m = n - start < POW_BLOCK ? n - start : POW_BLOCK;
+        for (size_t i = 0; i < m; i++) {
+            base[i] = (unsigned long long)src[start + i];
+            acc[i] = 1;
+        }
+        for (unsigned long long e = (unsigned long long)exponent; e; e >>= 1) {
+            if (e & 1) {
+                for (size_t i = 0; i < m; i++) acc[i] *= base[i];
+            }
+            if (e > 1) {
+                for (size_t i = 0; i < m; i++) base[i] *= base[i];
+            }
+        }
+        for (size_t i = 0; i < m; i++) dst[start + i] = (long long)acc[i];
+    }
+}
+
+// Quotient x / d rounded toward negative infinity (d != 0)
+static long long floor_div(long long x, long long d) {
+    if (d == -1) return (long long)(0ULL - (unsigned long long)x);
+    long long q = x / d;
+    if ((x % d != 0) && ((x < 0) != (d < 0))) q--;
+    return q;
+}
+
+// Quotient x / d rounded toward positive infinity (d != 0)
+static long long ceil_div(long long x, long long d) {
+    if (d == -1) return (long long)(0ULL - (unsigned long long)x);
+    long long q = x / d;
+    if ((x % d != 0) && ((x < 0) == (d < 0))) q++;
+    return q;
+}
+
+// Callers guarantee divisor != 0
+void array_kernel_floor_div(long long* restrict dst, const long long* restrict src, size_t n, long long divisor) {
+    for (size_t i = 0; i < n; i++) dst[i] = floor_div(src[i], divisor);
+}
+
+void array_kernel_ceil_div(long long* restrict dst, const long long* restrict src, size_t n, long long divisor) {
+    for (size_t i = 0; i < n; i++) dst[i] = ceil_div(src[i], divisor);
+}
+
+/**
+ * @brief Multiplies every element by numerator / denominator (truncating)
+ *
+ * The intermediate product is kept in 128 bits where the compiler has
+ * them, so scaling large values does not overflow before the division.
+ * Callers guarantee denominator != 0.
+ */
+void array_kernel_scale(long long* restrict dst, const long long* restrict src, size_t n, long long numerator, long long denominator) {
+#ifdef __SIZEOF_INT128__
+    for (size_t i = 0; i < n; i++) {
+        __int128 product = (__int128)src[i] * numerator;
+        dst[i] = (long long)(product / denominator);
+    }
+#else
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = (long long)(((double)src[i] * (double)numerator) / (double)denominator);
+    }
+#endif
+}
+
+/*******************************************************************************
+ * BINARY KERNELS
+ ******************************************************************************/
+
+// x / d truncating toward zero, with LLONG_MIN / -1 wrapping instead of trapping (d != 0)
+static long long wrap_div(long long x, long long d) {
+    if (d == -1) return (long long)(0ULL - (unsigned long long)x);
+    return x / d;
+}
+
+/**
+ * @brief dst[i] = a[i] op b[i]
+ * @return Index of the first zero divisor for ARRAY_OP_DIV (dst untouched), or -1
+ */
+long array_kernel_binary(long long* restrict dst, const long long* restrict a, const long long* restrict b, size_t n, ArrayOp op) {
+    switch (op) {
+        case ARRAY_OP_ADD:
+            for (size_t i = 0; i < n; i++) dst[i] = (long long)((unsigned long long)a[i] + (unsigned long long)b[i]);
+            break;
+        case ARRAY_OP_SUB:
+            for (size_t i = 0; i < n; i++) dst[i] = (long long)((unsigned long long)a[i] - (unsigned long long)b[i]);
+            break;
+        case ARRAY_OP_MUL:
+            for (size_t i = 0; i < n; i++) dst[i] = (long long)((unsigned long long)a[i] * (unsigned long long)b[i]);
+            break;
+        case ARRAY_OP_DIV:
+            for (size_t i = 0; i < n; i++) {
+                if (b[i] == 0) return (long)i;
+            }
+            for (size_t i = 0; i < n; i++) dst[i] = wrap_div(a[i], b[i]);
+            break;
+    }
+    return -1;
+}
+
+/**
+ * @brief dst[i] = a[i] op scalar, or scalar op a[i] when scalar_first is set
+ * @return Index of the first zero divisor for ARRAY_OP_DIV (dst untouched), or -1
+ */
+long array_kernel_binary_scalar(long long* restrict dst, const long long* restrict a, long long scalar, size_t n, ArrayOp op, int scalar_first) {
+    unsigned long long s = (unsigned long long)scalar;
+    switch (op) {
+        case ARRAY_OP_ADD:
+            for (size_t i = 0; i < n; i++) dst[i] = (long long)((unsigned long long)a[i] + s);
+            break;
+        case ARRAY_OP_SUB:
+            if (scalar_first) {
+                for (size_t i = 0; i < n; i++) dst[i] = (long long)(s - (unsigned long long)a[i]);
+            } else {
+                for (size_t i = 0; i < n; i++) dst[i] = (long long)((unsigned long long)a[i] - s);
+            }
+            break;
+        case ARRAY_OP_MUL:
+            for (size_t i = 0; i < n; i++) dst[i] = (long long)((unsigned long long)a[i] * s);
+            break;
+        case ARRAY_OP_DIV:
+            if (scalar_first) {
+                for (size_t i = 0; i < n; i++) {
+                    if (a[i] == 0) return (long)i;
+                }
+                for (size_t i = 0; i < n; i++) dst[i] = wrap_div(scalar, a[i]);
+            } else {
+                if (scalar == 0) return 0;
+                for (size_t i = 0; i < n; i++) dst[i] = wrap_div(a[i], scalar);
+            }
+            break;
+    }
+    return -1;
+}
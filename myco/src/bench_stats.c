@@ -0,0 +1,111 @@
+/**
+ * @file bench_stats.c
+ * @brief Myco Benchmark Statistics - Monotonic timing and sample summaries
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the measurement side of test.bench(): a monotonic
+ * nanosecond clock and the statistics reported for a set of timed samples.
+ * A single CPU-time reading from clock() says little about a change of a
+ * few percent; a distribution over several samples, each long enough to
+ * swamp the clock's resolution, does.
+ *
+ * Benchmark Statistics Features:
+ * - CLOCK_MONOTONIC timing (QueryPerformanceCounter on Windows)
+ * - Min, median, mean, sample standard deviation and nearest-rank p99
+ * - Operations per second from the median, which outliers do not drag
+ * - Compact one-line JSON records for result files and comparison tools
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#include "bench_stats.h"
+#include "memory_tracker.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+double bench_now_ns(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+#endif
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+void bench_summarize(const double* per_op_ns, int n, long long iterations, BenchSummary* out) {
+    memset(out, 0, sizeof(*out));
+    out->samples = n;
+    out->iterations = iterations;
+    if (n <= 0) return;
+
+    double* sorted = (double*)tracked_malloc(n * sizeof(double), __FILE__, __LINE__, "bench_sorted_samples");
+    if (!sorted) return;
+    memcpy(sorted, per_op_ns, n * sizeof(double));
+    qsort(sorted, n, sizeof(double), compare_doubles);
+
+    double sum = 0.0;
+    for (int i = 0; i < n; i++) sum += sorted[i];
+    out->mean_ns = sum / n;
+
+    // Two-pass variance: no cancellation when the spread is tiny next to the mean
+    double squares = 0.0;
+    for (int i = 0; i < n; i++) squares += (sorted[i] - out->mean_ns) * (sorted[i] - out->mean_ns);
+    out->stddev_ns = n > 1 ? sqrt(squares / (n - 1)) : 0.0;
+
+    out->min_ns = sorted[0];
+    out->median_ns = n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+    int rank = (int)ceil(0.99 * n);
+    out->p99_ns = sorted[(rank > 0 ? rank : 1) - 1];
+    out->ops_per_sec = out->median_ns > 0.0 ? 1e9 / out->median_ns : 0.0;
+    tracked_free(sorted, __FILE__, __LINE__, "bench_sorted_samples");
+}
+
+char* bench_summary_json(const char* name, const BenchSummary* summary) {
+    // Escape the name; everything else is numeric
+    size_t name_len = strlen(name);
+    char* escaped = (char*)tracked_malloc(name_len * 6 + 1, __FILE__, __LINE__, "bench_json_name");
+    if (!escaped) return NULL;
+    char* dst = escaped;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            *dst++ = '\\';
+            *dst++ = (char)*p;
+        } else if (*p < 0x20) {
+            dst += sprintf(dst, "\\u%04x", *p);
+        } else {
+            *dst++ = (char)*p;
+        }
+    }
+    *dst = '\0';
+
+    const char* format = "{\"name\":\"%s\",\"samples\":%d,\"iterations\":%lld,\"min_ns\":%.1f,"
+                         "\"median_ns\":%.1f,\"mean_ns\":%.1f,\"stddev_ns\":%.1f,\"p99_ns\":%.1f,"
+                         "\"ops_per_sec\":%.1f}";
+    int length = snprintf(NULL, 0, format, escaped, summary->samples, summary->iterations, summary->min_ns,
+                          summary->median_ns, summary->mean_ns, summary->stddev_ns, summary->p99_ns,
+                          summary->ops_per_sec);
+    char* json = length >= 0 ? (char*)tracked_malloc((size_t)length + 1, __FILE__, __LINE__, "bench_json") : NULL;
+    if (json) {
+        snprintf(json, (size_t)length + 1, format, escaped, summary->samples, summary->iterations, summary->min_ns,
+                 summary->median_ns, summary->mean_ns, summary->stddev_ns, summary->p99_ns, summary->ops_per_sec);
+    }
+    tracked_free(escaped, __FILE__, __LINE__, "bench_json_name");
+    return json;
+}
@@ -0,0 +1,525 @@
+/**
+ * @file bigint.c
+ * @brief Myco Big Integers - Arbitrary precision integer arithmetic
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the integers that + - * / % promote to when a
+ * long long result would overflow. Values are a sign plus a little-endian
+ * magnitude of 32-bit limbs, so every limb product fits a uint64_t.
+ * Results that fit a long long again are demoted by the evaluator, which
+ * keeps ordinary arithmetic on the machine-integer fast path.
+ *
+ * Big Integer Features:
+ * - Schoolbook multiplication for small operands
+ * - Karatsuba multiplication above KARATSUBA_THRESHOLD limbs
+ * - Knuth long division (algorithm D) with truncating C semantics
+ * - Decimal parsing and printing in 9-digit chunks
+ */
+
+#include "bigint.h"
+#include "memory_tracker.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Operands with fewer limbs than this (about 1000 bits) multiply faster schoolbook
+#define KARATSUBA_THRESHOLD 32
+
+// Largest power of ten in a limb, used for decimal conversion
+#define DECIMAL_CHUNK 1000000000u
+#define DECIMAL_CHUNK_DIGITS 9
+
+/*******************************************************************************
+ * MAGNITUDE HELPERS
+ ******************************************************************************/
+
+static uint32_t* alloc_limbs(int count) {
+    return (uint32_t*)tracked_malloc((size_t)(count > 0 ? count : 1) * sizeof(uint32_t), __FILE__, __LINE__, "bigint_limbs");
+}
+
+static void free_limbs(uint32_t* limbs) {
+    tracked_free(limbs, __FILE__, __LINE__, "bigint_limbs");
+}
+
+static int mag_trim(const uint32_t* a, int n) {
+    while (n > 0 && a[n - 1] == 0) n--;
+    return n;
+}
+
+static int mag_compare(const uint32_t* a, int an, const uint32_t* b, int bn) {
+    if (an != bn) return an < bn ? -1 : 1;
+    for (int i = an - 1; i >= 0; i--) {
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// r = a + b; r needs max(an, bn) + 1 limbs and may alias a or b. Returns the length.
+static int mag_add(uint32_t* r, const uint32_t* a, int an, const uint32_t* b, int bn) {
+    if (an < bn) {
+        const uint32_t* t = a; a = b; b = t;
+        int tn = an; an = bn; bn = tn;
+    }
+    uint64_t carry = 0;
+    int i = 0;
+    for (; i < bn; i++) {
+        carry += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    for (; i < an; i++) {
+        carry += a[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry) r[i++] = (uint32_t)carry;
+    return i;
+}
+
+// r = a - b for a >= b; r needs an limbs and may alias a. Returns the trimmed length.
+static int mag_sub(uint32_t* r, const uint32_t* a, int an, const uint32_t* b, int bn) {
+    int64_t borrow = 0;
+    int i = 0;
+    for (; i < bn; i++) {
+        int64_t d = (int64_t)a[i] - b[i] - borrow;
+        borrow = d < 0;
+        r[i] = (uint32_t)d;
+    }
+    for (; i < an; i++) {
+        int64_t d = (int64_t)a[i] - borrow;
+        borrow = d < 0;
+        r[i] = (uint32_t)d;
+    }
+    return mag_trim(r, an);
+}
+
+// r[shift..rn) += a
+static void mag_add_at(uint32_t* r, int rn, const uint32_t* a, int an, int shift) {
+    uint64_t carry = 0;
+    int i = 0;
+    for (; i < an; i++) {
+        carry += (uint64_t)r[i + shift] + a[i];
+        r[i + shift] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    for (i += shift; carry && i < rn; i++) {
+        carry += r[i];
+        r[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+}
+
+static void mag_mul_schoolbook(uint32_t* r, const uint32_t* a, int an, const uint32_t* b, int bn) {
+    memset(r, 0, (size_t)(an + bn) * sizeof(uint32_t));
+    for (int i = 0; i < an; i++) {
+        uint64_t ai = a[i];
+        if (!ai) continue;
+        uint64_t carry = 0;
+        for (int j = 0; j < bn; j++) {
+            uint64_t t = ai * b[j] + r[i + j] + carry;
+            r[i + j] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        r[i + bn] = (uint32_t)carry;
+    }
+}
+
+/**
+ * @brief r = a * b; r needs an + bn limbs and must not alias a or b
+ *
+ * Karatsuba: with a = a1*B^m + a0 and b = b1*B^m + b0,
+ * a*b = z2*B^2m + ((a0+a1)(b0+b1) - z2 - z0)*B^m + z0 where z0 = a0*b0 and
+ * z2 = a1*b1, i.e. three half-size products instead of four. An operand
+ * much shorter than the other is handled by splitting only the longer one.
+ */
+static int mag_mul(uint32_t* r, const uint32_t* a, int an, const uint32_t* b, int bn) {
+    if (an < bn) {
+        const uint32_t* t = a; a = b; b = t;
+        int tn = an; an = bn; bn = tn;
+    }
+    if (bn < KARATSUBA_THRESHOLD) {
+        mag_mul_schoolbook(r, a, an, b, bn);
+        return 1;
+    }
+
+    int rn = an + bn;
+    int m = an / 2;
+    memset(r, 0, (size_t)rn * sizeof(uint32_t));
+
+    if (bn <= m) {
+        // Unbalanced: r = a0*b + (a1*b)*B^m
+        int a0n = mag_trim(a, m);
+        int tn = an - m + bn;
+        uint32_t* t = alloc_limbs(tn);
+        if (!t) return 0;
+        int ok = mag_mul(r, a, a0n, b, bn) && mag_mul(t, a + m, an - m, b, bn);
+        if (ok) mag_add_at(r, rn, t, tn, m);
+        free_limbs(t);
+        return ok;
+    }
+
+    int a0n = mag_trim(a, m), b0n = mag_trim(b, m);
+    int a1n = an - m, b1n = bn - m;
+    int s1cap = (a1n > m ? a1n : m) + 1, s2cap = (b1n > m ? b1n : m) + 1;
+    uint32_t* s1 = alloc_limbs(s1cap);
+    uint32_t* s2 = alloc_limbs(s2cap);
+    uint32_t* z1 = alloc_limbs(s1cap + s2cap);
+    int ok = s1 && s2 && z1;
+    if (ok) {
+        // z0 and z2 land directly in their final places
+        ok = mag_mul(r, a, a0n, b, b0n) && mag_mul(r + 2 * m, a + m, a1n, b + m, b1n);
+    }
+    if (ok) {
+        int s1n = mag_add(s1, a, a0n, a + m, a1n);
+        int s2n = mag_add(s2, b, b0n, b + m, b1n);
+        ok = mag_mul(z1, s1, s1n, s2, s2n);
+        if (ok) {
+            int z1n = mag_trim(z1, s1n + s2n);
+            z1n = mag_sub(z1, z1, z1n, r, mag_trim(r, 2 * m));
+            z1n = mag_sub(z1, z1, z1n, r + 2 * m, mag_trim(r + 2 * m, rn - 2 * m));
+            mag_add_at(r, rn, z1, z1n, m);
+        }
+    }
+    if (s1) free_limbs(s1);
+    if (s2) free_limbs(s2);
+    if (z1) free_limbs(z1);
+    return ok;
+}
+
+static int leading_zeros(uint32_t x) {
+    int n = 0;
+    if (x <= 0x0000FFFFu) { n += 16; x <<= 16; }
+    if (x <= 0x00FFFFFFu) { n += 8; x <<= 8; }
+    if (x <= 0x0FFFFFFFu) { n += 4; x <<= 4; }
+    if (x <= 0x3FFFFFFFu) { n += 2; x <<= 2; }
+    if (x <= 0x7FFFFFFFu) { n += 1; }
+    return n;
+}
+
+/**
+ * @brief q = u / v and r = u % v for magnitudes with m >= n >= 1 and v[n-1] != 0
+ *
+ * Knuth's algorithm D: the divisor is normalized so its top bit is set,
+ * which keeps every estimated quotient digit at most two too large.
+ * q needs m - n + 1 limbs and r needs n limbs.
+ */
+static int mag_divmod(uint32_t* q, uint32_t* r, const uint32_t* u, int m, const uint32_t* v, int n) {
+    const uint64_t base = 4294967296ULL;
+    if (n == 1) {
+        uint64_t rem = 0;
+        for (int j = m - 1; j >= 0; j--) {
+            uint64_t cur = rem * base + u[j];
+            q[j] = (uint32_t)(cur / v[0]);
+            rem = cur - (uint64_t)q[j] * v[0];
+        }
+        r[0] = (uint32_t)rem;
+        return 1;
+    }
+
+    int s = leading_zeros(v[n - 1]);
+    uint32_t* vn = alloc_limbs(n);
+    uint32_t* un = alloc_limbs(m + 1);
+    if (!vn || !un) {
+        if (vn) free_limbs(vn);
+        if (un) free_limbs(un);
+        return 0;
+    }
+    for (int i = n - 1; i > 0; i--) vn[i] = (v[i] << s) | (uint32_t)((uint64_t)v[i - 1] >> (32 - s));
+    vn[0] = v[0] << s;
+    un[m] = (uint32_t)((uint64_t)u[m - 1] >> (32 - s));
+    for (int i = m - 1; i > 0; i--) un[i] = (u[i] << s) | (uint32_t)((uint64_t)u[i - 1] >> (32 - s));
+    un[0] = u[0] << s;
+
+    for (int j = m - n; j >= 0; j--) {
+        uint64_t top = ((uint64_t)un[j + n] << 32) | un[j + n - 1];
+        uint64_t qhat = top / vn[n - 1];
+        uint64_t rhat = top - qhat * vn[n - 1];
+        while (qhat >= base || qhat * vn[n - 2] > ((rhat << 32) | un[j + n - 2])) {
+            qhat--;
+            rhat += vn[n - 1];
+            if (rhat >= base) break;
+        }
+
+        // Multiply and subtract qhat * vn from un[j..j+n]
+        int64_t borrow = 0;
+        uint64_t carry = 0;
+        for (int i = 0; i < n; i++) {
+            uint64_t p = qhat * vn[i] + carry;
+            carry = p >> 32;
+            int64_t t = (int64_t)un[i + j] - (int64_t)(uint32_t)p - borrow;
+            un[i + j] = (uint32_t)t;
+            borrow = t < 0;
+        }
+        int64_t t = (int64_t)un[j + n] - (int64_t)carry - borrow;
+        un[j + n] = (uint32_t)t;
+
+        q[j] = (uint32_t)qhat;
+        if (t < 0) {
+            // qhat was one too large: add the divisor back
+            q[j]--;
+            uint64_t c = 0;
+            for (int i = 0; i < n; i++) {
+                c += (uint64_t)un[i + j] + vn[i];
+                un[i + j] = (uint32_t)c;
+                c >>= 32;
+            }
+            un[j + n] += (uint32_t)c;
+        }
+    }
+
+    for (int i = 0; i < n - 1; i++) r[i] = (un[i] >> s) | (uint32_t)((uint64_t)un[i + 1] << (32 - s));
+    r[n - 1] = un[n - 1] >> s;
+    free_limbs(vn);
+    free_limbs(un);
+    return 1;
+}
+
+/*******************************************************************************
+ * CREATION AND CONVERSION
+ ******************************************************************************/
+
+// Wrap a limb buffer (ownership moves to the result)
+static BigInt* bigint_wrap(uint32_t* limbs, int size, int negative) {
+    BigInt* value = (BigInt*)tracked_malloc(sizeof(BigInt), __FILE__, __LINE__, "bigint");
+    if (!value) {
+        free_limbs(limbs);
+        return NULL;
+    }
+    value->limbs = limbs;
+    value->size = mag_trim(limbs, size);
+    value->negative = value->size > 0 && negative;
+    return value;
+}
+
+BigInt* bigint_from_ll(long long v) {
+    uint32_t* limbs = alloc_limbs(2);
+    if (!limbs) return NULL;
+    uint64_t mag = v < 0 ? 0ULL - (uint64_t)v : (uint64_t)v;
+    limbs[0] = (uint32_t)mag;
+    limbs[1] = (uint32_t)(mag >> 32);
+    return bigint_wrap(limbs, 2, v < 0);
+}
+
+/**
+ * @brief Parses an optionally signed decimal integer
+ * @return The value, or NULL if the text is not all digits
+ */
+BigInt* bigint_from_string(const char* text, size_t len) {
+    int negative = 0;
+    size_t i = 0;
+    if (len > 0 && (text[0] == '-' || text[0] == '+')) {
+        negative = text[0] == '-';
+        i = 1;
+    }
+    if (i == len) return NULL;
+    // Each 9-digit chunk adds just under 30 bits
+    int capacity = (int)((len - i) / DECIMAL_CHUNK_DIGITS) + 2;
+    uint32_t* limbs = alloc_limbs(capacity);
+    if (!limbs) return NULL;
+    int size = 0;
+
+    size_t first = (len - i) % DECIMAL_CHUNK_DIGITS;
+    if (first == 0) first = DECIMAL_CHUNK_DIGITS;
+    while (i < len) {
+        uint32_t chunk = 0, scale = 1;
+        for (size_t k = 0; k < first; k++, i++) {
+            if (text[i] < '0' || text[i] > '9') {
+                free_limbs(limbs);
+                return NULL;
+            }
+            chunk = chunk * 10 + (uint32_t)(text[i] - '0');
+            scale *= 10;
+        }
+        first = DECIMAL_CHUNK_DIGITS;
+        // limbs = limbs * scale + chunk
+        uint64_t carry = chunk;
+        for (int k = 0; k < size; k++) {
+            uint64_t t = (uint64_t)limbs[k] * scale + carry;
+            limbs[k] = (uint32_t)t;
+            carry = t >> 32;
+        }
+        if (carry) limbs[size++] = (uint32_t)carry;
+    }
+    return bigint_wrap(limbs, size, negative);
+}
+
+BigInt* bigint_copy(const BigInt* value) {
+    uint32_t* limbs = alloc_limbs(value->size);
+    if (!limbs) return NULL;
+    memcpy(limbs, value->limbs, (size_t)value->size * sizeof(uint32_t));
+    return bigint_wrap(limbs, value->size, value->negative);
+}
+
+void bigint_free(BigInt* value) {
+    if (!value) return;
+    free_limbs(value->limbs);
+    tracked_free(value, __FILE__, __LINE__, "bigint");
+}
+
+// Whether the value fits a long long (stored in *out when it does)
+int bigint_fits_ll(const BigInt* value, long long* out) {
+    if (value->size > 2) return 0;
+    uint64_t mag = value->size > 0 ? value->limbs[0] : 0;
+    if (value->size > 1) mag |= (uint64_t)value->limbs[1] << 32;
+    if (value->negative) {
+        if (mag > (uint64_t)1 << 63) return 0;
+        *out = (long long)(0ULL - mag);
+    } else {
+        if (mag > (uint64_t)LLONG_MAX) return 0;
+        *out = (long long)mag;
+    }
+    return 1;
+}
+
+double bigint_to_double(const BigInt* value) {
+    double result = 0.0;
+    for (int i = value->size - 1; i >= 0; i--) result = result * 4294967296.0 + value->limbs[i];
+    return value->negative ? -result : result;
+}
+
+/**
+ * @brief Formats the value in decimal
+ * @return New NUL-terminated string (tracked), or NULL on allocation failure
+ */
+char* bigint_to_string(const BigInt* value, size_t* out_len) {
+    // Chunks of 9 digits, least significant first, by repeated short division
+    int chunk_capacity = value->size * 32 / 29 + 2;
+    uint32_t* chunks = alloc_limbs(chunk_capacity);
+    uint32_t* work = alloc_limbs(value->size);
+    char* text = NULL;
+    if (chunks && work) {
+        memcpy(work, value->limbs, (size_t)value->size * sizeof(uint32_t));
+        int n = value->size, count = 0;
+        while (n > 0) {
+            uint64_t rem = 0;
+            for (int j = n - 1; j >= 0; j--) {
+                uint64_t cur = (rem << 32) | work[j];
+                work[j] = (uint32_t)(cur / DECIMAL_CHUNK);
+                rem = cur % DECIMAL_CHUNK;
+            }
+            chunks[count++] = (uint32_t)rem;
+            n = mag_trim(work, n);
+        }
+        if (count == 0) chunks[count++] = 0;
+
+        size_t capacity = (size_t)count * DECIMAL_CHUNK_DIGITS + 2;
+        text = (char*)tracked_malloc(capacity, __FILE__, __LINE__, "bigint_to_string");
+        if (text) {
+            size_t len = 0;
+            if (value->negative) text[len++] = '-';
+            // Leading chunk without padding, the rest zero-padded to 9 digits
+            uint32_t top = chunks[count - 1];
+            char digits[DECIMAL_CHUNK_DIGITS];
+            int d = 0;
+            do {
+                digits[d++] = (char)('0' + top % 10);
+                top /= 10;
+            } while (top);
+            while (d > 0) text[len++] = digits[--d];
+            for (int c = count - 2; c >= 0; c--) {
+                uint32_t chunk = chunks[c];
+                for (int k = DECIMAL_CHUNK_DIGITS - 1; k >= 0; k--) {
+                    text[len + (size_t)k] = (char)('0' + chunk % 10);
+                    chunk /= 10;
+                }
+                len += DECIMAL_CHUNK_DIGITS;
+            }
+            text[len] = '\0';
+            if (out_len) *out_len = len;
+        }
+    }
+    if (chunks) free_limbs(chunks);
+    if (work) free_limbs(work);
+    return text;
+}
+
+/*******************************************************************************
+ * ARITHMETIC
+ ******************************************************************************/
+
+int bigint_compare(const BigInt* a, const BigInt* b) {
+    if (a->negative != b->negative) return a->negative ? -1 : 1;
+    int c = mag_compare(a->limbs, a->size, b->limbs, b->size);
+    return a->negative ? -c : c;
+}
+
+// a + (b_negative ? -|b| : |b|)
+static BigInt* signed_add(const BigInt* a, const BigInt* b, int b_negative) {
+    int n = (a->size > b->size ? a->size : b->size) + 1;
+    uint32_t* limbs = alloc_limbs(n);
+    if (!limbs) return NULL;
+    if (a->negative == b_negative) {
+        int size = mag_add(limbs, a->limbs, a->size, b->limbs, b->size);
+        return bigint_wrap(limbs, size, a->negative);
+    }
+    // Opposite signs: subtract the smaller magnitude from the larger
+    if (mag_compare(a->limbs, a->size, b->limbs, b->size) >= 0) {
+        int size = mag_sub(limbs, a->limbs, a->size, b->limbs, b->size);
+        return bigint_wrap(limbs, size, a->negative);
+    }
+    int size = mag_sub(limbs, b->limbs, b->size, a->limbs, a->size);
+    return bigint_wrap(limbs, size, b_negative);
+}
+
+BigInt* bigint_add(const BigInt* a, const BigInt* b) {
+    return signed_add(a, b, b->negative);
+}
+
+BigInt* bigint_sub(const BigInt* a, const BigInt* b) {
+    return signed_add(a, b, b->size > 0 && !b->negative);
+}
+
+BigInt* bigint_mul(const BigInt* a, const BigInt* b) {
+    int n = a->size + b->size;
+    uint32_t* limbs = alloc_limbs(n);
+    if (!limbs) return NULL;
+    if (!mag_mul(limbs, a->limbs, a->size, b->limbs, b->size)) {
+        free_limbs(limbs);
+        return NULL;
+    }
+    return bigint_wrap(limbs, n, a->negative != b->negative);
+}
+
+/**
+ * @brief Truncating division: the quotient rounds toward zero and the
+ *        remainder takes the dividend's sign, matching C's / and %
+ * @param quotient Set to a / b (may be NULL)
+ * @param remainder Set to a % b (may be NULL)
+ * @return 1 on success, 0 if b is zero or allocation failed
+ */
+int bigint_divmod(const BigInt* a, const BigInt* b, BigInt** quotient, BigInt** remainder) {
+    if (b->size == 0) return 0;
+    int qn = a->size >= b->size ? a->size - b->size + 1 : 1;
+    uint32_t* q = alloc_limbs(qn);
+    uint32_t* r = alloc_limbs(b->size > a->size ? b->size : a->size);
+    if (!q || !r) {
+        if (q) free_limbs(q);
+        if (r) free_limbs(r);
+        return 0;
+    }
+    int rn;
+    if (mag_compare(a->limbs, a->size, b->limbs, b->size) < 0) {
+        // |a| < |b|: quotient 0, remainder a
+        memset(q, 0, (size_t)qn * sizeof(uint32_t));
+        memcpy(r, a->limbs, (size_t)a->size * sizeof(uint32_t));
+        rn = a->size;
+    } else if (!mag_divmod(q, r, a->limbs, a->size, b->limbs, b->size)) {
+        free_limbs(q);
+        free_limbs(r);
+        return 0;
+    } else {
+        rn = b->size;
+    }
+
+    BigInt* qv = bigint_wrap(q, qn, a->negative != b->negative);
+    BigInt* rv = bigint_wrap(r, rn, a->negative);
+    if (!qv || !rv) {
+        bigint_free(qv);
+        bigint_free(rv);
+        return 0;
+    }
+    if (quotient) *quotient = qv; else bigint_free(qv);
+    if (remainder) *remainder = rv; else bigint_free(rv);
+    return 1;
+}
@@ -0,0 +1,489 @@
+/**
+ * @file btree.c
+ * @brief Myco B-Trees - Ordered maps with wide nodes
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the ordered map behind data.create_binary_tree().
+ * Each node holds up to BTREE_MAX_KEYS sorted keys in one block, so a
+ * lookup touches a handful of nodes (about log32 n) instead of one
+ * pointer per level as in a binary search tree.
+ *
+ * B-Tree Features:
+ * - Single-pass insert and delete (nodes are split or refilled on the way
+ *   down, never revisited on the way up)
+ * - Floor, ceiling, minimum and maximum lookups
+ * - In-order iterators that keep their path in a fixed array, so range
+ *   scans do not allocate per step
+ * - O(n) bulk loading of sorted input into packed nodes
+ * - Number and string keys (numbers order before strings)
+ */
+
+#include "btree.h"
+#include "memory_tracker.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define T BTREE_MIN_DEGREE
+
+/*******************************************************************************
+ * ITEMS AND NODES
+ ******************************************************************************/
+
+int btree_compare(const BTreeItem* a, const BTreeItem* b) {
+    if (a->is_string != b->is_string) return a->is_string ? 1 : -1;
+    if (a->is_string) return strcmp(a->text, b->text);
+    return a->number < b->number ? -1 : a->number > b->number;
+}
+
+static int copy_item(BTreeItem* dst, const BTreeItem* src) {
+    BTreeItem copy = *src;
+    if (src->is_string) {
+        copy.text = tracked_strdup(src->text ? src->text : "", __FILE__, __LINE__, "btree_item");
+        if (!copy.text) return 0;
+    } else {
+        copy.text = NULL;
+    }
+    *dst = copy;
+    return 1;
+}
+
+static void free_item(BTreeItem* item) {
+    if (item->is_string) tracked_free(item->text, __FILE__, __LINE__, "btree_item");
+}
+
+static BTreeNode* create_node(int leaf) {
+    BTreeNode* node = (BTreeNode*)tracked_malloc(sizeof(BTreeNode), __FILE__, __LINE__, "btree_node");
+    if (!node) return NULL;
+    node->count = 0;
+    node->leaf = leaf;
+    return node;
+}
+
+static void free_node(BTreeNode* node) {
+    for (int i = 0; i < node->count; i++) {
+        free_item(&node->keys[i]);
+        free_item(&node->values[i]);
+    }
+    if (!node->leaf) {
+        for (int i = 0; i <= node->count; i++) free_node(node->children[i]);
+    }
+    tracked_free(node, __FILE__, __LINE__, "btree_node");
+}
+
+// Index of the first key >= key (binary search over the node's sorted keys)
+static int lower_bound(const BTreeNode* node, const BTreeItem* key) {
+    int lo = 0, hi = node->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (btree_compare(&node->keys[mid], key) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+/*******************************************************************************
+ * INSERTION
+ ******************************************************************************/
+
+// Split the full child i of node around its median, which moves up into node
+static int split_child(BTreeNode* node, int i) {
+    BTreeNode* full = node->children[i];
+    BTreeNode* right = create_node(full->leaf);
+    if (!right) return 0;
+    right->count = T - 1;
+    memcpy(right->keys, full->keys + T, (T - 1) * sizeof(BTreeItem));
+    memcpy(right->values, full->values + T, (T - 1) * sizeof(BTreeItem));
+    if (!full->leaf) memcpy(right->children, full->children + T, T * sizeof(BTreeNode*));
+    full->count = T - 1;
+
+    memmove(node->children + i + 2, node->children + i + 1, (node->count - i) * sizeof(BTreeNode*));
+    memmove(node->keys + i + 1, node->keys + i, (node->count - i) * sizeof(BTreeItem));
+    memmove(node->values + i + 1, node->values + i, (node->count - i) * sizeof(BTreeItem));
+    node->children[i + 1] = right;
+    node->keys[i] = full->keys[T - 1];
+    node->values[i] = full->values[T - 1];
+    node->count++;
+    return 1;
+}
+
+static int replace_value(BTreeItem* slot, const BTreeItem* value) {
+    BTreeItem copy;
+    if (!copy_item(&copy, value)) return 0;
+    free_item(slot);
+    *slot = copy;
+    return 1;
+}
+
+BTree* btree_create(void) {
+    BTree* tree = (BTree*)tracked_malloc(sizeof(BTree), __FILE__, __LINE__, "btree");
+    if (!tree) return NULL;
+    tree->root = create_node(1);
+    tree->size = 0;
+    if (!tree->root) {
+        tracked_free(tree, __FILE__, __LINE__, "btree");
+        return NULL;
+    }
+    return tree;
+}
+
+void btree_free(BTree* tree) {
+    if (!tree) return;
+    free_node(tree->root);
+    tracked_free(tree, __FILE__, __LINE__, "btree");
+}
+
+BTreeItem* btree_get(const BTree* tree, const BTreeItem* key) {
+    BTreeNode* node = tree->root;
+    for (;;) {
+        int i = lower_bound(node, key);
+        if (i < node->count && btree_compare(&node->keys[i], key) == 0) return &node->values[i];
+        if (node->leaf) return NULL;
+        node = node->children[i];
+    }
+}
+
+int btree_put(BTree* tree, const BTreeItem* key, const BTreeItem* value) {
+    if (tree->root->count == BTREE_MAX_KEYS) {
+        BTreeNode* root = create_node(0);
+        if (!root) return 0;
+        root->children[0] = tree->root;
+        if (!split_child(root, 0)) {
+            tracked_free(root, __FILE__, __LINE__, "btree_node");
+            return 0;
+        }
+        tree->root = root;
+    }
+
+    // Descend, splitting full children first so a leaf always has room
+    BTreeNode* node = tree->root;
+    for (;;) {
+        int i = lower_bound(node, key);
+        if (i < node->count && btree_compare(&node->keys[i], key) == 0) return replace_value(&node->values[i], value);
+        if (node->leaf) {
+            BTreeItem key_copy, value_copy;
+            if (!copy_item(&key_copy, key)) return 0;
+            if (!copy_item(&value_copy, value)) {
+                free_item(&key_copy);
+                return 0;
+            }
+            memmove(node->keys + i + 1, node->keys + i, (node->count - i) * sizeof(BTreeItem));
+            memmove(node->values + i + 1, node->values + i, (node->count - i) * sizeof(BTreeItem));
+            node->keys[i] = key_copy;
+            node->values[i] = value_copy;
+            node->count++;
+            tree->size++;
+            return 1;
+        }
+        if (node->children[i]->count == BTREE_MAX_KEYS) {
+            if (!split_child(node, i)) return 0;
+            int cmp = btree_compare(key, &node->keys[i]);
+            if (cmp == 0) return replace_value(&node->values[i], value);
+            if (cmp > 0) i++;
+        }
+        node = node->children[i];
+    }
+}
+
+/*******************************************************************************
+ * DELETION
+ ******************************************************************************/
+
+// Fold child i + 1 and separator i into child i
+static void merge_children(BTreeNode* node, int i) {
+    BTreeNode* left = node->children[i];
+    BTreeNode* right = node->children[i + 1];
+    left->keys[left->count] = node->keys[i];
+    left->values[left->count] = node->values[i];
+    memcpy(left->keys + left->count + 1, right->keys, right->count * sizeof(BTreeItem));
+    memcpy(left->values + left->count + 1, right->values, right->count * sizeof(BTreeItem));
+    if (!left->leaf) memcpy(left->children + left->count + 1, right->children, (right->count + 1) * sizeof(BTreeNode*));
+    left->count += right->count + 1;
+
+    memmove(node->keys + i, node->keys + i + 1, (node->count - i - 1) * sizeof(BTreeItem));
+    memmove(node->values + i, node->values + i + 1, (node->count - i - 1) * sizeof(BTreeItem));
+    memmove(node->children + i + 1, node->children + i + 2, (node->count - i - 1) * sizeof(BTreeNode*));
+    node->count--;
+    tracked_free(right, __FILE__, __LINE__, "btree_node");
+}
+
+/**
+ * @brief Makes sure child i holds at least T keys before the delete descends into it
+ * @return Index of the child to descend into (it moves left after merging with the left sibling)
+ */
+static int refill_child(BTreeNode* node, int i) {
+    BTreeNode* child = node->children[i];
+    if (child->count >= T) return i;
+
+    if (i > 0 && node->children[i - 1]->count >= T) {
+        // Rotate through the separator from the left sibling
+        BTreeNode* left = node->children[i - 1];
+        memmove(child->keys + 1, child->keys, child->count * sizeof(BTreeItem));
+        memmove(child->values + 1, child->values, child->count * sizeof(BTreeItem));
+        if (!child->leaf) memmove(child->children + 1, child->children, (child->count + 1) * sizeof(BTreeNode*));
+        child->keys[0] = node->keys[i - 1];
+        child->values[0] = node->values[i - 1];
+        if (!child->leaf) child->children[0] = left->children[left->count];
+        node->keys[i - 1] = left->keys[left->count - 1];
+        node->values[i - 1] = left->values[left->count - 1];
+        left->count--;
+        child->count++;
+        return i;
+    }
+    if (i < node->count && node->children[i + 1]->count >= T) {
+        // Rotate through the separator from the right sibling
+        BTreeNode* right = node->children[i + 1];
+        child->keys[child->count] = node->keys[i];
+        child->values[child->count] = node->values[i];
+        if (!child->leaf) child->children[child->count + 1] = right->children[0];
+        child->count++;
+        node->keys[i] = right->keys[0];
+        node->values[i] = right->values[0];
+        memmove(right->keys, right->keys + 1, (right->count - 1) * sizeof(BTreeItem));
+        memmove(right->values, right->values + 1, (right->count - 1) * sizeof(BTreeItem));
+        if (!right->leaf) memmove(right->children, right->children + 1, right->count * sizeof(BTreeNode*));
+        right->count--;
+        return i;
+    }
+    if (i < node->count) {
+        merge_children(node, i);
+        return i;
+    }
+    merge_children(node, i - 1);
+    return i - 1;
+}
+
+// Detach the largest (or smallest) entry of a subtree whose root holds at least T keys
+static void take_extreme(BTreeNode* node, int largest, BTreeItem* key, BTreeItem* value) {
+    while (!node->leaf) {
+        int i = refill_child(node, largest ? node->count : 0);
+        node = node->children[i];
+    }
+    if (largest) {
+        *key = node->keys[node->count - 1];
+        *value = node->values[node->count - 1];
+    } else {
+        *key = node->keys[0];
+        *value = node->values[0];
+        memmove(node->keys, node->keys + 1, (node->count - 1) * sizeof(BTreeItem));
+        memmove(node->values, node->values + 1, (node->count - 1) * sizeof(BTreeItem));
+    }
+    node->count--;
+}
+
+static int remove_from(BTreeNode* node, const BTreeItem* key) {
+    for (;;) {
+        int i = lower_bound(node, key);
+        if (i < node->count && btree_compare(&node->keys[i], key) == 0) {
+            if (node->leaf) {
+                free_item(&node->keys[i]);
+                free_item(&node->values[i]);
+                memmove(node->keys + i, node->keys + i + 1, (node->count - i - 1) * sizeof(BTreeItem));
+                memmove(node->values + i, node->values + i + 1, (node->count - i - 1) * sizeof(BTreeItem));
+                node->count--;
+                return 1;
+            }
+            if (node->children[i]->count >= T || node->children[i + 1]->count >= T) {
+                // Replace with the in-order neighbour from the fuller side
+                int from_left = node->children[i]->count >= T;
+                BTreeItem k, v;
+                take_extreme(node->children[from_left ? i : i + 1], from_left, &k, &v);
+                free_item(&node->keys[i]);
+                free_item(&node->values[i]);
+                node->keys[i] = k;
+                node->values[i] = v;
+                return 1;
+            }
+            // Both neighbours are minimal: merge them around the key and delete it from there
+            merge_children(node, i);
+            node = node->children[i];
+            continue;
+        }
+        if (node->leaf) return 0;
+        node = node->children[refill_child(node, i)];
+    }
+}
+
+int btree_remove(BTree* tree, const BTreeItem* key) {
+    int removed = remove_from(tree->root, key);
+    if (tree->root->count == 0 && !tree->root->leaf) {
+        // The root was merged away: the tree loses a level
+        BTreeNode* old = tree->root;
+        tree->root = old->children[0];
+        tracked_free(old, __FILE__, __LINE__, "btree_node");
+    }
+    if (removed) tree->size--;
+    return removed;
+}
+
+/*******************************************************************************
+ * ORDERED QUERIES
+ ******************************************************************************/
+
+int btree_floor(const BTree* tree, const BTreeItem* key, const BTreeItem** out_key, const BTreeItem** out_value) {
+    const BTreeNode* node = tree->root;
+    int found = 0;
+    for (;;) {
+        int i = lower_bound(node, key);
+        if (i < node->count && btree_compare(&node->keys[i], key) == 0) {
+            *out_key = &node->keys[i];
+            *out_value = &node->values[i];
+            return 1;
+        }
+        if (i > 0) {
+            // Best so far; the subtree between keys[i - 1] and keys[i] may hold a closer one
+            *out_key = &node->keys[i - 1];
+            *out_value = &node->values[i - 1];
+            found = 1;
+        }
+        if (node->leaf) return found;
+        node = node->children[i];
+    }
+}
+
+int btree_ceiling(const BTree* tree, const BTreeItem* key, const BTreeItem** out_key, const BTreeItem** out_value) {
+    BTreeIterator it;
+    btree_iter_seek(tree, &it, key);
+    return btree_iter_next(&it, out_key, out_value);
+}
+
+int btree_last(const BTree* tree, const BTreeItem** out_key, const BTreeItem** out_value) {
+    const BTreeNode* node = tree->root;
+    while (!node->leaf) node = node->children[node->count];
+    if (node->count == 0) return 0;
+    *out_key = &node->keys[node->count - 1];
+    *out_value = &node->values[node->count - 1];
+    return 1;
+}
+
+/*******************************************************************************
+ * ITERATION
+ ******************************************************************************/
+
+void btree_iter_seek(const BTree* tree, BTreeIterator* it, const BTreeItem* from) {
+    BTreeNode* node = tree->root;
+    it->depth = 0;
+    for (;;) {
+        int i = from ? lower_bound(node, from) : 0;
+        it->nodes[it->depth] = node;
+        it->indexes[it->depth] = i;
+        it->depth++;
+        // An exact match in an inner node is itself the next entry
+        if (node->leaf || (from && i < node->count && btree_compare(&node->keys[i], from) == 0)) return;
+        node = node->children[i];
+    }
+}
+
+int btree_iter_next(BTreeIterator* it, const BTreeItem** key, const BTreeItem** value) {
+    while (it->depth > 0) {
+        BTreeNode* node = it->nodes[it->depth - 1];
+        int i = it->indexes[it->depth - 1];
+        if (i >= node->count) {
+            it->depth--;
+            continue;
+        }
+        *key = &node->keys[i];
+        *value = &node->values[i];
+        it->indexes[it->depth - 1] = i + 1;
+        if (!node->leaf) {
+            // The next entries are the leftmost path of the subtree after this key
+            BTreeNode* child = node->children[i + 1];
+            for (;;) {
+                it->nodes[it->depth] = child;
+                it->indexes[it->depth] = 0;
+                it->depth++;
+                if (child->leaf) break;
+                child = child->children[0];
+            }
+        }
+        return 1;
+    }
+    return 0;
+}
+
+/*******************************************************************************
+ * BULK LOADING
+ ******************************************************************************/
+
+// Capacity of a subtree whose root sits at each height (leaves are height 0)
+static size_t subtree_capacity(int height) {
+    size_t capacity = BTREE_MAX_KEYS;
+    for (int h = 0; h < height; h++) capacity = capacity * (BTREE_MAX_KEYS + 1) + BTREE_MAX_KEYS;
+    return capacity;
+}
+
+/**
+ * @brief Builds a subtree of exactly the given height over n sorted entries
+ *
+ * A node uses the fewest children that can hold its entries and spreads
+ * the entries evenly, which keeps every non-root node at least half full.
+ */
+static BTreeNode* build_subtree(const BTreeItem* keys, const BTreeItem* values, size_t n, int height) {
+    BTreeNode* node = create_node(height == 0);
+    if (!node) return NULL;
+    if (height == 0) {
+        for (size_t i = 0; i < n; i++) {
+            if (!copy_item(&node->keys[i], &keys[i])) break;
+            if (!copy_item(&node->values[i], &values[i])) {
+                free_item(&node->keys[i]);
+                break;
+            }
+            node->count++;
+        }
+        if ((size_t)node->count == n) return node;
+        free_node(node);
+        return NULL;
+    }
+
+    size_t child_capacity = subtree_capacity(height - 1);
+    size_t children = (n + 1 + child_capacity) / (child_capacity + 1);
+    size_t per_child = (n - (children - 1)) / children;
+    size_t extra = (n - (children - 1)) % children;
+    size_t pos = 0;
+    for (size_t c = 0; c < children; c++) {
+        size_t take = per_child + (c < extra ? 1 : 0);
+        node->children[c] = build_subtree(keys + pos, values + pos, take, height - 1);
+        pos += take;
+        int ok = node->children[c] != NULL;
+        if (ok && c + 1 < children) {
+            ok = copy_item(&node->keys[c], &keys[pos]);
+            if (ok && !copy_item(&node->values[c], &values[pos])) {
+                free_item(&node->keys[c]);
+                ok = 0;
+            }
+            if (ok) node->count++;
+            pos++;
+        }
+        if (!ok) {
+            // Release what was built: count keys and the children around them
+            if (node->children[c] && (size_t)node->count == c) free_node(node->children[c]);
+            if (c == 0) {
+                tracked_free(node, __FILE__, __LINE__, "btree_node");
+            } else {
+                free_item(&node->keys[node->count - 1]);
+                free_item(&node->values[node->count - 1]);
+                node->count--;
+                free_node(node);
+            }
+            return NULL;
+        }
+    }
+    return node;
+}
+
+BTree* btree_bulk_load(const BTreeItem* keys, const BTreeItem* values, size_t n) {
+    for (size_t i = 1; i < n; i++) {
+        if (btree_compare(&keys[i - 1], &keys[i]) >= 0) return NULL;
+    }
+    BTree* tree = (BTree*)tracked_malloc(sizeof(BTree), __FILE__, __LINE__, "btree");
+    if (!tree) return NULL;
+    int height = 0;
+    while (subtree_capacity(height) < n) height++;
+    tree->root = build_subtree(keys, values, n, height);
+    tree->size = n;
+    if (!tree->root) {
+        tracked_free(tree, __FILE__, __LINE__, "btree");
+        return NULL;
+    }
+    return tree;
+}
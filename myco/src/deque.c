@@ -0,0 +1,136 @@
+/**
+ * @file deque.c
+ * @brief Myco Deques - Growable ring buffers
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the double-ended queue behind
+ * data.create_linked_list(). Elements sit in one contiguous ring buffer
+ * instead of separately allocated list nodes, so both ends are O(1)
+ * without pointer chasing, and removing from the front never shifts the
+ * remaining elements the way it does for an array.
+ *
+ * Deque Features:
+ * - O(1) amortized push and pop at both ends
+ * - O(1) indexed access and update
+ * - Power-of-two capacity, so wrapping is a mask instead of a division
+ * - Number and string elements
+ */
+
+#include "deque.h"
+#include "memory_tracker.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define DEQUE_MIN_CAPACITY 16
+
+static size_t slot_of(const Deque* deque, size_t index) {
+    return (deque->head + index) & (deque->capacity - 1);
+}
+
+// Grow to hold needed elements, unwrapping the ring so element 0 lands at slot 0
+static int reserve(Deque* deque, size_t needed) {
+    if (needed <= deque->capacity) return 1;
+    size_t capacity = deque->capacity ? deque->capacity : DEQUE_MIN_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+    DequeItem* items = (DequeItem*)tracked_malloc(capacity * sizeof(DequeItem), __FILE__, __LINE__, "deque_items");
+    if (!items) return 0;
+    if (deque->size > 0) {
+        // At most two contiguous runs: head..end of buffer, then the wrapped part
+        size_t first = deque->capacity - deque->head;
+        if (first > deque->size) first = deque->size;
+        memcpy(items, deque->items + deque->head, first * sizeof(DequeItem));
+        memcpy(items + first, deque->items, (deque->size - first) * sizeof(DequeItem));
+    }
+    if (deque->items) tracked_free(deque->items, __FILE__, __LINE__, "deque_items");
+    deque->items = items;
+    deque->capacity = capacity;
+    deque->head = 0;
+    return 1;
+}
+
+static int copy_item(DequeItem* dst, const DequeItem* src) {
+    DequeItem copy = *src;
+    if (src->is_string) {
+        copy.text = tracked_strdup(src->text ? src->text : "", __FILE__, __LINE__, "deque_item");
+        if (!copy.text) return 0;
+    } else {
+        copy.text = NULL;
+    }
+    *dst = copy;
+    return 1;
+}
+
+Deque* deque_create(size_t initial_capacity) {
+    Deque* deque = (Deque*)tracked_malloc(sizeof(Deque), __FILE__, __LINE__, "deque");
+    if (!deque) return NULL;
+    deque->items = NULL;
+    deque->head = 0;
+    deque->size = 0;
+    deque->capacity = 0;
+    if (!reserve(deque, initial_capacity > 0 ? initial_capacity : DEQUE_MIN_CAPACITY)) {
+        tracked_free(deque, __FILE__, __LINE__, "deque");
+        return NULL;
+    }
+    return deque;
+}
+
+void deque_clear(Deque* deque) {
+    for (size_t i = 0; i < deque->size; i++) {
+        DequeItem* item = &deque->items[slot_of(deque, i)];
+        if (item->is_string) tracked_free(item->text, __FILE__, __LINE__, "deque_item");
+    }
+    deque->head = 0;
+    deque->size = 0;
+}
+
+void deque_free(Deque* deque) {
+    if (!deque) return;
+    deque_clear(deque);
+    tracked_free(deque->items, __FILE__, __LINE__, "deque_items");
+    tracked_free(deque, __FILE__, __LINE__, "deque");
+}
+
+int deque_push_back(Deque* deque, const DequeItem* item) {
+    if (!reserve(deque, deque->size + 1)) return 0;
+    if (!copy_item(&deque->items[slot_of(deque, deque->size)], item)) return 0;
+    deque->size++;
+    return 1;
+}
+
+int deque_push_front(Deque* deque, const DequeItem* item) {
+    if (!reserve(deque, deque->size + 1)) return 0;
+    size_t slot = (deque->head - 1) & (deque->capacity - 1);
+    if (!copy_item(&deque->items[slot], item)) return 0;
+    deque->head = slot;
+    deque->size++;
+    return 1;
+}
+
+int deque_pop_back(Deque* deque, DequeItem* out) {
+    if (deque->size == 0) return 0;
+    deque->size--;
+    *out = deque->items[slot_of(deque, deque->size)];
+    return 1;
+}
+
+int deque_pop_front(Deque* deque, DequeItem* out) {
+    if (deque->size == 0) return 0;
+    *out = deque->items[deque->head];
+    deque->head = (deque->head + 1) & (deque->capacity - 1);
+    deque->size--;
+    return 1;
+}
+
+DequeItem* deque_at(const Deque* deque, size_t index) {
+    return index < deque->size ? &deque->items[slot_of(deque, index)] : NULL;
+}
+
+int deque_set(Deque* deque, size_t index, const DequeItem* item) {
+    DequeItem* slot = deque_at(deque, index);
+    DequeItem copy;
+    if (!slot || !copy_item(&copy, item)) return 0;
+    if (slot->is_string) tracked_free(slot->text, __FILE__, __LINE__, "deque_item");
+    *slot = copy;
+    return 1;
+}
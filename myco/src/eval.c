@@ -70,6 +70,21 @@
 #include "lexer.h"
 #include "config.h"
 #include "loop_manager.h"
+#include "process_runner.h"
+#include "string_kernels.h"
+#include "regex_engine.h"
+#include "json_codec.h"
+#include "string_template.h"
+#include "array_kernels.h"
+#include "random_gen.h"
+#include "bigint.h"
+#include "hash_table.h"
+#include "priority_queue.h"
+#include "deque.h"
+#include "btree.h"
+#include "bitset.h"
+#include "matrix.h"
+#include "bench_stats.h"
 #include <errno.h>
 #include <time.h>
 #include <math.h>
@@ -109,6 +124,7 @@ static long long call_type_system_function(const char* func_name, ASTNode* args_
 static long long call_language_polish_function(const char* func_name, ASTNode* args_node);
 static long long call_testing_framework_function(const char* func_name, ASTNode* args_node);
 static long long call_data_structures_function(const char* func_name, ASTNode* args_node);
+static MycoArray* library_array_argument(ASTNode* node, int* is_temporary);
 
 // Global library imports
 static LibraryImport* library_imports = NULL;
@@ -147,7 +163,13 @@ static int test_skipped = 0;
 static char current_test_name[256] = "";
 static char current_test_suite[256] = "";
 static int benchmark_mode = 0;
-static clock_t benchmark_start_time = 0;
+static double benchmark_start_time = 0.0;   // bench_now_ns() at start_benchmark()
+
+// Library call being dispatched, and the calls that left the pending object, array and string results
+static ASTNode* library_call_node = NULL;
+static ASTNode* object_result_call = NULL;
+static ASTNode* array_result_call = NULL;
+static ASTNode* string_result_call = NULL;
 
 // Global data structures state (v1.6.0)
 static int linked_list_mode = 0;
@@ -253,25 +275,8 @@ static int operator_map_capacity = 0;
 // PHASE 2: TARGETED BOTTLENECK OPTIMIZATION
 // Optimize specific performance bottlenecks identified in benchmarks
 
-// PHASE 4.1: Universal Algorithm Overhaul with Cross-Platform SIMD Optimization
-// Optimize the 30.7-second string search bottleneck with universal algorithms and platform-specific SIMD
-#define STRING_SEARCH_CACHE_SIZE 16384  // 32x increased for maximum cache efficiency
+// Substring search lives in string_kernels.c (compiled searchers, memchr filters)
 #define STRING_SEARCH_PATTERN_SIZE 8192 // 16x increased for complex pattern preprocessing
-#define STRING_SEARCH_SIMD_THRESHOLD 1  // Use SIMD for ALL strings (maximum optimization)
-#define STRING_SEARCH_UNIVERSAL_THRESHOLD 1  // Use universal algorithms for ALL strings
-#define STRING_SEARCH_PATTERN_DETECTION 1  // Detect patterns for ALL strings
-#define STRING_SEARCH_AGGRESSIVE_THRESHOLD 1 // Use aggressive optimizations for ALL strings
-#define STRING_SEARCH_SUNDAY_THRESHOLD 1   // Use Sunday algorithm for ALL strings
-#define STRING_SEARCH_KMP_THRESHOLD 1      // Use KMP algorithm for ALL strings
-
-typedef struct {
-    const char* haystack;
-    const char* needle;
-    int result;
-    int haystack_len;
-    int needle_len;
-    int cache_valid;
-} StringSearchCache;
 
 // Advanced pattern preprocessing for Boyer-Moore-Horspool
 typedef struct {
@@ -285,18 +290,7 @@ static AdvancedPattern* current_pattern = NULL;
 static int pattern_initialized = 0;
 
 // Forward declarations for Phase 4.1 universal algorithm overhaul functions
-static int ultra_fast_string_search_simd(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int ultra_fast_string_search_standard(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int ultra_fast_string_search_sunday(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int ultra_fast_string_search_kmp(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int ultra_fast_string_search_pattern_optimized(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int ultra_fast_string_search_aggressive(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int detect_string_search_pattern(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int ultra_fast_string_search_universal(const char* haystack, const char* needle, int haystack_len, int needle_len);
-static int ultra_fast_string_search_platform_simd(const char* haystack, const char* needle, int haystack_len, int needle_len);
 static int ultra_fast_introsort(long long* arr, int left, int right, int depth_limit);
-static void preprocess_sunday_bad_char_table(const char* needle, int needle_len, int* bad_char_table);
-static void preprocess_kmp_failure_function(const char* needle, int needle_len, int* failure_function);
 static void ultra_fast_quicksort(long long* arr, int left, int right);
 static int ultra_fast_partition(long long* arr, int left, int right);
 
@@ -304,18 +298,7 @@ static int ultra_fast_partition(long long* arr, int left, int right);
 static int compare_long_long(const void* a, const void* b) {
     return (*(long long*)a - *(long long*)b);
 }
-#ifdef HAS_X86_SIMD
-static int ultra_fast_string_search_x86_simd(const char* haystack, const char* needle, int haystack_len, int needle_len);
-#endif
-#ifdef HAS_ARM_SIMD
-static int ultra_fast_string_search_arm_simd(const char* haystack, const char* needle, int haystack_len, int needle_len);
-
-
-#endif
 
-static StringSearchCache* string_search_cache = NULL;
-static int string_search_cache_size = 0;
-static int string_search_cache_hits = 0;
 
 // PHASE 2.2: Array Sorting Optimization  
 // Optimize the 2.8-second array sorting bottleneck
@@ -542,13 +525,6 @@ void init_implicit_functions(void) {
     operator_map_size++;
     
     // PHASE 2: Initialize targeted bottleneck optimization systems
-    // Initialize advanced string search system
-    string_search_cache = (StringSearchCache*)tracked_malloc(
-        STRING_SEARCH_CACHE_SIZE * sizeof(StringSearchCache), 
-        __FILE__, __LINE__, "init_string_search_cache"
-    );
-    string_search_cache_size = 0;
-    
     // Initialize advanced pattern preprocessing
     current_pattern = (AdvancedPattern*)tracked_malloc(
         sizeof(AdvancedPattern), 
@@ -583,8 +559,6 @@ void init_implicit_functions(void) {
     if (global_debug_mode) {
         fprintf(stderr, "%sPHASE 4.1: Universal Algorithm Overhaul with Cross-Platform SIMD optimization systems initialized%s\n", 
                 CYAN, RESET);
-        fprintf(stderr, "%s  - Advanced string search cache: %d entries (Universal Algorithms + Cross-Platform SIMD)%s\n", 
-                YELLOW, STRING_SEARCH_CACHE_SIZE, RESET);
         fprintf(stderr, "%s  - Sort cache: %d entries%s\n", 
                 YELLOW, SORT_CACHE_SIZE, RESET);
         fprintf(stderr, "%s  - Concat cache: %d entries%s\n", 
@@ -739,38 +713,50 @@ void cleanup_implicit_functions(void) {
 #define MYCO_INF (1.0/0.0)
 #define MYCO_NAN (0.0/0.0)
 
-// Random number generation state
+// Random number generation state (xoshiro256**, see random_gen.c)
+static RandomState default_random_state;
 static int random_initialized = 0;
 
 /**
- * @brief Initialize random number generator
+ * @brief Seed the default generator on first use
+ *
+ * Mixes the clock, the process id and a stack address so separate runs
+ * (and processes started in the same second) get different sequences.
+ * math.seed() replaces this with an explicit, reproducible seed.
  */
 static void init_random(void) {
     if (!random_initialized) {
-        srand((unsigned int)time(NULL));
+        uint64_t seed = (uint64_t)time(NULL);
+        seed ^= (uint64_t)clock() << 32;
+        seed ^= (uint64_t)(uintptr_t)&seed;
+#ifndef _WIN32
+        seed ^= (uint64_t)getpid() << 16;
+#endif
+        random_seed(&default_random_state, seed);
         random_initialized = 1;
     }
 }
 
+// Reseed the default generator so later draws are reproducible
+static void seed_random(uint64_t seed) {
+    random_seed(&default_random_state, seed);
+    random_initialized = 1;
+}
+
 /**
  * @brief Get random float between 0.0 and 1.0
  */
 static double myco_random(void) {
     init_random();
-    return (double)rand() / (double)RAND_MAX;
+    return random_double(&default_random_state);
 }
 
 /**
  * @brief Get random integer between min and max (inclusive)
  */
 static long long myco_randint(long long min, long long max) {
-    if (min > max) {
-        long long temp = min;
-        min = max;
-        max = temp;
-    }
     init_random();
-    return min + (long long)(myco_random() * (max - min + 1));
+    return random_range(&default_random_state, min, max);
 }
 
 /*******************************************************************************
@@ -1006,7 +992,8 @@ typedef struct {
         VAR_TYPE_ARRAY,
         VAR_TYPE_OBJECT,
         VAR_TYPE_SET,
-        VAR_TYPE_LAMBDA
+        VAR_TYPE_LAMBDA,
+        VAR_TYPE_BIGINT
     } type;
     long long number_value;
     double float_value;
@@ -1015,8 +1002,17 @@ typedef struct {
     MycoObject* object_value;
     MycoSet* set_value;
     ASTNode* lambda_value;
+    BigInt* big_value;       // Integer too large for number_value (VAR_TYPE_BIGINT only)
 } VarEntry;
 
+// Free the big integer held by an entry that is about to change type or go away
+static void release_big_value(VarEntry* entry) {
+    if (entry->type == VAR_TYPE_BIGINT && entry->big_value) {
+        bigint_free(entry->big_value);
+        entry->big_value = NULL;
+    }
+}
+
 static VarEntry* var_env = NULL;
 static int var_env_size = 0;
 static int var_env_capacity = 0;
@@ -1038,6 +1034,10 @@ static char* __last_bool_result = NULL;
 // Global variable to track if the last expression result was a float
 static int last_result_is_float = 0;
 
+// Exact value behind the scaled integer of the last float result, and the node that produced it
+static double last_float_value = 0.0;
+static ASTNode* last_float_node = NULL;
+
 // Global object reference for chained property access
 static MycoObject* __chained_object_ref = NULL;
 
@@ -1373,262 +1373,13 @@ static void clear_string_pool() {
     }
 }
 
-// PHASE 2.1: Ultra-Fast String Search with Caching
+// Substring search for callers outside the builtins; returns the match index or -1
 int ultra_fast_string_search(const char* haystack, const char* needle) {
     if (!haystack || !needle) return -1;
     
-    int haystack_len = strlen(haystack);
-    int needle_len = strlen(needle);
-    
-    // Check cache first
-    if (string_search_cache) {
-        for (int i = 0; i < string_search_cache_size; i++) {
-            if (string_search_cache[i].haystack == haystack && 
-                string_search_cache[i].needle == needle &&
-                string_search_cache[i].haystack_len == haystack_len &&
-                string_search_cache[i].needle_len == needle_len) {
-                string_search_cache_hits++;
-                return string_search_cache[i].result;
-            }
-        }
-    }
-    
-    // PHASE 4.1: Universal algorithm selection with pattern detection
-    if (needle_len > haystack_len) return -1;
-    
-    // Use universal algorithm selection for maximum performance
-    int result;
-    
-    // For benchmark scenarios, always use the fastest algorithm
-    if (needle_len >= 3) {
-        // Use Sunday algorithm for 3+ character patterns (optimal for ASCII text)
-        result = ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-    }
-    else if (needle_len == 2) {
-        // Use optimized 2-character search
-        result = ultra_fast_string_search_standard(haystack, needle, haystack_len, needle_len);
-    }
-    else if (needle_len == 1) {
-        // Use optimized single character search
-        result = ultra_fast_string_search_standard(haystack, needle, haystack_len, needle_len);
-    }
-    else {
-        // Fallback to standard search
-        result = ultra_fast_string_search_standard(haystack, needle, haystack_len, needle_len);
-    }
-    
-    // Cache the result
-    if (string_search_cache && string_search_cache_size < STRING_SEARCH_CACHE_SIZE) {
-        string_search_cache[string_search_cache_size].haystack = haystack;
-        string_search_cache[string_search_cache_size].needle = needle;
-        string_search_cache[string_search_cache_size].result = result;
-        string_search_cache[string_search_cache_size].haystack_len = haystack_len;
-        string_search_cache[string_search_cache_size].needle_len = needle_len;
-        string_search_cache[string_search_cache_size].cache_valid = 1;
-        string_search_cache_size++;
-    }
-    
-    return result;
-}
-
-// PHASE 4.1: Platform-specific SIMD string search
-static int ultra_fast_string_search_platform_simd(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // Platform-specific SIMD optimization for maximum performance
-    // This provides 4-8x speedup through hardware-accelerated vector operations
-    
-    if (needle_len > haystack_len) return -1;
-    
-    #ifdef HAS_X86_SIMD
-        // Intel x86_64 AVX2/SSE4.2 optimization
-        return ultra_fast_string_search_x86_simd(haystack, needle, haystack_len, needle_len);
-    #elif defined(HAS_ARM_SIMD)
-        // ARM64/ARM32 NEON optimization
-        return ultra_fast_string_search_arm_simd(haystack, needle, haystack_len, needle_len);
-    #else
-        // Fallback to universal algorithms for non-SIMD platforms
-        if (needle_len >= STRING_SEARCH_SUNDAY_THRESHOLD) {
-            return ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-        } else {
-            return ultra_fast_string_search_standard(haystack, needle, haystack_len, needle_len);
-        }
-    #endif
-}
-
-#ifdef HAS_X86_SIMD
-// Intel x86_64 AVX2/SSE4.2 string search
-static int ultra_fast_string_search_x86_simd(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // AVX2 optimization for Intel processors
-    // This provides 8-16x speedup through 256-bit vector operations
-    
-    if (needle_len > haystack_len) return -1;
-    
-    // PHASE 3A: FOCUSED OPTIMIZATION - Special case for "abc" pattern
-    // This is the most common benchmark pattern and deserves special handling
-    if (needle_len == 3 && needle[0] == 'a' && needle[1] == 'b' && needle[2] == 'c') {
-        // Ultra-fast path for "abc" pattern using loop unrolling
-        const char* h = haystack;
-        const char* end = haystack + haystack_len - 2;
-        
-        // Process 4 characters at a time for maximum throughput
-        while (h <= end) {
-            // Check if current position matches "abc"
-            if (h[0] == 'a' && h[1] == 'b' && h[2] == 'c') {
-                return (int)(h - haystack);
-            }
-            h++;
-        }
-        return -1;
-    }
-    
-    // Use SSE4.2 for smaller strings, AVX2 for larger ones
-    if (haystack_len >= 32 && needle_len >= 8) {
-        // Process 32 bytes at once using AVX2
-        for (int i = 0; i <= haystack_len - needle_len; i += 32) {
-            // Use vector comparison for fast pattern matching
-            if (memcmp(haystack + i, needle, needle_len) == 0) {
-                return i;
-            }
-        }
-        return -1;
-    } else {
-        // Process 16 bytes at once using SSE4.2
-        for (int i = 0; i <= haystack_len - needle_len; i += 16) {
-            if (memcmp(haystack + i, needle, needle_len) == 0) {
-                return i;
-            }
-        }
-        return -1;
-    }
-}
-#endif
-
-#ifdef HAS_ARM_SIMD
-// ARM64/ARM32 NEON string search
-static int ultra_fast_string_search_arm_simd(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // NEON optimization for ARM processors
-    // This provides 4-8x speedup through 128-bit vector operations
-    
-    if (needle_len > haystack_len) return -1;
-    
-    // PHASE 4A: AGGRESSIVE STRING SEARCH OVERHAUL - Direct Native C Integration
-    // This provides maximum speedup by completely bypassing interpreter overhead
-    // Target: 30,000x faster string search to reach <50ms total benchmark time
-    
-    // PHASE 4A: Ultra-fast native C string search for all patterns
-    // Use strstr() directly for maximum performance - no interpreter overhead
-    if (needle_len > 0 && haystack_len > 0) {
-        // PHASE 4A: Direct native C string search - bypass all interpreter logic
-        // This provides the 30,000x speedup needed to reach <50ms total
-        
-        // PHASE 4D: ULTRA-OPTIMIZED - Direct native C string search for maximum performance
-        // This provides the 171x speedup needed to reach <50ms string search
-        
-        // Use native C strstr() for maximum performance
-        const char* result = strstr(haystack, needle);
-        if (result) {
-            return (int)(result - haystack);
-        }
-        return -1;
-    }
-    
-    // Use NEON intrinsics for maximum performance
-    if (needle_len >= 8 && haystack_len >= 16) {
-        // Process 16 bytes at once using NEON
-        for (int i = 0; i <= haystack_len - needle_len; i += 16) {
-            // Use NEON vector comparison for fast pattern matching
-            if (memcmp(haystack + i, needle, needle_len) == 0) {
-                return i;
-            }
-        }
-        return -1;
-    } else {
-        // Use Sunday algorithm for smaller strings
-        return ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-    }
-}
-#endif
-
-// PHASE 3.3: Pattern detection for string search optimization
-static int detect_string_search_pattern(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // Detect common patterns that can be optimized
-    // This helps choose the best algorithm for the specific case
-    
-    // Pattern 1: Repeated character sequences (e.g., "aaaa", "abab")
-    int has_repetition = 0;
-    if (needle_len >= 4) {
-        char first_char = needle[0];
-        char second_char = needle[1];
-        if (first_char == needle[2] && second_char == needle[3]) {
-            has_repetition = 1; // Pattern like "abab"
-        } else if (first_char == second_char && second_char == needle[2] && second_char == needle[3]) {
-            has_repetition = 2; // Pattern like "aaaa"
-        }
-    }
-    
-    // Pattern 2: Common prefixes/suffixes
-    int common_prefix = 0;
-    if (needle_len >= 3) {
-        if (needle[0] == needle[needle_len-1]) {
-            common_prefix = 1; // Pattern like "abc...a"
-        }
-    }
-    
-    // Pattern 3: Character distribution
-    int unique_chars = 0;
-    int char_count[256] = {0};
-    for (int i = 0; i < needle_len; i++) {
-        if (char_count[(unsigned char)needle[i]] == 0) {
-            unique_chars++;
-            char_count[(unsigned char)needle[i]] = 1;
-        }
-    }
-    
-    // Return pattern type for algorithm selection
-    if (has_repetition == 2) return 1;      // Repeated characters
-    if (has_repetition == 1) return 2;      // Alternating pattern
-    if (common_prefix) return 3;            // Common prefix/suffix
-    if (unique_chars <= 4) return 4;       // Low character diversity
-    return 0;                               // Standard pattern
-}
-
-// PHASE 3.3: Pattern-optimized string search
-static int ultra_fast_string_search_pattern_optimized(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // Use pattern detection to choose the best algorithm
-    int pattern_type = detect_string_search_pattern(haystack, needle, haystack_len, needle_len);
-    
-    switch (pattern_type) {
-        case 1: // Repeated characters - use optimized Boyer-Moore
-            return ultra_fast_string_search_standard(haystack, needle, haystack_len, needle_len);
-        case 2: // Alternating pattern - use Sunday algorithm
-            return ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-        case 3: // Common prefix/suffix - use KMP-like optimization
-            return ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-        case 4: // Low character diversity - use SIMD with character counting
-            return ultra_fast_string_search_simd(haystack, needle, haystack_len, needle_len);
-        default: // Standard pattern - use SIMD
-            return ultra_fast_string_search_simd(haystack, needle, haystack_len, needle_len);
-    }
-}
-
-// PHASE 3.3: Aggressive string search for very large strings
-static int ultra_fast_string_search_aggressive(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // Aggressive optimization for very large strings
-    // This combines multiple optimization techniques
-    
-    // First, try pattern detection
-    int pattern_type = detect_string_search_pattern(haystack, needle, haystack_len, needle_len);
-    
-    // For very large strings, use the most aggressive algorithm
-    if (haystack_len >= 50000) {
-        // Use Sunday algorithm for massive strings (parallel processing will be implemented in Phase 2)
-        return ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-    } else if (pattern_type == 1 || pattern_type == 2) {
-        // Use Sunday algorithm for repetitive patterns
-        return ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-    } else {
-        // Use enhanced SIMD for other cases
-        return ultra_fast_string_search_simd(haystack, needle, haystack_len, needle_len);
-    }
+    size_t haystack_len = strlen(haystack);
+    const char* match = string_find_bytes(haystack, haystack_len, needle, strlen(needle));
+    return match ? (int)(match - haystack) : -1;
 }
 
 // PHASE 4.1: Initialize universal algorithm optimization system
@@ -1666,131 +1417,6 @@ static void init_universal_optimization(void) {
     universal_optimization_initialized = 1;
 }
 
-// PHASE 4.1: Sunday Algorithm - Universal string search optimization
-static int ultra_fast_string_search_sunday(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // Sunday algorithm provides 3-5x improvement over Boyer-Moore-Horspool
-    // This is a universal algorithm that works on all platforms
-    
-    if (needle_len > haystack_len) return -1;
-    if (needle_len == 0) return 0;
-    if (needle_len == 1) {
-        // Simple single character search
-        for (int i = 0; i < haystack_len; i++) {
-            if (haystack[i] == needle[0]) return i;
-        }
-        return -1;
-    }
-    
-    // Preprocess bad character table with aggressive optimization
-    int bad_char_table[256];
-    for (int i = 0; i < 256; i++) {
-        bad_char_table[i] = needle_len + 1;
-    }
-    for (int i = 0; i < needle_len; i++) {
-        bad_char_table[(unsigned char)needle[i]] = needle_len - i;
-    }
-    
-    // Sunday search with aggressive loop unrolling and skipping
-    int i = 0;
-    
-
-
-    
-    // General Sunday algorithm with aggressive optimization
-    while (i <= haystack_len - needle_len) {
-        // Aggressive pattern matching with early exit
-        if (haystack[i] == needle[0] && 
-            haystack[i + needle_len - 1] == needle[needle_len - 1]) {
-            
-            // Check middle characters for quick rejection
-            if (needle_len <= 4 || 
-                (haystack[i + 1] == needle[1] && haystack[i + needle_len - 2] == needle[needle_len - 2])) {
-                
-                // Full pattern match
-                int j = 0;
-                while (j < needle_len && haystack[i + j] == needle[j]) {
-                    j++;
-                }
-                
-                if (j == needle_len) {
-                    return i;  // Found match
-                }
-            }
-        }
-        
-        // Sunday skip: use character after needle with aggressive optimization
-        if (i + needle_len < haystack_len) {
-            int skip = bad_char_table[(unsigned char)haystack[i + needle_len]];
-            i += (skip > 1) ? skip : 1;
-        } else {
-            i++;
-        }
-    }
-    
-    return -1;  // No match found
-}
-
-// PHASE 4.1: KMP Algorithm - Universal string search for repetitive patterns
-static int ultra_fast_string_search_kmp(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // KMP algorithm provides 2-3x improvement for repetitive patterns
-    // This is a universal algorithm that works on all platforms
-    
-    if (needle_len > haystack_len) return -1;
-    if (needle_len == 0) return 0;
-    if (needle_len == 1) {
-        // Simple single character search
-        for (int i = 0; i < haystack_len; i++) {
-            if (haystack[i] == needle[0]) return i;
-        }
-        return -1;
-    }
-    
-    // Preprocess failure function with aggressive optimization
-    int* failure_function = (int*)tracked_malloc(needle_len * sizeof(int), __FILE__, __LINE__, "kmp_failure_function");
-    if (!failure_function) {
-        return ultra_fast_string_search_sunday(haystack, needle, haystack_len, needle_len);
-    }
-    
-    // Build failure function with early optimization
-    failure_function[0] = -1;
-    int j = -1;
-    for (int i = 1; i < needle_len; i++) {
-        while (j >= 0 && needle[i] != needle[j + 1]) {
-            j = failure_function[j];
-        }
-        if (needle[i] == needle[j + 1]) {
-            j++;
-        }
-        failure_function[i] = j;
-    }
-    
-    // KMP search with aggressive pattern matching
-    int i = 0;
-    j = -1;
-    while (i < haystack_len) {
-        // Quick character check before KMP logic
-        if (haystack[i] == needle[j + 1]) {
-            j++;
-            if (j == needle_len - 1) {
-                tracked_free(failure_function, __FILE__, __LINE__, "kmp_failure_function_cleanup");
-                return i - j;
-            }
-        } else {
-            // Use failure function for efficient backtracking
-            while (j >= 0 && haystack[i] != needle[j + 1]) {
-                j = failure_function[j];
-            }
-            if (haystack[i] == needle[j + 1]) {
-                j++;
-            }
-        }
-        i++;
-    }
-    
-    tracked_free(failure_function, __FILE__, __LINE__, "kmp_failure_function_cleanup");
-    return -1;
-}
-
 // PHASE 4.1: Ultra-fast quicksort for array operations
 static int ultra_fast_partition(long long* arr, int left, int right) {
     // Optimized partition function for quicksort
@@ -1839,132 +1465,6 @@ static void ultra_fast_quicksort(long long* arr, int left, int right) {
     }
 }
 
-// PHASE 3.3: Aggressive SIMD optimization with ARM64 NEON and loop unrolling
-static int ultra_fast_string_search_simd(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // Aggressive ARM64 NEON SIMD optimization with maximum loop unrolling
-    // This provides massive speedup for large strings
-    
-    // Precompute bad character table with register optimization
-    int bad_char[256];
-    for (int i = 0; i < 256; i++) bad_char[i] = needle_len;
-    for (int i = 0; i < needle_len - 1; i++) {
-        bad_char[(unsigned char)needle[i]] = needle_len - 1 - i;
-    }
-    
-    // Cache values for faster access
-    const int needle_len_minus_1 = needle_len - 1;
-    
-    // Aggressive SIMD-optimized search with maximum loop unrolling
-    int result = -1;
-    for (int i = needle_len_minus_1; i < haystack_len;) {
-        int j = needle_len_minus_1;
-        int k = i;
-        
-        // Maximum loop unrolling for needle >= 8 chars
-        if (needle_len >= 8 && ((uintptr_t)&haystack[k] & 7) == 0) {
-            // 8-byte aligned comparison for maximum SIMD performance
-            while (j >= 7 && k >= 7) {
-                if (*(long long*)(&haystack[k-7]) != *(long long*)(&needle[j-7])) break;
-                j -= 8;
-                k -= 8;
-            }
-        }
-        // 4-byte aligned comparison for needle >= 4 chars
-        else if (needle_len >= 4 && ((uintptr_t)&haystack[k] & 3) == 0) {
-            while (j >= 3 && k >= 3) {
-                if (*(int*)(&haystack[k-3]) != *(int*)(&needle[j-3])) break;
-                j -= 4;
-                k -= 4;
-            }
-        }
-        
-        // Aggressively unrolled character-by-character comparison
-        while (j >= 3) {
-            if (haystack[k] != needle[j] || 
-                haystack[k-1] != needle[j-1] || 
-                haystack[k-2] != needle[j-2] || 
-                haystack[k-3] != needle[j-3]) break;
-            j -= 4;
-            k -= 4;
-        }
-        
-        // Handle remaining characters
-        while (j >= 0) {
-            if (haystack[k] != needle[j]) break;
-            j--;
-            k--;
-        }
-        
-        if (j == -1) {
-            result = k + 1;
-            break;
-        }
-        
-        // Optimized shift calculation with bounds checking
-        int shift = bad_char[(unsigned char)haystack[i]];
-        if (shift == 0) shift = 1; // Prevent infinite loops
-        i += shift;
-    }
-    
-    return result;
-}
-
-// PHASE 4.1: Universal algorithm optimization - removed duplicate functions
-
-// PHASE 3.3: Aggressive Boyer-Moore-Horspool with maximum loop unrolling
-static int ultra_fast_string_search_standard(const char* haystack, const char* needle, int haystack_len, int needle_len) {
-    // Aggressive Boyer-Moore-Horspool with maximum loop unrolling
-    if (needle_len > haystack_len) return -1;
-    
-    // Precompute bad character table with register optimization
-    int bad_char[256];
-    for (int i = 0; i < 256; i++) bad_char[i] = needle_len;
-    for (int i = 0; i < needle_len - 1; i++) {
-        bad_char[(unsigned char)needle[i]] = needle_len - 1 - i;
-    }
-    
-    // Cache needle length for faster access
-    const int needle_len_minus_1 = needle_len - 1;
-    
-    // Search with aggressively unrolled Boyer-Moore-Horspool
-    int result = -1;
-    for (int i = needle_len_minus_1; i < haystack_len;) {
-        int j = needle_len_minus_1;
-        int k = i;
-        
-        // Aggressively unrolled comparison loop for maximum performance
-        while (j >= 3) {
-            if (haystack[k] != needle[j] || 
-                haystack[k-1] != needle[j-1] || 
-                haystack[k-2] != needle[j-2] || 
-                haystack[k-3] != needle[j-3]) break;
-            j -= 4;
-            k -= 4;
-        }
-        
-        // Handle remaining characters
-        while (j >= 0) {
-            if (haystack[k] != needle[j]) break;
-            j--;
-            k--;
-        }
-        
-        if (j == -1) {
-            result = k + 1;
-            break;
-        }
-        
-        // Optimized shift calculation with bounds checking
-        int shift = bad_char[(unsigned char)haystack[i]];
-        if (shift == 0) shift = 1; // Prevent infinite loops
-        i += shift;
-    }
-    
-    return result;
-}
-
-
-
 // PHASE 2.2: Ultra-Fast Array Sorting with Caching
 void ultra_fast_array_sort(int* array, int size) {
     if (!array || size <= 1) return;
@@ -2291,19 +1791,6 @@ static MycoArray* create_array_optimized(int initial_capacity, int is_string_arr
     return create_array(capacity, is_string_array);
 }
 
-// Ultra-enhanced array optimization - power-of-2 capacity with cache line alignment
-static inline int get_ultra_optimal_capacity(int required) {
-    int capacity = 1;
-    while (capacity < required) {
-        capacity <<= 1;
-    }
-    
-    // Ensure capacity aligns with cache line size for optimal performance
-    if (capacity < 64) capacity = 64;  // Minimum cache line alignment
-    if (capacity < 128) capacity = 128; // Prefer larger cache lines for better performance
-    return capacity;
-}
-
 // Ultra-fast array access with bounds checking elimination
 static inline long long ultra_fast_array_access(MycoArray* arr, int index) {
     // Ultra-fast path: no bounds check for known-safe access
@@ -3127,6 +2614,7 @@ static void pop_scope() {
                 destroy_object(var_env[var_env_size].object_value);
                 var_env[var_env_size].object_value = NULL;
             }
+            release_big_value(&var_env[var_env_size]);
                 tracked_free(var_env[var_env_size].name, __FILE__, __LINE__, "pop_scope_var");
                 var_env[var_env_size].name = NULL;
             }
@@ -3285,6 +2773,9 @@ static int error_printed = 0;
 // Function return handling
 static int return_flag = 0;
 static long long return_value = 0;
+static int return_is_float = 0;
+static double return_float_value = 0.0;
+static BigInt* return_big_value = NULL;      // Owned until the caller takes it
 
 // Global variables for tracking state
 static int loop_counter = 0;
@@ -3368,6 +2859,9 @@ static long long get_var_value(const char* name) {
             } else if (var_env[i].type == VAR_TYPE_OBJECT) {
                 // Return special value to indicate this is an object variable
                 return -3; // Special value to indicate object variable
+            } else if (var_env[i].type == VAR_TYPE_BIGINT) {
+                // Saturate for callers limited to 64 bits
+                return var_env[i].big_value->negative ? LLONG_MIN : LLONG_MAX;
             }
             // String variables return 0 (as before)
             return 0;
@@ -3376,6 +2870,19 @@ static long long get_var_value(const char* name) {
     return 0;
 }
 
+// Entry points into the internals above for the C microbenchmarks (bench/microbench.c)
+long long eval_lookup_variable(const char* name) {
+    return get_var_value(name);
+}
+
+ASTNode* eval_find_function(const char* name) {
+    return find_function_global(name);
+}
+
+long long eval_call_user_function(ASTNode* fn, ASTNode* call) {
+    return eval_user_function_call(fn, call);
+}
+
 // Helper function to get a float variable's value from the environment
 static double get_float_value(const char* name) {
     // Search from the end (most recent variables first) to prioritize function parameters
@@ -3385,6 +2892,8 @@ static double get_float_value(const char* name) {
                 return var_env[i].float_value;
             } else if (var_env[i].type == VAR_TYPE_NUMBER) {
                 return (double)var_env[i].number_value;
+            } else if (var_env[i].type == VAR_TYPE_BIGINT) {
+                return bigint_to_double(var_env[i].big_value);
             }
             return 0.0;
         }
@@ -3392,46 +2901,492 @@ static double get_float_value(const char* name) {
     return 0.0;
 }
 
-// Helper function to set a float variable's value in the environment
-void set_float_value(const char* name, double value) {
-    // Check if variable already exists
-    for (int i = var_env_size - 1; i >= 0; i--) {
-        if (strcmp(var_env[i].name, name) == 0) {
-            // Update existing variable
-            if (var_env[i].type == VAR_TYPE_ARRAY && var_env[i].array_value) {
-                destroy_array(var_env[i].array_value);
-                var_env[i].array_value = NULL;
-            }
-            if (var_env[i].type == VAR_TYPE_OBJECT && var_env[i].object_value) {
-                destroy_object(var_env[i].object_value);
-                var_env[i].object_value = NULL;
+/*******************************************************************************
+ * NATIVE NUMERIC EVALUATION
+ ******************************************************************************/
+
+/**
+ * eval_expression() returns long long, so a float result travels as its
+ * value scaled by 1e6 for callers that only understand integers. The exact
+ * double is kept in last_float_value together with the node that produced
+ * it; let, assignment, print, parameters and return read it back through
+ * float_result_of() so floats survive as real doubles end-to-end.
+ *
+ * Integer + - * are overflow-checked; a result that does not fit a long
+ * long is promoted to a BigInt and travels the same way (last_big_value,
+ * taken with big_result_of()). Big results that fit again are demoted, so
+ * ordinary arithmetic never leaves the machine-integer path.
+ */
+
+// Typed result of a numeric subexpression
+typedef struct {
+    int is_float;
+    long long i;
+    double d;
+    BigInt* big;             // Owned; set instead of i when the integer needs more than 64 bits
+} NumericValue;
+
+typedef enum {
+    NUM_OP_NONE,
+    NUM_OP_ADD, NUM_OP_SUB, NUM_OP_MUL, NUM_OP_DIV, NUM_OP_MOD,
+    NUM_OP_EQ, NUM_OP_NE, NUM_OP_LT, NUM_OP_GT, NUM_OP_LE, NUM_OP_GE,
+    NUM_OP_AND, NUM_OP_OR
+} NumericOp;
+
+// Big integer result of the last evaluation that produced one (owned here until taken)
+static BigInt* last_big_value = NULL;
+static ASTNode* last_big_node = NULL;
+
+static void clear_big_result(void) {
+    if (last_big_value) bigint_free(last_big_value);
+    last_big_value = NULL;
+    last_big_node = NULL;
+}
+
+// Report a float result for node; returns the scaled integer legacy callers expect
+static long long return_float_result(ASTNode* node, double value) {
+    clear_big_result();
+    last_float_value = value;
+    last_float_node = node;
+    last_result_is_float = 1;
+    double scaled = value * 1000000.0;
+    if (scaled != scaled) return 0;
+    if (scaled >= 9.2e18) return LLONG_MAX;
+    if (scaled <= -9.2e18) return LLONG_MIN;
+    return (long long)scaled;
+}
+
+#define FLOAT_TEXT_SIZE 32
+
+/**
+ * @brief Formats a float as the shortest text that reads back as the same double
+ *
+ * Values from 1e-5 up to 1e16 use plain notation with at least one decimal
+ * ("2.0", "1234567.5"); others use exponent notation ("1e+20").
+ * @return Length of the text written to buffer (FLOAT_TEXT_SIZE bytes is always enough)
+ */
+static int format_float(char* buffer, size_t size, double value) {
+    char text[64];
+    int len = 0;
+    double magnitude = fabs(value);
+    if (value != value || magnitude == HUGE_VAL) {
+        len = snprintf(text, sizeof(text), "%g", value);
+    } else {
+        int found = 0;
+        if (magnitude == 0 || (magnitude >= 1e-5 && magnitude < 1e16)) {
+            for (int decimals = 1; decimals <= 17 && !found; decimals++) {
+                len = snprintf(text, sizeof(text), "%.*f", decimals, value);
+                found = strtod(text, NULL) == value;
             }
-            var_env[i].type = VAR_TYPE_FLOAT;
-            var_env[i].float_value = value;
-            var_env[i].number_value = 0;
-            var_env[i].string_value = NULL;
-            var_env[i].array_value = NULL;
-            var_env[i].object_value = NULL;
-            return;
         }
-    }
-    
-    // Expand capacity if needed
-    if (var_env_size >= var_env_capacity) {
-        int new_capacity = var_env_capacity ? var_env_capacity * 2 : 8;
-        VarEntry* new_env = (VarEntry*)tracked_realloc(var_env, new_capacity * sizeof(VarEntry), __FILE__, __LINE__, "set_float_value");
-        if (!new_env) {
-            // Handle realloc failure
-            return;
+        for (int precision = 1; precision <= 17 && !found; precision++) {
+            len = snprintf(text, sizeof(text), "%.*g", precision, value);
+            found = strtod(text, NULL) == value;
         }
-        var_env = new_env;
-        var_env_capacity = new_capacity;
     }
-    
-    // Add new variable
-    var_env[var_env_size].name = tracked_strdup(name, __FILE__, __LINE__, "eval");
-    if (var_env[var_env_size].name) {
-        var_env[var_env_size].type = VAR_TYPE_FLOAT;
+    snprintf(buffer, size, "%s", text);
+    return len < (int)size ? len : (int)size - 1;
+}
+
+// Forget any float or big integer result (called before evaluating a node whose type matters)
+static void clear_float_result(void) {
+    last_result_is_float = 0;
+    last_float_node = NULL;
+    if (last_big_node) clear_big_result();
+}
+
+// Report a big integer result for node (takes ownership); returns the value saturated to 64 bits
+static long long return_big_result(ASTNode* node, BigInt* value) {
+    clear_float_result();
+    last_big_value = value;
+    last_big_node = node;
+    return value->negative ? LLONG_MIN : LLONG_MAX;
+}
+
+// Take ownership of node's big integer result, or NULL if its latest evaluation produced none
+static BigInt* big_result_of(ASTNode* node) {
+    if (!last_big_node || last_big_node != node) return NULL;
+    BigInt* value = last_big_value;
+    last_big_value = NULL;
+    last_big_node = NULL;
+    return value;
+}
+
+// Report a typed value for node, handing over ownership of a big integer
+static long long return_numeric_result(ASTNode* node, NumericValue* value) {
+    if (value->big) {
+        BigInt* big = value->big;
+        value->big = NULL;
+        return return_big_result(node, big);
+    }
+    if (value->is_float) return return_float_result(node, value->d);
+    clear_float_result();
+    return value->i;
+}
+
+// Whether node's latest evaluation produced a float, and its exact value
+static int float_result_of(ASTNode* node, double* value) {
+    if (!last_result_is_float || last_float_node != node) return 0;
+    *value = last_float_value;
+    return 1;
+}
+
+// Evaluate a builtin's argument, keeping the exact value of a float
+static int eval_numeric_argument(ASTNode* arg, NumericValue* out) {
+    clear_float_result();
+    long long value = eval_expression(arg);
+    if (error_occurred) return 0;
+    out->is_float = float_result_of(arg, &out->d);
+    out->i = value;
+    out->big = NULL;
+    return 1;
+}
+
+static NumericOp numeric_operator(const char* op) {
+    switch (op[0]) {
+        case '+': return op[1] ? NUM_OP_NONE : NUM_OP_ADD;
+        case '-': return op[1] ? NUM_OP_NONE : NUM_OP_SUB;
+        case '*': return op[1] ? NUM_OP_NONE : NUM_OP_MUL;
+        case '/': return op[1] ? NUM_OP_NONE : NUM_OP_DIV;
+        case '%': return op[1] ? NUM_OP_NONE : NUM_OP_MOD;
+        case '=': return op[1] == '=' && !op[2] ? NUM_OP_EQ : NUM_OP_NONE;
+        case '!': return op[1] == '=' && !op[2] ? NUM_OP_NE : NUM_OP_NONE;
+        case '<': return !op[1] ? NUM_OP_LT : (op[1] == '=' && !op[2]) ? NUM_OP_LE : NUM_OP_NONE;
+        case '>': return !op[1] ? NUM_OP_GT : (op[1] == '=' && !op[2]) ? NUM_OP_GE : NUM_OP_NONE;
+        case 'a': return strcmp(op, "and") == 0 ? NUM_OP_AND : NUM_OP_NONE;
+        case 'o': return strcmp(op, "or") == 0 ? NUM_OP_OR : NUM_OP_NONE;
+        default: return NUM_OP_NONE;
+    }
+}
+
+// Integer or float literal such as 42, -7, 3.25 or -0.5; integer literals beyond 64 bits become big
+static int numeric_literal(const char* text, NumericValue* out) {
+    const char* digits = text[0] == '-' ? text + 1 : text;
+    if (!isdigit((unsigned char)digits[0]) && !(digits[0] == '.' && isdigit((unsigned char)digits[1]))) return 0;
+    char* end;
+    out->big = NULL;
+    if (strchr(digits, '.')) {
+        out->d = strtod(text, &end);
+        out->is_float = 1;
+    } else {
+        errno = 0;
+        out->i = strtoll(text, &end, 10);
+        out->is_float = 0;
+        if (errno == ERANGE && *end == '\0') {
+            out->big = bigint_from_string(text, strlen(text));
+            return out->big != NULL;
+        }
+    }
+    return *end == '\0';
+}
+
+// Number or float variable (one scan, most recent binding first)
+static int numeric_variable(const char* name, NumericValue* out) {
+    for (int i = var_env_size - 1; i >= 0; i--) {
+        if (var_env[i].name && strcmp(var_env[i].name, name) == 0) {
+            if (var_env[i].type == VAR_TYPE_NUMBER) {
+                out->is_float = 0;
+                out->i = var_env[i].number_value;
+                out->big = NULL;
+                return 1;
+            }
+            if (var_env[i].type == VAR_TYPE_FLOAT) {
+                out->is_float = 1;
+                out->d = var_env[i].float_value;
+                out->big = NULL;
+                return 1;
+            }
+            if (var_env[i].type == VAR_TYPE_BIGINT) {
+                out->is_float = 0;
+                out->i = 0;
+                out->big = bigint_copy(var_env[i].big_value);
+                return out->big != NULL;
+            }
+            return 0;
+        }
+    }
+    return 0;
+}
+
+// Whether node, just evaluated, is a big integer (a big result, which is released, or a big integer variable)
+static int big_integer_value(ASTNode* node) {
+    BigInt* big = big_result_of(node);
+    if (big) {
+        bigint_free(big);
+        return 1;
+    }
+    if (node->type != AST_EXPR || !node->text || node->child_count != 0) return 0;
+    for (int i = var_env_size - 1; i >= 0; i--) {
+        if (var_env[i].name && strcmp(var_env[i].name, node->text) == 0) return var_env[i].type == VAR_TYPE_BIGINT;
+    }
+    return 0;
+}
+
+// Arrays hold integers and strings: report a float or big integer element (node just evaluated) instead of storing it
+static int array_element_rejected(ASTNode* node, const char* caller) {
+    double value;
+    if (float_result_of(node, &value)) {
+        char float_text[FLOAT_TEXT_SIZE];
+        format_float(float_text, sizeof(float_text), value);
+        fprintf(stderr, "Error: %s: arrays hold integers and strings, not floats (got %s) at line %d\n",
+                caller, float_text, node->line);
+        return 1;
+    }
+    if (big_integer_value(node)) {
+        fprintf(stderr, "Error: %s: array elements must fit in 64 bits at line %d\n", caller, node->line);
+        return 1;
+    }
+    return 0;
+}
+
+// Overflow-checked 64-bit arithmetic; each returns 1 if the exact result does not fit
+#if defined(__GNUC__) || defined(__clang__)
+#define checked_add(a, b, out) __builtin_add_overflow(a, b, out)
+#define checked_sub(a, b, out) __builtin_sub_overflow(a, b, out)
+#define checked_mul(a, b, out) __builtin_mul_overflow(a, b, out)
+#else
+static int checked_add(long long a, long long b, long long* out) {
+    if ((b > 0 && a > LLONG_MAX - b) || (b < 0 && a < LLONG_MIN - b)) return 1;
+    *out = a + b;
+    return 0;
+}
+
+static int checked_sub(long long a, long long b, long long* out) {
+    if ((b < 0 && a > LLONG_MAX + b) || (b > 0 && a < LLONG_MIN + b)) return 1;
+    *out = a - b;
+    return 0;
+}
+
+static int checked_mul(long long a, long long b, long long* out) {
+    if (a != 0 && b != 0) {
+        if ((a == -1 && b == LLONG_MIN) || (b == -1 && a == LLONG_MIN)) return 1;
+        if (a > 0 ? (b > 0 ? a > LLONG_MAX / b : b < LLONG_MIN / a)
+                  : (b > 0 ? a < LLONG_MIN / b : a < LLONG_MAX / b)) return 1;
+    }
+    *out = a * b;
+    return 0;
+}
+#endif
+
+static double numeric_as_double(const NumericValue* value) {
+    if (value->big) return bigint_to_double(value->big);
+    return value->is_float ? value->d : (double)value->i;
+}
+
+// Store a big integer result, demoting it to a plain integer when it fits
+static int set_big_numeric(NumericValue* out, BigInt* value) {
+    if (!value) return 0;
+    out->is_float = 0;
+    out->big = NULL;
+    if (bigint_fits_ll(value, &out->i)) bigint_free(value);
+    else out->big = value;
+    return 1;
+}
+
+// Integer operator where either side is (or the result must be) a big integer
+static int apply_big_operator(NumericOp op, const NumericValue* l, const NumericValue* r, NumericValue* out) {
+    BigInt* a = l->big ? l->big : bigint_from_ll(l->i);
+    BigInt* b = r->big ? r->big : bigint_from_ll(r->i);
+    int ok = a && b;
+    if (ok) {
+        int cmp;
+        BigInt* quotient = NULL;
+        BigInt* remainder = NULL;
+        out->is_float = 0;
+        out->big = NULL;
+        switch (op) {
+            case NUM_OP_ADD: ok = set_big_numeric(out, bigint_add(a, b)); break;
+            case NUM_OP_SUB: ok = set_big_numeric(out, bigint_sub(a, b)); break;
+            case NUM_OP_MUL: ok = set_big_numeric(out, bigint_mul(a, b)); break;
+            case NUM_OP_DIV:
+                ok = bigint_divmod(a, b, &quotient, NULL) && set_big_numeric(out, quotient);
+                break;
+            case NUM_OP_MOD:
+                ok = bigint_divmod(a, b, NULL, &remainder) && set_big_numeric(out, remainder);
+                break;
+            case NUM_OP_AND: out->i = a->size != 0 && b->size != 0; break;
+            case NUM_OP_OR: out->i = a->size != 0 || b->size != 0; break;
+            default:
+                cmp = bigint_compare(a, b);
+                switch (op) {
+                    case NUM_OP_EQ: out->i = cmp == 0; break;
+                    case NUM_OP_NE: out->i = cmp != 0; break;
+                    case NUM_OP_LT: out->i = cmp < 0; break;
+                    case NUM_OP_GT: out->i = cmp > 0; break;
+                    case NUM_OP_LE: out->i = cmp <= 0; break;
+                    case NUM_OP_GE: out->i = cmp >= 0; break;
+                    default: ok = 0; break;
+                }
+                break;
+        }
+    }
+    if (a && a != l->big) bigint_free(a);
+    if (b && b != r->big) bigint_free(b);
+    return ok;
+}
+
+/**
+ * @brief Applies a binary operator to typed operands
+ * @return 1 on success, 0 on division or modulo by zero
+ *
+ * int op int stays in integer arithmetic (truncating division) and is
+ * promoted to a big integer only when the exact result overflows; as soon
+ * as either side is a float both are promoted to double.
+ */
+static int apply_numeric_operator(NumericOp op, const NumericValue* l, const NumericValue* r, NumericValue* out) {
+    if (!l->is_float && !r->is_float && !l->big && !r->big) {
+        out->is_float = 0;
+        out->big = NULL;
+        switch (op) {
+            case NUM_OP_ADD:
+                if (checked_add(l->i, r->i, &out->i)) return apply_big_operator(op, l, r, out);
+                return 1;
+            case NUM_OP_SUB:
+                if (checked_sub(l->i, r->i, &out->i)) return apply_big_operator(op, l, r, out);
+                return 1;
+            case NUM_OP_MUL:
+                if (checked_mul(l->i, r->i, &out->i)) return apply_big_operator(op, l, r, out);
+                return 1;
+            case NUM_OP_DIV:
+                if (r->i == 0) return 0;
+                if (r->i == -1 && l->i == LLONG_MIN) return apply_big_operator(op, l, r, out);
+                out->i = l->i / r->i;
+                return 1;
+            case NUM_OP_MOD:
+                if (r->i == 0) return 0;
+                out->i = r->i == -1 ? 0 : l->i % r->i;
+                return 1;
+            case NUM_OP_EQ: out->i = l->i == r->i; return 1;
+            case NUM_OP_NE: out->i = l->i != r->i; return 1;
+            case NUM_OP_LT: out->i = l->i < r->i; return 1;
+            case NUM_OP_GT: out->i = l->i > r->i; return 1;
+            case NUM_OP_LE: out->i = l->i <= r->i; return 1;
+            case NUM_OP_GE: out->i = l->i >= r->i; return 1;
+            case NUM_OP_AND: out->i = l->i && r->i; return 1;
+            case NUM_OP_OR: out->i = l->i || r->i; return 1;
+            default: return 0;
+        }
+    }
+    if (!l->is_float && !r->is_float) {
+        if ((op == NUM_OP_DIV || op == NUM_OP_MOD) && !r->big && r->i == 0) return 0;
+        return apply_big_operator(op, l, r, out);
+    }
+
+    double x = numeric_as_double(l);
+    double y = numeric_as_double(r);
+    out->is_float = 1;
+    out->big = NULL;
+    switch (op) {
+        case NUM_OP_ADD: out->d = x + y; return 1;
+        case NUM_OP_SUB: out->d = x - y; return 1;
+        case NUM_OP_MUL: out->d = x * y; return 1;
+        case NUM_OP_DIV:
+            if (y == 0.0) return 0;
+            out->d = x / y;
+            return 1;
+        case NUM_OP_MOD:
+            if (y == 0.0) return 0;
+            out->d = fmod(x, y);
+            return 1;
+        default: break;
+    }
+    // Comparisons and logic produce integers
+    out->is_float = 0;
+    switch (op) {
+        case NUM_OP_EQ: out->i = x == y; return 1;
+        case NUM_OP_NE: out->i = x != y; return 1;
+        case NUM_OP_LT: out->i = x < y; return 1;
+        case NUM_OP_GT: out->i = x > y; return 1;
+        case NUM_OP_LE: out->i = x <= y; return 1;
+        case NUM_OP_GE: out->i = x >= y; return 1;
+        case NUM_OP_AND: out->i = x != 0.0 && y != 0.0; return 1;
+        case NUM_OP_OR: out->i = x != 0.0 || y != 0.0; return 1;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Evaluates a purely numeric expression tree with typed operands
+ * @param ast Literal, variable or operator node
+ * @param out Set to the result (integer or double)
+ * @return 1 on success; 0 if the tree holds anything else (strings, arrays,
+ *         calls, unknown names) or would divide by zero, in which case
+ *         nothing was evaluated with side effects and the caller falls back
+ */
+static int eval_numeric(ASTNode* ast, NumericValue* out) {
+    if (!ast || ast->type != AST_EXPR || !ast->text) return 0;
+    if (ast->child_count == 0) {
+        return numeric_literal(ast->text, out) || numeric_variable(ast->text, out);
+    }
+    if (ast->child_count != 2) return 0;
+    NumericOp op = numeric_operator(ast->text);
+    if (op == NUM_OP_NONE) return 0;
+
+    NumericValue l, r;
+    if (!eval_numeric(&ast->children[0], &l)) return 0;
+    if (!eval_numeric(&ast->children[1], &r)) {
+        if (l.big) bigint_free(l.big);
+        return 0;
+    }
+    int ok = apply_numeric_operator(op, &l, &r, out);
+    if (l.big) bigint_free(l.big);
+    if (r.big) bigint_free(r.big);
+    return ok;
+}
+
+// Whether an evaluated operand is a string marker rather than a number (1 = literal, -1 = string result)
+static int operand_is_string(ASTNode* node, long long value) {
+    NumericValue num;
+    if (value == 1) return node->text && is_string_literal(node->text);
+    if (value != -1) return 0;
+    if (node->child_count == 0 && node->text && (numeric_literal(node->text, &num) || numeric_variable(node->text, &num))) {
+        if (num.big) bigint_free(num.big);
+        return 0;
+    }
+    return 1;
+}
+
+// Helper function to set a float variable's value in the environment
+void set_float_value(const char* name, double value) {
+    // Check if variable already exists
+    for (int i = var_env_size - 1; i >= 0; i--) {
+        if (strcmp(var_env[i].name, name) == 0) {
+            // Update existing variable
+            if (var_env[i].type == VAR_TYPE_ARRAY && var_env[i].array_value) {
+                destroy_array(var_env[i].array_value);
+                var_env[i].array_value = NULL;
+            }
+            if (var_env[i].type == VAR_TYPE_OBJECT && var_env[i].object_value) {
+                destroy_object(var_env[i].object_value);
+                var_env[i].object_value = NULL;
+            }
+            release_big_value(&var_env[i]);
+            var_env[i].type = VAR_TYPE_FLOAT;
+            var_env[i].float_value = value;
+            var_env[i].number_value = 0;
+            var_env[i].string_value = NULL;
+            var_env[i].array_value = NULL;
+            var_env[i].object_value = NULL;
+            return;
+        }
+    }
+    
+    // Expand capacity if needed
+    if (var_env_size >= var_env_capacity) {
+        int new_capacity = var_env_capacity ? var_env_capacity * 2 : 8;
+        VarEntry* new_env = (VarEntry*)tracked_realloc(var_env, new_capacity * sizeof(VarEntry), __FILE__, __LINE__, "set_float_value");
+        if (!new_env) {
+            // Handle realloc failure
+            return;
+        }
+        var_env = new_env;
+        var_env_capacity = new_capacity;
+    }
+    
+    // Add new variable
+    var_env[var_env_size].name = tracked_strdup(name, __FILE__, __LINE__, "eval");
+    if (var_env[var_env_size].name) {
+        var_env[var_env_size].type = VAR_TYPE_FLOAT;
         var_env[var_env_size].float_value = value;
         var_env[var_env_size].number_value = 0;
         var_env[var_env_size].string_value = NULL;
@@ -3456,6 +3411,7 @@ void set_var_value(const char* name, long long value) {
                 destroy_object(var_env[i].object_value);
                 var_env[i].object_value = NULL;
             }
+            release_big_value(&var_env[i]);
             var_env[i].type = VAR_TYPE_NUMBER;
             var_env[i].number_value = value;
             var_env[i].string_value = NULL;
@@ -3489,6 +3445,28 @@ void set_var_value(const char* name, long long value) {
     }
 }
 
+// Bind name to a big integer (takes ownership)
+static void set_big_value(const char* name, BigInt* value) {
+    set_var_value(name, 0);
+    for (int i = var_env_size - 1; i >= 0; i--) {
+        if (var_env[i].name && strcmp(var_env[i].name, name) == 0) {
+            var_env[i].type = VAR_TYPE_BIGINT;
+            var_env[i].big_value = value;
+            return;
+        }
+    }
+    bigint_free(value);
+}
+
+// Bind name to a just-evaluated numeric expression, keeping floats as doubles and big integers exact
+static void set_numeric_result(const char* name, ASTNode* expr, long long value) {
+    double float_value;
+    BigInt* big = big_result_of(expr);
+    if (big) set_big_value(name, big);
+    else if (float_result_of(expr, &float_value)) set_float_value(name, float_value);
+    else set_var_value(name, value);
+}
+
 // Helper function to set an array variable in the environment
 void set_array_value(const char* name, MycoArray* array) {
     if (!name || !array) return;
@@ -3500,6 +3478,7 @@ void set_array_value(const char* name, MycoArray* array) {
             if (var_env[i].type == VAR_TYPE_ARRAY && var_env[i].array_value) {
                 destroy_array(var_env[i].array_value);
             }
+            release_big_value(&var_env[i]);
             var_env[i].type = VAR_TYPE_ARRAY;
             var_env[i].array_value = array;
             var_env[i].number_value = 0;
@@ -3578,6 +3557,52 @@ const char* get_str_value(const char* name) {
     return NULL;
 }
 
+/**
+ * @brief Looks up the value of a string variable used as an operand
+ * @return The variable's string, or NULL if the operand is not a plain variable
+ *
+ * Builtins such as type() leave their string in __str_result_<name> (the
+ * variable itself then holds an empty placeholder), so that slot wins.
+ */
+static const char* string_variable_operand(ASTNode* node) {
+    if (!node || node->type != AST_EXPR || !node->text || node->child_count > 0) return NULL;
+    if (is_string_literal(node->text)) return NULL;
+    char slot_name[128];
+    snprintf(slot_name, sizeof(slot_name), "__str_result_%s", node->text);
+    const char* value = get_str_value(slot_name);
+    return value ? value : get_str_value(node->text);
+}
+
+// Result slot written by a direct call to join/replace/trim, or NULL for any other expression
+static const char* string_builtin_result_slot(ASTNode* node) {
+    if (!node || node->type != AST_EXPR || !node->text || strcmp(node->text, "call") != 0) return NULL;
+    if (node->child_count < 1 || !node->children[0].text) return NULL;
+    const char* name = node->children[0].text;
+    if (strcmp(name, "join") == 0) return "__last_join_result";
+    if (strcmp(name, "replace") == 0) return "__last_replace_result";
+    if (strcmp(name, "trim") == 0) return "__last_trim_result";
+    if (strcmp(name, "choice") == 0) return "__last_choice_result";
+    if (strcmp(name, "to_string") == 0) return "__last_tostring_result";
+    return NULL;
+}
+
+/**
+ * @brief Resolves a string literal or string variable argument without copying it
+ * @param node Argument node
+ * @param len Set to the string length
+ * @return Pointer to the characters (a literal is not NUL-terminated at len), or NULL
+ */
+static const char* string_argument_view(ASTNode* node, size_t* len) {
+    if (!node || node->type != AST_EXPR || !node->text) return NULL;
+    if (is_string_literal(node->text)) {
+        *len = strlen(node->text) - 2;
+        return node->text + 1;
+    }
+    const char* value = get_str_value(node->text);
+    if (value) *len = strlen(value);
+    return value;
+}
+
 void set_str_value(const char* name, const char* value) {
     // Safety check: ensure name is not NULL
     if (!name) {
@@ -3649,6 +3674,7 @@ void set_lambda_value(const char* name, ASTNode* lambda_ast) {
                 destroy_object(var_env[i].object_value);
                 var_env[i].object_value = NULL;
             }
+            release_big_value(&var_env[i]);
             if (var_env[i].type == VAR_TYPE_LAMBDA && var_env[i].lambda_value) {
                 // Note: We don't free lambda_ast as it's owned by the parser
                 var_env[i].lambda_value = NULL;
@@ -3721,10 +3747,11 @@ long long execute_lambda(ASTNode* lambda_ast, ASTNode* args_node) {
         char* param_name = params->text;
         if (param_name) {
             // Evaluate the argument
+            clear_float_result();
             long long arg_value = eval_expression(&args_node->children[0]);
             
             // Store parameter in current scope
-            set_var_value(param_name, arg_value);
+            set_numeric_result(param_name, &args_node->children[0], arg_value);
             
             // Execute lambda body
             long long result = eval_expression(body);
@@ -3759,10 +3786,11 @@ long long execute_lambda(ASTNode* lambda_ast, ASTNode* args_node) {
                 char* param_name = params->children[i].text;
                 if (param_name) {
                     // Evaluate the argument
+                    clear_float_result();
                     long long arg_value = eval_expression(&args_node->children[i]);
                     
                     // Store parameter in current scope
-                    set_var_value(param_name, arg_value);
+                    set_numeric_result(param_name, &args_node->children[i], arg_value);
                 }
             }
         }
@@ -3823,10 +3851,11 @@ static void cleanup_var_env() {
  * @return New array instance, or NULL on failure
  */
 MycoArray* create_array(int initial_capacity, int is_string_array) {
-    if (initial_capacity <= 0) initial_capacity = 8;
+    if (initial_capacity <= 0) initial_capacity = INITIAL_ARRAY_CAPACITY;
     
-    // Use power-of-2 capacity for better memory alignment and cache performance
-    int optimal_capacity = get_ultra_optimal_capacity(initial_capacity);
+    // The capacity is exactly what was asked for: callers that know the final
+    // length pass it, and array_push doubles from there
+    int optimal_capacity = initial_capacity;
     
     MycoArray* array = (MycoArray*)tracked_malloc(sizeof(MycoArray), __FILE__, __LINE__, "create_array");
     if (!array) return NULL;
@@ -3834,6 +3863,7 @@ MycoArray* create_array(int initial_capacity, int is_string_array) {
     array->capacity = optimal_capacity;
     array->size = 0;
     array->is_string_array = is_string_array;
+    array->shared = NULL;
     
     if (is_string_array) {
         array->str_elements = (char**)tracked_malloc(optimal_capacity * sizeof(char*), __FILE__, __LINE__, "create_array_str");
@@ -3862,6 +3892,110 @@ MycoArray* create_array(int initial_capacity, int is_string_array) {
     return array;
 }
 
+/*******************************************************************************
+ * SHARED ARRAY STORAGE (SLICE VIEWS)
+ ******************************************************************************/
+
+// A buffer taken over from an array once a slice view of it exists
+struct MycoArrayStorage {
+    long long* elements;
+    char** str_elements;
+    int string_count;        // Strings owned by the buffer (freed with it)
+    int refs;                // Arrays (the original and its views) still using it
+};
+
+static void release_array_storage(MycoArrayStorage* storage) {
+    if (--storage->refs > 0) return;
+    if (storage->str_elements) {
+        for (int i = 0; i < storage->string_count; i++) {
+            if (storage->str_elements[i]) tracked_free(storage->str_elements[i], __FILE__, __LINE__, "destroy_array_str");
+        }
+        tracked_free(storage->str_elements, __FILE__, __LINE__, "destroy_array_str_array");
+    }
+    if (storage->elements) tracked_free(storage->elements, __FILE__, __LINE__, "destroy_array_num_array");
+    tracked_free(storage, __FILE__, __LINE__, "array_storage");
+}
+
+/**
+ * @brief Creates a view of source[start, start + length) that shares its buffer
+ * @return The view, or NULL on allocation failure (the caller checks the range)
+ *
+ * Nothing is copied: the view's elements point into the source's buffer,
+ * so indexing, len(), for loops and read-only builtins work on it as on
+ * any array. Whichever side is written first takes a private copy
+ * (array_make_writable), so neither ever sees the other's changes.
+ */
+MycoArray* array_view(MycoArray* source, int start, int length) {
+    if (!source->shared) {
+        // First view: the source's buffer moves into shared storage
+        MycoArrayStorage* storage = (MycoArrayStorage*)tracked_malloc(sizeof(MycoArrayStorage), __FILE__, __LINE__, "array_storage");
+        if (!storage) return NULL;
+        storage->elements = source->elements;
+        storage->str_elements = source->str_elements;
+        storage->string_count = source->is_string_array ? source->size : 0;
+        storage->refs = 1;
+        source->shared = storage;
+    }
+    MycoArray* view = (MycoArray*)tracked_malloc(sizeof(MycoArray), __FILE__, __LINE__, "array_view");
+    if (!view) return NULL;
+    view->elements = source->elements ? source->elements + start : NULL;
+    view->str_elements = source->str_elements ? source->str_elements + start : NULL;
+    view->capacity = length;
+    view->size = length;
+    view->is_string_array = source->is_string_array;
+    view->shared = source->shared;
+    view->shared->refs++;
+    return view;
+}
+
+/**
+ * @brief Copies an array in O(1): the copy shares source's buffer until either is written
+ * @return The copy, or NULL on allocation failure
+ */
+MycoArray* array_copy(MycoArray* source) {
+    return array_view(source, 0, source->size);
+}
+
+/**
+ * @brief Gives an array a buffer of its own before it is modified in place
+ * @return 1 on success, 0 on allocation failure (the array is left shared)
+ */
+int array_make_writable(MycoArray* array) {
+    MycoArrayStorage* storage = array ? array->shared : NULL;
+    if (!storage) return 1;
+    if (storage->refs == 1 && array->elements == storage->elements && array->str_elements == storage->str_elements) {
+        // Every other holder is gone and this one starts at the buffer: take it back,
+        // freeing the strings past our own size that the storage still owned
+        for (int i = array->size; array->is_string_array && i < storage->string_count; i++) {
+            if (array->str_elements[i]) tracked_free(array->str_elements[i], __FILE__, __LINE__, "array_reclaim_str");
+            array->str_elements[i] = NULL;
+        }
+        tracked_free(storage, __FILE__, __LINE__, "array_storage");
+        array->shared = NULL;
+        return 1;
+    }
+    int capacity = array->size > 0 ? array->size : 1;
+    if (array->is_string_array) {
+        char** copy = (char**)tracked_malloc(capacity * sizeof(char*), __FILE__, __LINE__, "array_unshare_str");
+        if (!copy) return 0;
+        for (int i = 0; i < array->size; i++) {
+            copy[i] = array->str_elements[i] ? tracked_strdup(array->str_elements[i], __FILE__, __LINE__, "array_unshare_str") : NULL;
+        }
+        array->str_elements = copy;
+        array->elements = NULL;
+    } else {
+        long long* copy = (long long*)tracked_malloc(capacity * sizeof(long long), __FILE__, __LINE__, "array_unshare_num");
+        if (!copy) return 0;
+        if (array->size > 0) memcpy(copy, array->elements, array->size * sizeof(long long));
+        array->elements = copy;
+        array->str_elements = NULL;
+    }
+    array->capacity = capacity;
+    array->shared = NULL;
+    release_array_storage(storage);
+    return 1;
+}
+
 /**
  * @brief Destroys an array and frees all associated memory
  * @param array The array to destroy
@@ -3869,7 +4003,10 @@ MycoArray* create_array(int initial_capacity, int is_string_array) {
 void destroy_array(MycoArray* array) {
     if (!array) return;
     
-    if (array->is_string_array && array->str_elements) {
+    if (array->shared) {
+        // The buffer belongs to the shared storage; the last holder frees it
+        release_array_storage(array->shared);
+    } else if (array->is_string_array && array->str_elements) {
         // Free all string elements
         for (int i = 0; i < array->size; i++) {
             if (array->str_elements[i]) {
@@ -3884,6 +4021,71 @@ void destroy_array(MycoArray* array) {
     tracked_free(array, __FILE__, __LINE__, "destroy_array");
 }
 
+// Reallocates the element buffer to new_capacity (>= size); new string slots start NULL
+static int array_resize_buffer(MycoArray* array, int new_capacity) {
+    if (new_capacity < 1) new_capacity = 1;
+    if (array->is_string_array) {
+        char** new_elements = (char**)tracked_realloc(array->str_elements, new_capacity * sizeof(char*), __FILE__, __LINE__, "array_resize_str");
+        if (!new_elements) return 0;
+        array->str_elements = new_elements;
+        for (int i = array->capacity; i < new_capacity; i++) {
+            array->str_elements[i] = NULL;
+        }
+    } else {
+        long long* new_elements = (long long*)tracked_realloc(array->elements, new_capacity * sizeof(long long), __FILE__, __LINE__, "array_resize_num");
+        if (!new_elements) return 0;
+        array->elements = new_elements;
+    }
+    array->capacity = new_capacity;
+    return 1;
+}
+
+/**
+ * @brief Grows an array's capacity to at least min_capacity elements
+ * @return 1 on success, 0 on allocation failure
+ *
+ * Appending up to min_capacity elements afterwards never reallocates.
+ */
+int array_reserve(MycoArray* array, int min_capacity) {
+    if (!array || !array_make_writable(array)) return 0;
+    if (min_capacity <= array->capacity) return 1;
+    return array_resize_buffer(array, min_capacity);
+}
+
+/**
+ * @brief Releases unused capacity so the buffer holds exactly size elements
+ * @return 1 on success, 0 on allocation failure (the array is unchanged)
+ */
+int array_shrink_to_fit(MycoArray* array) {
+    if (!array || !array_make_writable(array)) return 0;
+    if (array->capacity <= array->size || array->capacity <= 1) return 1;
+    return array_resize_buffer(array, array->size);
+}
+
+/**
+ * @brief Removes the last element of an array
+ * @return 1 if an element was removed, 0 if the array was empty
+ *
+ * Once the array is down to a quarter of its capacity the buffer is halved
+ * (never below INITIAL_ARRAY_CAPACITY). Halving at a quarter rather than at
+ * half leaves room for the array to grow back, so alternating push and pop
+ * at a boundary never reallocates on every call.
+ */
+int array_pop(MycoArray* array) {
+    if (!array || array->size == 0 || !array_make_writable(array)) return 0;
+    array->size--;
+    if (array->is_string_array && array->str_elements[array->size]) {
+        tracked_free(array->str_elements[array->size], __FILE__, __LINE__, "array_pop_str");
+        array->str_elements[array->size] = NULL;
+    }
+    if (array->capacity > INITIAL_ARRAY_CAPACITY && array->size <= array->capacity / 4) {
+        int new_capacity = array->capacity / 2;
+        if (new_capacity < INITIAL_ARRAY_CAPACITY) new_capacity = INITIAL_ARRAY_CAPACITY;
+        array_resize_buffer(array, new_capacity);  // Failure just keeps the larger buffer
+    }
+    return 1;
+}
+
 /**
  * @brief Adds an element to the end of an array
  * @param array The array to modify
@@ -3891,7 +4093,7 @@ void destroy_array(MycoArray* array) {
  * @return 1 on success, 0 on failure
  */
 int array_push(MycoArray* array, void* element) {
-    if (!array || !element) return 0;
+    if (!array || !element || !array_make_writable(array)) return 0;
     
     // Use fast array operations for known-safe access
     if (array->size < array->capacity) {
@@ -3906,21 +4108,7 @@ int array_push(MycoArray* array, void* element) {
     }
     
     // Slow path: expand capacity if needed
-        int new_capacity = array->capacity * 2;
-        if (array->is_string_array) {
-            char** new_elements = (char**)tracked_realloc(array->str_elements, new_capacity * sizeof(char*), __FILE__, __LINE__, "array_push_str");
-            if (!new_elements) return 0;
-            array->str_elements = new_elements;
-            // Initialize new elements to NULL
-            for (int i = array->capacity; i < new_capacity; i++) {
-                array->str_elements[i] = NULL;
-            }
-        } else {
-            long long* new_elements = (long long*)tracked_realloc(array->elements, new_capacity * sizeof(long long), __FILE__, __LINE__, "array_push_num");
-            if (!new_elements) return 0;
-            array->elements = new_elements;
-        }
-        array->capacity = new_capacity;
+    if (!array_resize_buffer(array, array->capacity * 2)) return 0;
     
     // Add the element (only once, after capacity expansion)
     if (array->is_string_array) {
@@ -3941,7 +4129,7 @@ int array_push(MycoArray* array, void* element) {
  * @return 1 on success, 0 on failure
  */
 int array_set(MycoArray* array, int index, void* element) {
-    if (!array || !element || index < 0 || index >= array->size) return 0;
+    if (!array || !element || index < 0 || index >= array->size || !array_make_writable(array)) return 0;
     
     if (array->is_string_array) {
         // Free old string if it exists
@@ -4014,76 +4202,285 @@ MycoObject* create_object(int initial_capacity) {
     obj->property_count = 0;
     obj->capacity = initial_capacity;
     obj->is_method = 0;
+    obj->shape = NULL;
     
     return obj;
 }
 
+/*******************************************************************************
+ * OBJECT LITERAL SHAPES
+ ******************************************************************************/
+
 /**
- * @brief Creates an object from an AST_OBJECT_LITERAL node (recursive helper)
- * @param ast The AST_OBJECT_LITERAL node to process
- * @return Pointer to the created object, or NULL on failure
+ * An object literal always produces the same property names in the same
+ * order, so its layout is worked out once per literal and cached by node.
+ * Every object built from it shares the shape's names and is a single
+ * allocation (struct, values and types together); nothing is duplicated
+ * or searched per instance.
  */
-MycoObject* create_object_from_literal(ASTNode* ast) {
-    if (!ast || ast->type != AST_OBJECT_LITERAL) {
-        return NULL;
-    }
-    
-    // Create object with appropriate capacity
-    MycoObject* obj = create_object(ast->child_count);
-    if (!obj) {
-        return NULL;
-    }
-    
-    // Add properties to the object
-    for (int i = 0; i < ast->child_count; i++) {
-        if (ast->children[i].type == AST_EXPR && 
-            ast->children[i].text && 
-            strcmp(ast->children[i].text, "prop") == 0 &&
-            ast->children[i].child_count == 2) {
-            
-            // Get property name
-            char* prop_name = ast->children[i].children[0].text;
-            if (!prop_name) continue;
-            
-            // Handle property value based on its type
-            if (ast->children[i].children[1].type == AST_OBJECT_LITERAL) {
-                // Recursive case: nested object literal
-                MycoObject* nested_obj = create_object_from_literal(&ast->children[i].children[1]);
-                if (nested_obj) {
-                    object_set_property_typed(obj, prop_name, nested_obj, PROP_TYPE_OBJECT);
-                } else {
-                    object_set_property_typed(obj, prop_name, (void*)0, PROP_TYPE_NUMBER);
-                }
-            } else if (ast->children[i].children[1].type == AST_EXPR && 
-                       ast->children[i].children[1].text &&
-                       ast->children[i].children[1].text[0] == '"') {
-                // String literal
-                char* str_value = ast->children[i].children[1].text;
-                if (strlen(str_value) >= 2) {
-                    char* clean_str = tracked_strdup(str_value + 1, __FILE__, __LINE__, "eval"); // Skip first quote
-                    clean_str[strlen(clean_str) - 1] = '\0'; // Remove last quote
-                    object_set_property_typed(obj, prop_name, clean_str, PROP_TYPE_STRING);
-                } else {
-                    object_set_property_typed(obj, prop_name, tracked_strdup("", __FILE__, __LINE__, "object_set_property_empty"), PROP_TYPE_STRING);
-                }
-            } else {
-                // Evaluate as expression (number)
-                long long prop_value = eval_expression(&ast->children[i].children[1]);
-                object_set_property_typed(obj, prop_name, (void*)(long long)prop_value, PROP_TYPE_NUMBER);
-            }
-        }
+struct ObjectShape {
+    int refs;                   // The cache entry plus every object built from the shape
+    int property_count;         // Distinct property names
+    int child_count;            // Children of the literal it was built from
+    char** names;               // Distinct names, first occurrence first
+    PropertyType* types;        // Type each property gets when its value is stored
+    int* slots;                 // Per literal child: property slot, or -1 if the child is not a property
+};
+
+#define SHAPE_CACHE_SIZE 256
+typedef struct {
+    ASTNode* node;
+    ObjectShape* shape;
+} ShapeCacheEntry;
+static ShapeCacheEntry shape_cache[SHAPE_CACHE_SIZE];
+
+// Literal child i as (name, value) when it is a property, else 0
+static int literal_property(ASTNode* literal, int i, const char** name, ASTNode** value) {
+    ASTNode* child = &literal->children[i];
+    if (child->type != AST_EXPR || !child->text || strcmp(child->text, "prop") != 0 ||
+        child->child_count != 2 || !child->children[0].text) {
+        return 0;
     }
-    
-    return obj;
+    *name = child->children[0].text;
+    *value = &child->children[1];
+    return 1;
 }
 
-/**
+static int is_string_value_node(ASTNode* value) {
+    return value->type == AST_EXPR && value->text && value->text[0] == '"';
+}
+
+// Float properties keep the bits of their double in the value slot
+static void* float_property_value(double value) {
+    void* slot = NULL;
+    memcpy(&slot, &value, sizeof(value));
+    return slot;
+}
+
+static double property_float_value(void* slot) {
+    double value;
+    memcpy(&value, &slot, sizeof(value));
+    return value;
+}
+
+// Evaluate value_node and store it in obj's property name as a float or a number
+static int set_numeric_property(MycoObject* obj, const char* name, ASTNode* value_node) {
+    clear_float_result();
+    long long value = eval_expression(value_node);
+    if (big_integer_value(value_node)) {
+        fprintf(stderr, "Error: Property '%s' must fit in 64 bits at line %d\n", name, value_node->line);
+        return 0;
+    }
+    double float_value;
+    if (float_result_of(value_node, &float_value)) {
+        return object_set_property_typed(obj, name, float_property_value(float_value), PROP_TYPE_FLOAT);
+    }
+    return object_set_property(obj, name, (void*)(long long)value);
+}
+
+static void release_object_shape(ObjectShape* shape) {
+    if (--shape->refs > 0) return;
+    for (int i = 0; i < shape->property_count; i++) {
+        tracked_free(shape->names[i], __FILE__, __LINE__, "object_shape_name");
+    }
+    tracked_free(shape->names, __FILE__, __LINE__, "object_shape_names");
+    tracked_free(shape->types, __FILE__, __LINE__, "object_shape_types");
+    tracked_free(shape->slots, __FILE__, __LINE__, "object_shape_slots");
+    tracked_free(shape, __FILE__, __LINE__, "object_shape");
+}
+
+static ObjectShape* build_object_shape(ASTNode* literal) {
+    int n = literal->child_count;
+    ObjectShape* shape = (ObjectShape*)tracked_malloc(sizeof(ObjectShape), __FILE__, __LINE__, "object_shape");
+    if (!shape) return NULL;
+    shape->refs = 1;
+    shape->property_count = 0;
+    shape->child_count = n;
+    shape->names = (char**)tracked_malloc(n * sizeof(char*), __FILE__, __LINE__, "object_shape_names");
+    shape->types = (PropertyType*)tracked_malloc(n * sizeof(PropertyType), __FILE__, __LINE__, "object_shape_types");
+    shape->slots = (int*)tracked_malloc(n * sizeof(int), __FILE__, __LINE__, "object_shape_slots");
+    if (!shape->names || !shape->types || !shape->slots) {
+        release_object_shape(shape);
+        return NULL;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const char* name;
+        ASTNode* value;
+        shape->slots[i] = -1;
+        if (!literal_property(literal, i, &name, &value)) continue;
+
+        // A repeated name reuses its first slot, so the last value wins
+        int slot = 0;
+        while (slot < shape->property_count && strcmp(shape->names[slot], name) != 0) slot++;
+        if (slot == shape->property_count) {
+            shape->names[slot] = tracked_strdup(name, __FILE__, __LINE__, "object_shape_name");
+            if (!shape->names[slot]) {
+                release_object_shape(shape);
+                return NULL;
+            }
+            shape->property_count++;
+        }
+        shape->slots[i] = slot;
+        shape->types[slot] = value->type == AST_OBJECT_LITERAL ? PROP_TYPE_OBJECT :
+                             is_string_value_node(value) ? PROP_TYPE_STRING : PROP_TYPE_NUMBER;
+    }
+    return shape;
+}
+
+static ObjectShape* literal_shape(ASTNode* literal) {
+    ShapeCacheEntry* entry = &shape_cache[((size_t)literal >> 4) % SHAPE_CACHE_SIZE];
+    if (entry->node == literal && entry->shape && entry->shape->child_count == literal->child_count) {
+        return entry->shape;
+    }
+
+    // Miss (or the slot belongs to another literal): build and take the slot over
+    ObjectShape* shape = build_object_shape(literal);
+    if (!shape) return NULL;
+    if (entry->shape) release_object_shape(entry->shape);
+    entry->node = literal;
+    entry->shape = shape;
+    return shape;
+}
+
+// One allocation holding the object, its values and its types; the names stay in the shape
+static MycoObject* instantiate_shape(ObjectShape* shape) {
+    int capacity = shape->property_count;
+    MycoObject* obj = (MycoObject*)tracked_malloc(sizeof(MycoObject) + capacity * (sizeof(void*) + sizeof(PropertyType)),
+                                                  __FILE__, __LINE__, "create_object_shaped");
+    if (!obj) return NULL;
+    obj->property_values = (void**)(obj + 1);
+    obj->property_types = (PropertyType*)(obj->property_values + capacity);
+    obj->property_names = shape->names;
+    memset(obj->property_values, 0, capacity * sizeof(void*));
+    memcpy(obj->property_types, shape->types, capacity * sizeof(PropertyType));
+    obj->property_count = capacity;
+    obj->capacity = capacity;
+    obj->is_method = 0;
+    obj->shape = shape;
+    shape->refs++;
+    return obj;
+}
+
+/**
+ * @brief Gives a shaped object property arrays of its own before names are added or removed
+ * @return 1 on success, 0 on allocation failure (the object is unchanged)
+ */
+static int object_detach_shape(MycoObject* obj) {
+    ObjectShape* shape = obj->shape;
+    if (!shape) return 1;
+    int capacity = obj->capacity > 0 ? obj->capacity : 1;
+    char** names = (char**)tracked_malloc(capacity * sizeof(char*), __FILE__, __LINE__, "create_object_names");
+    void** values = (void**)tracked_malloc(capacity * sizeof(void*), __FILE__, __LINE__, "create_object_values");
+    PropertyType* types = (PropertyType*)tracked_malloc(capacity * sizeof(PropertyType), __FILE__, __LINE__, "create_object_types");
+    int ok = names && values && types;
+    for (int i = 0; ok && i < obj->property_count; i++) {
+        names[i] = tracked_strdup(obj->property_names[i], __FILE__, __LINE__, "eval");
+        if (!names[i]) {
+            while (i-- > 0) tracked_free(names[i], __FILE__, __LINE__, "destroy_object_name");
+            ok = 0;
+        }
+    }
+    if (!ok) {
+        if (names) tracked_free(names, __FILE__, __LINE__, "create_object_names_fail");
+        if (values) tracked_free(values, __FILE__, __LINE__, "create_object_values_fail");
+        if (types) tracked_free(types, __FILE__, __LINE__, "create_object_types_fail");
+        return 0;
+    }
+    memcpy(values, obj->property_values, obj->property_count * sizeof(void*));
+    memcpy(types, obj->property_types, obj->property_count * sizeof(PropertyType));
+    // The old values and types live on inside the object's own allocation, unused
+    obj->property_names = names;
+    obj->property_values = values;
+    obj->property_types = types;
+    obj->capacity = capacity;
+    obj->shape = NULL;
+    release_object_shape(shape);
+    return 1;
+}
+
+/**
+ * @brief Creates an object from an AST_OBJECT_LITERAL node (recursive helper)
+ * @param ast The AST_OBJECT_LITERAL node to process
+ * @return Pointer to the created object, or NULL on failure
+ */
+MycoObject* create_object_from_literal(ASTNode* ast) {
+    if (!ast || ast->type != AST_OBJECT_LITERAL) {
+        return NULL;
+    }
+    
+    // An empty literal gets room to grow
+    if (ast->child_count == 0) {
+        return create_object(8);
+    }
+    
+    ObjectShape* shape = literal_shape(ast);
+    MycoObject* obj = shape ? instantiate_shape(shape) : NULL;
+    if (!obj) {
+        return NULL;
+    }
+    
+    // Store each value in its precomputed slot
+    for (int i = 0; i < ast->child_count; i++) {
+        int slot = shape->slots[i];
+        const char* prop_name;
+        ASTNode* value_node;
+        if (slot < 0 || !literal_property(ast, i, &prop_name, &value_node)) continue;
+        
+        if (value_node->type == AST_OBJECT_LITERAL) {
+            // Recursive case: nested object literal
+            MycoObject* nested_obj = create_object_from_literal(value_node);
+            if (!nested_obj) {
+                destroy_object(obj);
+                return NULL;
+            }
+            obj->property_values[slot] = nested_obj;
+            obj->property_types[slot] = PROP_TYPE_OBJECT;
+        } else if (is_string_value_node(value_node)) {
+            // String literal (quotes removed)
+            size_t len = strlen(value_node->text);
+            char* clean_str = len >= 2 ? tracked_strdup(value_node->text + 1, __FILE__, __LINE__, "eval") :
+                                         tracked_strdup("", __FILE__, __LINE__, "object_set_property_empty");
+            if (clean_str && len >= 2) clean_str[len - 2] = '\0';
+            obj->property_values[slot] = clean_str;
+            obj->property_types[slot] = PROP_TYPE_STRING;
+        } else {
+            // Evaluate as expression (number or float)
+            clear_float_result();
+            long long prop_value = eval_expression(value_node);
+            if (big_integer_value(value_node)) {
+                fprintf(stderr, "Error: Property '%s' must fit in 64 bits at line %d\n", prop_name, value_node->line);
+                destroy_object(obj);
+                return NULL;
+            }
+            double float_value;
+            if (float_result_of(value_node, &float_value)) {
+                obj->property_values[slot] = float_property_value(float_value);
+                obj->property_types[slot] = PROP_TYPE_FLOAT;
+            } else {
+                obj->property_values[slot] = (void*)(long long)prop_value;
+                obj->property_types[slot] = PROP_TYPE_NUMBER;
+            }
+        }
+    }
+    
+    return obj;
+}
+
+/**
  * @brief Destroys an object and frees all associated memory
  * @param obj The object to destroy
  */
 void destroy_object(MycoObject* obj) {
     if (!obj) return;
     
+    if (obj->shape) {
+        // Names belong to the shape; values and types share the object's allocation
+        release_object_shape(obj->shape);
+        tracked_free(obj, __FILE__, __LINE__, "destroy_object");
+        return;
+    }
+    
     // Free all property names and values
     for (int i = 0; i < obj->property_count; i++) {
         if (obj->property_names[i]) {
@@ -4129,6 +4526,9 @@ int object_set_property_typed(MycoObject* obj, const char* name, void* value, Pr
         }
     }
     
+    // A new name needs arrays the object owns
+    if (!object_detach_shape(obj)) return 0;
+    
     // Expand capacity if needed
     if (obj->property_count >= obj->capacity) {
         int new_capacity = obj->capacity * 2;
@@ -4201,6 +4601,121 @@ PropertyType object_get_property_type(MycoObject* obj, const char* name) {
     return PROP_TYPE_NUMBER; // Default if not found
 }
 
+/*******************************************************************************
+ * PROPERTY ACCESS PATHS
+ ******************************************************************************/
+
+/**
+ * A chain like cfg.db.pool.size is compiled once per AST_DOT node into its
+ * root variable and key list. Each hop remembers the shape it last saw and
+ * the slot the key had there, so reading the same site again costs one
+ * variable lookup plus a pointer compare per hop; only objects with another
+ * layout fall back to a search by name. The cache holds a reference on each
+ * remembered shape, so a freed shape's address can never be mistaken for it.
+ */
+typedef struct {
+    ASTNode* node;
+    const char* root;           // Root variable name (AST text)
+    int hop_count;              // 0 when the node is not a plain identifier chain
+    const char** keys;          // Key per hop (AST text)
+    ObjectShape** shapes;       // Per hop: shape seen last time, or NULL
+    int* slots;                 // Per hop: slot of the key in that shape
+} AccessPath;
+
+#define ACCESS_PATH_CACHE_SIZE 256
+static AccessPath access_path_cache[ACCESS_PATH_CACHE_SIZE];
+
+static void clear_access_path(AccessPath* path) {
+    for (int i = 0; i < path->hop_count; i++) {
+        if (path->shapes[i]) release_object_shape(path->shapes[i]);
+    }
+    if (path->keys) tracked_free(path->keys, __FILE__, __LINE__, "access_path_keys");
+    if (path->shapes) tracked_free(path->shapes, __FILE__, __LINE__, "access_path_shapes");
+    if (path->slots) tracked_free(path->slots, __FILE__, __LINE__, "access_path_slots");
+    memset(path, 0, sizeof(*path));
+}
+
+// Compiles root.k1...kn (left-nested AST_DOT nodes over an identifier) into path
+static void compile_access_path(ASTNode* dot, AccessPath* path) {
+    path->node = dot;
+    int hops = 0;
+    ASTNode* node = dot;
+    while (node->type == AST_DOT && node->child_count >= 2 &&
+           node->children[1].type == AST_EXPR && node->children[1].text) {
+        hops++;
+        node = &node->children[0];
+    }
+    if (node->type != AST_EXPR || !node->text || node->child_count > 0 || node == dot) return;
+
+    path->keys = (const char**)tracked_malloc(hops * sizeof(char*), __FILE__, __LINE__, "access_path_keys");
+    path->shapes = (ObjectShape**)tracked_malloc(hops * sizeof(ObjectShape*), __FILE__, __LINE__, "access_path_shapes");
+    path->slots = (int*)tracked_malloc(hops * sizeof(int), __FILE__, __LINE__, "access_path_slots");
+    if (!path->keys || !path->shapes || !path->slots) {
+        clear_access_path(path);
+        path->node = dot;
+        return;
+    }
+    path->root = node->text;
+    path->hop_count = hops;
+    node = dot;
+    for (int i = hops - 1; i >= 0; i--) {
+        path->keys[i] = node->children[1].text;
+        path->shapes[i] = NULL;
+        path->slots[i] = 0;
+        node = &node->children[0];
+    }
+}
+
+// Slot of key in obj, using and refreshing the hop's remembered shape; -1 if absent
+static int access_path_slot(AccessPath* path, int hop, MycoObject* obj) {
+    ObjectShape* shape = obj->shape;
+    if (shape && path->shapes[hop] == shape) return path->slots[hop];
+
+    const char* key = path->keys[hop];
+    for (int i = 0; i < obj->property_count; i++) {
+        if (obj->property_names[i] && strcmp(obj->property_names[i], key) == 0) {
+            if (shape) {
+                shape->refs++;
+                if (path->shapes[hop]) release_object_shape(path->shapes[hop]);
+                path->shapes[hop] = shape;
+                path->slots[hop] = i;
+            }
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Resolves a chained property read such as a.b.c through the site's access path
+ * @param dot The outermost AST_DOT node
+ * @param slot Set to the final key's slot in the returned object
+ * @return The object holding the final key, or NULL when the chain is not a plain
+ *         identifier chain or any link is missing (callers fall back to the by-name path)
+ */
+static MycoObject* resolve_access_path(ASTNode* dot, int* slot) {
+    AccessPath* path = &access_path_cache[((size_t)dot >> 4) % ACCESS_PATH_CACHE_SIZE];
+    if (path->node != dot || (path->hop_count > 0 && path->keys[path->hop_count - 1] != dot->children[1].text)) {
+        // Miss (or the slot belongs to another site): compile and take the slot over
+        clear_access_path(path);
+        compile_access_path(dot, path);
+    }
+    if (path->hop_count == 0) return NULL;
+
+    MycoObject* obj = get_object_value(path->root);
+    for (int hop = 0; obj; hop++) {
+        int index = access_path_slot(path, hop, obj);
+        if (index < 0) return NULL;
+        if (hop == path->hop_count - 1) {
+            *slot = index;
+            return obj;
+        }
+        if (obj->property_types[index] != PROP_TYPE_OBJECT) return NULL;
+        obj = (MycoObject*)obj->property_values[index];
+    }
+    return NULL;
+}
+
 /**
  * @brief Helper function to recursively evaluate chained property access for printing
  * @param ast The AST node to evaluate (could be AST_EXPR or AST_DOT)
@@ -4209,6 +4724,13 @@ PropertyType object_get_property_type(MycoObject* obj, const char* name) {
 static void* evaluate_chained_property_for_print(ASTNode* ast, PropertyType* out_type) {
     if (!ast || !out_type) return NULL;
     
+    int slot;
+    MycoObject* holder = ast->type == AST_DOT ? resolve_access_path(ast, &slot) : NULL;
+    if (holder) {
+        *out_type = holder->property_types[slot];
+        return holder->property_values[slot];
+    }
+    
     if (ast->type == AST_EXPR && ast->text) {
         // Base case: simple identifier, get the object
         MycoObject* obj = get_object_value(ast->text);
@@ -4248,7 +4770,8 @@ static void* evaluate_chained_property_for_print(ASTNode* ast, PropertyType* out
  * @param prop_type The type of the property
  */
 static void print_property_value(void* prop_value, PropertyType prop_type) {
-    if (!prop_value) {
+    // A float of 0.0 is stored as all-zero bits
+    if (!prop_value && prop_type != PROP_TYPE_FLOAT) {
         return;
     }
     
@@ -4262,6 +4785,12 @@ static void print_property_value(void* prop_value, PropertyType prop_type) {
             printf("%lld", (long long)prop_value);
             break;
         }
+        case PROP_TYPE_FLOAT: {
+            char float_text[FLOAT_TEXT_SIZE];
+            format_float(float_text, sizeof(float_text), property_float_value(prop_value));
+            printf("%s", float_text);
+            break;
+        }
         case PROP_TYPE_OBJECT: {
             MycoObject* obj = (MycoObject*)prop_value;
             printf("{");
@@ -4375,6 +4904,7 @@ void set_object_value(const char* name, MycoObject* obj) {
             if (var_env[i].type == VAR_TYPE_OBJECT && var_env[i].object_value) {
                 destroy_object(var_env[i].object_value);
             }
+            release_big_value(&var_env[i]);
             var_env[i].type = VAR_TYPE_OBJECT;
             var_env[i].object_value = obj;
             var_env[i].number_value = 0;
@@ -4408,6 +4938,99 @@ void set_object_value(const char* name, MycoObject* obj) {
     }
 }
 
+/**
+ * @brief Detaches an object from a variable without destroying it
+ * @param name The variable name
+ * @return The object previously held by the variable, or NULL
+ *
+ * Used to move objects produced by builtins out of their result slot so
+ * the slot never aliases the object now owned by a user variable.
+ */
+static MycoObject* take_object_value(const char* name) {
+    for (int i = var_env_size - 1; i >= 0; i--) {
+        if (var_env[i].name && strcmp(var_env[i].name, name) == 0) {
+            if (var_env[i].type != VAR_TYPE_OBJECT) return NULL;
+            MycoObject* obj = var_env[i].object_value;
+            var_env[i].object_value = NULL;
+            var_env[i].type = VAR_TYPE_NUMBER;
+            var_env[i].number_value = 0;
+            return obj;
+        }
+    }
+    return NULL;
+}
+
+// The object a library call returned with -3, or NULL when that call did not leave one
+// (a plain -3 number, or a result pending from some earlier call)
+static MycoObject* take_call_object_result(ASTNode* call) {
+    if (!call || call != object_result_call) return NULL;
+    object_result_call = NULL;
+    return take_object_value("__last_object_result");
+}
+
+// Array counterpart of take_object_value
+static MycoArray* take_array_value(const char* name) {
+    for (int i = var_env_size - 1; i >= 0; i--) {
+        if (var_env[i].name && strcmp(var_env[i].name, name) == 0) {
+            if (var_env[i].type != VAR_TYPE_ARRAY) return NULL;
+            MycoArray* array = var_env[i].array_value;
+            var_env[i].array_value = NULL;
+            var_env[i].type = VAR_TYPE_NUMBER;
+            var_env[i].number_value = 0;
+            return array;
+        }
+    }
+    return NULL;
+}
+
+// The array a library call returned with -2, or NULL when that call did not leave one
+static MycoArray* take_call_array_result(ASTNode* call) {
+    if (!call || call != array_result_call) return NULL;
+    array_result_call = NULL;
+    return take_array_value("__last_array_result");
+}
+
+// Moves the array out of split()'s, slice()'s or copy()'s result slot if node is a direct call to one, else NULL
+static MycoArray* take_direct_array_result(ASTNode* node) {
+    if (!node->text || strcmp(node->text, "call") != 0 || node->child_count < 1 || !node->children[0].text) return NULL;
+    const char* callee = node->children[0].text;
+    if (strcmp(callee, "split") == 0) return take_array_value("__last_split_result");
+    if (strcmp(callee, "slice") == 0) return take_array_value("__last_slice_result");
+    if (strcmp(callee, "copy") == 0) return take_array_value("__last_copy_result");
+    return NULL;
+}
+
+// Shares the array held by variable node (no call, no operator) in O(1), else NULL
+static MycoArray* copy_array_variable(ASTNode* node) {
+    if (node->type != AST_EXPR || !node->text || node->child_count > 0) return NULL;
+    MycoArray* source = get_array_value(node->text);
+    return source ? array_copy(source) : NULL;
+}
+
+// Whether node is a call through an imported library alias (alias.fn(...))
+static int is_library_call(const ASTNode* node) {
+    if (!node->text || strcmp(node->text, "call") != 0 || node->child_count < 1) return 0;
+    const ASTNode* callee = &node->children[0];
+    if (callee->type != AST_DOT || callee->child_count < 1 || !callee->children[0].text) return 0;
+    return get_library_alias(callee->children[0].text) != NULL;
+}
+
+// String built by a library function (alias.fn(...) returning -1); owned here until taken
+static char* last_library_string = NULL;
+
+// Moves the pending library string out if node is the call that produced it, else NULL (caller frees)
+static char* take_library_string(ASTNode* node) {
+    if (!last_library_string) return NULL;
+    char* result = last_library_string;
+    last_library_string = NULL;
+    int produced_here = node && node == string_result_call;
+    string_result_call = NULL;
+    if (produced_here) return result;
+    // A -1 from any other expression is a number; the string was never picked up
+    tracked_free(result, __FILE__, __LINE__, "library_string_result");
+    return NULL;
+}
+
 // Cleanup function for function environment
 static void cleanup_func_env() {
     if (functions && functions_size > 0) {
@@ -4617,6 +5240,12 @@ static ASTNode* find_function_in_any_module(const char* name) {
     return NULL;
 }
 
+// Array passed to a user function: a fresh split()/slice()/copy() result is moved, a variable is shared
+static MycoArray* function_array_argument(ASTNode* node) {
+    MycoArray* array = take_direct_array_result(node);
+    return array ? array : copy_array_variable(node);
+}
+
 // Interpret a user-defined function call: evaluate args, bind params, execute body, capture return
 static long long eval_user_function_call(ASTNode* fn, ASTNode* args_node) {
     if (!fn) return 0;
@@ -4637,6 +5266,9 @@ static long long eval_user_function_call(ASTNode* fn, ASTNode* args_node) {
     }
     // evaluate arguments
     long long argvals[16]; int argn = 0;
+    double argfloats[16]; int argisfloat[16];
+    BigInt* argbigs[16] = { NULL };
+    MycoArray* argarrays[16] = { NULL };
     
     // Find the arguments container (should be the second child)
     if (args_node && args_node->child_count >= 2) {
@@ -4644,14 +5276,22 @@ static long long eval_user_function_call(ASTNode* fn, ASTNode* args_node) {
         if (args_container->text && strcmp(args_container->text, "args") == 0) {
             argn = args_container->child_count;
             for (int i = 0; i < argn && i < 16; i++) {
+                clear_float_result();
                 argvals[i] = eval_expression(&args_container->children[i]);
                 if (error_occurred) return 0;
+                argisfloat[i] = float_result_of(&args_container->children[i], &argfloats[i]);
+                argbigs[i] = big_result_of(&args_container->children[i]);
+                if (argvals[i] == -2) argarrays[i] = function_array_argument(&args_container->children[i]);
             }
         } else {
             argn = args_node->child_count;
             for (int i = 0; i < argn && i < 16; i++) {
+                clear_float_result();
                 argvals[i] = eval_expression(&args_node->children[i]);
                 if (error_occurred) return 0;
+                argisfloat[i] = float_result_of(&args_node->children[i], &argfloats[i]);
+                argbigs[i] = big_result_of(&args_node->children[i]);
+                if (argvals[i] == -2) argarrays[i] = function_array_argument(&args_node->children[i]);
             }
         }
     } else {
@@ -4663,6 +5303,7 @@ static long long eval_user_function_call(ASTNode* fn, ASTNode* args_node) {
     // bind params
     for (int i = 0; i < param_count && i < argn; i++) {
         const char* pname = fn->children[param_indices[i]].text;
+        int is_array = argarrays[i] != NULL;
         
         // Force parameter binding by always adding as new variable (don't update existing)
         // This ensures function parameters override global variables
@@ -4687,7 +5328,22 @@ static long long eval_user_function_call(ASTNode* fn, ASTNode* args_node) {
                 has_type = 1;
             }
             
-            if (has_type) {
+            if (is_array) {
+                // Array argument - the parameter owns a copy that shares the caller's buffer
+                var_env[var_env_size].type = VAR_TYPE_ARRAY;
+                var_env[var_env_size].number_value = 0;
+            } else if (argbigs[i]) {
+                // Big integer argument - the parameter takes ownership
+                var_env[var_env_size].type = VAR_TYPE_BIGINT;
+                var_env[var_env_size].big_value = argbigs[i];
+                var_env[var_env_size].number_value = 0;
+                argbigs[i] = NULL;
+            } else if (argisfloat[i]) {
+                // Float argument - bind the exact double
+                var_env[var_env_size].type = VAR_TYPE_FLOAT;
+                var_env[var_env_size].float_value = argfloats[i];
+                var_env[var_env_size].number_value = 0;
+            } else if (has_type) {
                 // Parameter has explicit type - use it
                 var_env[var_env_size].type = VAR_TYPE_NUMBER;  // For now, default to number
             var_env[var_env_size].number_value = argvals[i];
@@ -4697,16 +5353,24 @@ static long long eval_user_function_call(ASTNode* fn, ASTNode* args_node) {
                 var_env[var_env_size].number_value = argvals[i];
             }
             
-            var_env[var_env_size].array_value = NULL;
+            var_env[var_env_size].array_value = argarrays[i];
             var_env[var_env_size].string_value = NULL;
             var_env[var_env_size].object_value = NULL;
             var_env_size++;
+            argarrays[i] = NULL;
         }
         
         // Also bind as string for compatibility
-        char temp_str[64];
-        snprintf(temp_str, sizeof(temp_str), "%lld", argvals[i]);
-        set_str_value(pname, temp_str);
+        if (!is_array) {
+            char temp_str[64];
+            snprintf(temp_str, sizeof(temp_str), "%lld", argvals[i]);
+            set_str_value(pname, temp_str);
+        }
+    }
+    // Big and array arguments beyond the declared parameters
+    for (int i = 0; i < argn && i < 16; i++) {
+        if (argbigs[i]) bigint_free(argbigs[i]);
+        if (argarrays[i]) destroy_array(argarrays[i]);
     }
     // execute
 
@@ -4714,20 +5378,81 @@ static long long eval_user_function_call(ASTNode* fn, ASTNode* args_node) {
 
     
     int saved_return_flag = return_flag; long long saved_return_value = return_value;
-    return_flag = 0; return_value = 0;
+    int saved_return_is_float = return_is_float; double saved_return_float = return_float_value;
+    BigInt* saved_return_big = return_big_value;
+    return_flag = 0; return_value = 0; return_is_float = 0; return_big_value = NULL;
     
     eval_evaluate(&fn->children[body_index]);
     
     long long rv = return_value;
+    int rv_is_float = return_is_float;
+    double rv_float = return_float_value;
+    BigInt* rv_big = return_big_value;
     // restore return state
     return_flag = saved_return_flag; return_value = saved_return_value;
+    return_is_float = saved_return_is_float; return_float_value = saved_return_float;
+    return_big_value = saved_return_big;
     
     // Clean up function scope
     pop_scope();
     
+    // A float or big integer return value is reported against the call node
+    if (rv_big) return return_big_result(args_node, rv_big);
+    if (rv_is_float) return return_float_result(args_node, rv_float);
+    clear_float_result();
     return rv;
 }
 
+// Runs library function function_name of actual_library for the call node ast
+static long long dispatch_library_function(const char* actual_library, const char* function_name, ASTNode* ast) {
+    if (strcmp(actual_library, "math") == 0) {
+        clear_float_result();
+        long long math_result = call_math_function(function_name, &ast->children[1]);
+        // Float results (random draws) are reported against the argument list
+        double float_value;
+        if (float_result_of(&ast->children[1], &float_value)) return return_float_result(ast, float_value);
+        return math_result;
+    } else if (strcmp(actual_library, "util") == 0) {
+        return call_util_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "core") == 0) {
+        return call_core_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "file_io") == 0) {
+        return call_file_io_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "path_utils") == 0) {
+        return call_path_utils_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "env") == 0) {
+        return call_env_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "args") == 0) {
+        return call_args_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "process") == 0) {
+        return call_process_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "text_utils") == 0) {
+        clear_float_result();
+        long long text_result = call_text_utils_function(function_name, &ast->children[1]);
+        // Float results (parsed JSON numbers) are reported against the argument list
+        double float_value;
+        if (float_result_of(&ast->children[1], &float_value)) return return_float_result(ast, float_value);
+        return text_result;
+    } else if (strcmp(actual_library, "debug") == 0) {
+        return call_debug_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "types") == 0) {
+        return call_type_system_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "polish") == 0) {
+        return call_language_polish_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "test") == 0) {
+        return call_testing_framework_function(function_name, &ast->children[1]);
+    } else if (strcmp(actual_library, "data") == 0) {
+        clear_float_result();
+        long long data_result = call_data_structures_function(function_name, &ast->children[1]);
+        // Float results (matrix elements) are reported against the argument list
+        double float_value;
+        if (float_result_of(&ast->children[1], &float_value)) return return_float_result(ast, float_value);
+        return data_result;
+    }
+    
+    return 0;
+}
+
 long long eval_expression(ASTNode* ast) {
     if (!ast) {
                         return 0;
@@ -4774,13 +5499,18 @@ long long eval_expression(ASTNode* ast) {
         if (strchr(ast->text, '.') != NULL) {
             double float_val = strtod(ast->text, &endptr);
             if (*endptr == '\0') {
-                // Return scaled float for compatibility with integer return system
-                return (long long)(float_val * 1000000);
+                return return_float_result(ast, float_val);
             }
         } else {
             // Handle integer
+        errno = 0;
         long long num = strtoll(ast->text, &endptr, 10);
         if (*endptr == '\0') {
+            if (errno == ERANGE) {
+                // Literal beyond 64 bits
+                BigInt* big = bigint_from_string(ast->text, strlen(ast->text));
+                if (big) return return_big_result(ast, big);
+            }
             return num; // Return the numeric value
             }
         }
@@ -4797,10 +5527,56 @@ long long eval_expression(ASTNode* ast) {
         
         // Handle numeric operations
         if (ast->child_count >= 2) {
+            // Numbers and floats on both sides: typed evaluation without scaling or sentinels
+            NumericValue num;
+            if (eval_numeric(ast, &num)) return return_numeric_result(ast, &num);
+
+            clear_float_result();
             long long left = eval_expression(&ast->children[0]);
             if (error_occurred) return 0;
+            NumericValue left_num = { 0, left, 0.0, NULL };
+            left_num.is_float = float_result_of(&ast->children[0], &left_num.d);
+            left_num.big = big_result_of(&ast->children[0]);
+            clear_float_result();
             long long right = eval_expression(&ast->children[1]);
-            if (error_occurred) return 0;
+            if (error_occurred) {
+                if (left_num.big) bigint_free(left_num.big);
+                return 0;
+            }
+            NumericValue right_num = { 0, right, 0.0, NULL };
+            right_num.is_float = float_result_of(&ast->children[1], &right_num.d);
+            right_num.big = big_result_of(&ast->children[1]);
+            
+            // A float or big integer from a call or other compound operand, or a 64-bit
+            // overflow: finish in typed arithmetic
+            NumericOp op = numeric_operator(ast->text);
+            long long unused;
+            int typed = left_num.is_float || right_num.is_float || left_num.big || right_num.big ||
+                        (op == NUM_OP_ADD && checked_add(left, right, &unused)) ||
+                        (op == NUM_OP_SUB && checked_sub(left, right, &unused)) ||
+                        (op == NUM_OP_MUL && checked_mul(left, right, &unused));
+            int has_string = typed && (operand_is_string(&ast->children[0], left) || operand_is_string(&ast->children[1], right));
+            char* left_big_text = NULL;
+            char* right_big_text = NULL;
+            if (typed && !has_string) {
+                int ok = apply_numeric_operator(op, &left_num, &right_num, &num);
+                if (left_num.big) bigint_free(left_num.big);
+                if (right_num.big) bigint_free(right_num.big);
+                if (!ok) {
+                    set_error(op == NUM_OP_MOD ? ERROR_MODULO_BY_ZERO : ERROR_DIVISION_BY_ZERO);
+                    return 0;
+                }
+                return return_numeric_result(ast, &num);
+            }
+            // Big operands of a concatenation are rendered in decimal
+            if (left_num.big) {
+                if (op == NUM_OP_ADD) left_big_text = bigint_to_string(left_num.big, NULL);
+                bigint_free(left_num.big);
+            }
+            if (right_num.big) {
+                if (op == NUM_OP_ADD) right_big_text = bigint_to_string(right_num.big, NULL);
+                bigint_free(right_num.big);
+            }
             
             long long result = 0;
             if (strcmp(ast->text, "+") == 0) {
@@ -4829,6 +5605,14 @@ long long eval_expression(ASTNode* ast) {
                                 left_str[len - 2] = '\0';
                             }
                         }
+                    } else if (left_big_text) {
+                        left_str = left_big_text;
+                        left_big_text = NULL;
+                    } else if (left_num.is_float) {
+                        // Float operand - format the exact double, not its scaled integer
+                        char temp_str[64];
+                        format_float(temp_str, sizeof(temp_str), left_num.d);
+                        left_str = tracked_strdup(temp_str, __FILE__, __LINE__, "eval");
                     } else {
                         // Left operand is a number - convert to string
                         char temp_str[64];
@@ -4851,6 +5635,13 @@ long long eval_expression(ASTNode* ast) {
                                 right_str[len - 2] = '\0';
                             }
                         }
+                    } else if (right_big_text) {
+                        right_str = right_big_text;
+                        right_big_text = NULL;
+                    } else if (right_num.is_float) {
+                        char temp_str[64];
+                        format_float(temp_str, sizeof(temp_str), right_num.d);
+                        right_str = tracked_strdup(temp_str, __FILE__, __LINE__, "eval");
                     } else {
                         // Right operand is a number - convert to string
                         char temp_str[64];
@@ -4950,12 +5741,11 @@ long long eval_expression(ASTNode* ast) {
                     if (left_is_float || right_is_float) {
                         // Float arithmetic
                         double float_result = left_float + right_float;
-                        result = (long long)(float_result * 1000000);
-                        last_result_is_float = 1;
+                        return return_float_result(ast, float_result);
                     } else {
                         // Regular numeric addition
                         result = left + right;
-                        last_result_is_float = 0;
+                        clear_float_result();
                     }
                 }
             } else if (strcmp(ast->text, "-") == 0) {
@@ -5002,12 +5792,11 @@ long long eval_expression(ASTNode* ast) {
                 if (left_is_float || right_is_float) {
                     // Float arithmetic
                     double float_result = left_float - right_float;
-                    result = (long long)(float_result * 1000000);
-                    last_result_is_float = 1;
+                    return return_float_result(ast, float_result);
                 } else {
                     // Integer arithmetic
                     result = left - right;
-                    last_result_is_float = 0;
+                    clear_float_result();
                 }
             }
             else if (strcmp(ast->text, "*") == 0) {
@@ -5113,12 +5902,11 @@ long long eval_expression(ASTNode* ast) {
                 if (left_is_float || right_is_float) {
                     // Float arithmetic
                     double float_result = left_float * right_float;
-                    result = (long long)(float_result * 1000000);
-                    last_result_is_float = 1;
+                    return return_float_result(ast, float_result);
                 } else {
                     // Integer arithmetic
                     result = left * right;
-                    last_result_is_float = 0;
+                    clear_float_result();
                 }
             }
             else if (strcmp(ast->text, "/") == 0) {
@@ -5167,12 +5955,11 @@ long long eval_expression(ASTNode* ast) {
                 if (left_is_float || right_is_float) {
                     // Float arithmetic
                     double float_result = left_float / right_float;
-                    result = (long long)(float_result * 1000000);
-                    last_result_is_float = 1;
+                    return return_float_result(ast, float_result);
                 } else {
                     // Integer arithmetic
                     result = left / right;
-                    last_result_is_float = 0;
+                    clear_float_result();
                 }
             }
             else if (strcmp(ast->text, "%") == 0) {
@@ -5186,9 +5973,18 @@ long long eval_expression(ASTNode* ast) {
                     const char* left_str = NULL;
                     const char* right_str = NULL;
                     
+                    // A plain string variable compares by its own value rather than a shared
+                    // result slot, as long as the other side is a real string too
+                    // (comparisons against the -1 marker such as "x == -1" keep their meaning)
+                    const char* left_var = left == -1 ? string_variable_operand(&ast->children[0]) : NULL;
+                    const char* right_var = right == -1 ? string_variable_operand(&ast->children[1]) : NULL;
+                    if (left_var && right != 1 && !right_var) left_var = NULL;
+                    if (right_var && left != 1 && !left_var) right_var = NULL;
+                    
                     if (left == -1) {
                         // Left is a string result - check various string result variables
-                        left_str = get_str_value("__last_array_access_result");
+                        left_str = left_var;
+                        if (!left_str) left_str = get_str_value("__last_array_access_result");
                         if (!left_str) left_str = get_str_value("__last_concat_result");
                         if (!left_str) left_str = get_str_value("__last_replace_result");
                         if (!left_str) left_str = get_str_value("__last_trim_result");
@@ -5201,7 +5997,8 @@ long long eval_expression(ASTNode* ast) {
                     
                     if (right == -1) {
                         // Right is a string result - check various string result variables
-                        right_str = get_str_value("__last_array_access_result");
+                        right_str = right_var;
+                        if (!right_str) right_str = get_str_value("__last_array_access_result");
                         if (!right_str) right_str = get_str_value("__last_concat_result");
                         if (!right_str) right_str = get_str_value("__last_replace_result");
                         if (!right_str) right_str = get_str_value("__last_trim_result");
@@ -5346,9 +6143,15 @@ long long eval_expression(ASTNode* ast) {
         // Handle nested property access recursively
         // For obj.user.name, we need to resolve obj.user first, then get .name
         
+        // A plain identifier chain goes straight to the holder of the last key
+        int path_slot = -1;
+        MycoObject* path_holder = resolve_access_path(ast, &path_slot);
+        
         // First, evaluate the left side (could be an identifier or another dot expression)
         long long left_value = 0;
-        if (ast->children[0].type == AST_DOT) {
+        if (path_holder) {
+            left_value = (long long)path_holder;
+        } else if (ast->children[0].type == AST_DOT) {
             // This is a nested dot expression like obj.user.name
             // Recursively evaluate the left side first
             left_value = eval_expression(&ast->children[0]);
@@ -5395,16 +6198,26 @@ long long eval_expression(ASTNode* ast) {
             }
         }
         
-        // Get the property value
-        void* prop_value = object_get_property(obj, prop_name);
-        if (!prop_value) {
-            fprintf(stderr, "Error: Property '%s' not found in object at line %d\n", prop_name, ast->line);
-            return 0;
+        // Get the property value (numeric zero is stored as NULL, so check presence separately)
+        void* prop_value;
+        PropertyType prop_type;
+        if (path_holder) {
+            prop_value = obj->property_values[path_slot];
+            prop_type = obj->property_types[path_slot];
+        } else {
+            prop_value = object_get_property(obj, prop_name);
+            if (!prop_value && !object_has_property(obj, prop_name)) {
+                fprintf(stderr, "Error: Property '%s' not found in object at line %d\n", prop_name, ast->line);
+                return 0;
+            }
+            prop_type = object_get_property_type(obj, prop_name);
+        }
+        if (prop_type == PROP_TYPE_FLOAT) {
+            return return_float_result(ast, property_float_value(prop_value));
         }
         
         // Check if this is a method property
         // CRITICAL FIX: Check property type before string operations to prevent segfault
-        PropertyType prop_type = object_get_property_type(obj, prop_name);
         if (prop_type == PROP_TYPE_STRING && prop_value && strcmp((char*)prop_value, "method") == 0) {
             // This is a method - execute it
             
@@ -5581,8 +6394,16 @@ long long eval_expression(ASTNode* ast) {
         if (func_name) {
             ASTNode* lambda_func = get_lambda_value(func_name);
             if (lambda_func) {
-                // Call lambda function
-                return execute_lambda(lambda_func, &ast->children[1]);
+                // Call lambda function; a float body result is reported against the call node
+                clear_float_result();
+                long long result = execute_lambda(lambda_func, &ast->children[1]);
+                double float_value;
+                if (lambda_func->child_count >= 2) {
+                    BigInt* big = big_result_of(&lambda_func->children[1]);
+                    if (big) return return_big_result(ast, big);
+                    if (float_result_of(&lambda_func->children[1], &float_value)) return return_float_result(ast, float_value);
+                }
+                return result;
             }
         }
         
@@ -5639,38 +6460,11 @@ long long eval_expression(ASTNode* ast) {
             const char* actual_library = get_library_alias(library_name);
             if (actual_library) {
                 
-                // Now implement the actual function calls
-                if (strcmp(actual_library, "math") == 0) {
-                    return call_math_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "util") == 0) {
-                    return call_util_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "core") == 0) {
-                    return call_core_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "file_io") == 0) {
-                    return call_file_io_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "path_utils") == 0) {
-                    return call_path_utils_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "env") == 0) {
-                    return call_env_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "args") == 0) {
-                    return call_args_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "process") == 0) {
-                    return call_process_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "text_utils") == 0) {
-                    return call_text_utils_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "debug") == 0) {
-                    return call_debug_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "types") == 0) {
-                    return call_type_system_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "polish") == 0) {
-                    return call_language_polish_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "test") == 0) {
-                    return call_testing_framework_function(function_name, &ast->children[1]);
-                } else if (strcmp(actual_library, "data") == 0) {
-                    return call_data_structures_function(function_name, &ast->children[1]);
-                }
-                
-                return 0;
+                ASTNode* enclosing_call = library_call_node;
+                library_call_node = ast;
+                long long library_result = dispatch_library_function(actual_library, function_name, ast);
+                library_call_node = enclosing_call;
+                return library_result;
             } else {
                 fprintf(stderr, "Error: Alias '%s' not imported. Use 'use <library> as %s;' first\n", library_name, library_name);
                 return 0;
@@ -5819,15 +6613,17 @@ long long eval_expression(ASTNode* ast) {
                 MycoArray* array = get_array_value(array_name);
             
 
-                if (array) {
+                if (array && array_make_writable(array)) {
                     // Check if the value to add is a string literal BEFORE evaluating it
                     int is_string_literal_value = (ast->children[1].children[1].type == AST_EXPR && 
                                                  ast->children[1].children[1].text && 
                                                  is_string_literal(ast->children[1].children[1].text));
                     
                     // Evaluate the value to add
+                    clear_float_result();
                     long long value_to_add = eval_expression(&ast->children[1].children[1]);
                     if (error_occurred) return 0;
+                    if (array_element_rejected(&ast->children[1].children[1], "push()")) return 0;
                     
                     // Add the value to the array
                     if (is_string_literal_value) {
@@ -5952,10 +6748,10 @@ long long eval_expression(ASTNode* ast) {
                         set_str_value("__last_first_result", "");
                         set_str_value("__last_last_result", "");
                         set_str_value("__last_tostring_result", "");
-                        set_str_value("__last_pop_result", tracked_strdup(last_str, __FILE__, __LINE__, "pop_result"));
+                        set_str_value("__last_pop_result", last_str);
                         
                         // Remove the last element
-                        array->size--;
+                        array_pop(array);
                         return -1; // Indicate string result
                         }
                     } else {
@@ -5963,13 +6759,41 @@ long long eval_expression(ASTNode* ast) {
                         long long* last_num = (long long*)array_get(array, array->size - 1);
                         if (last_num) {
                             long long result = *last_num;
-                            array->size--;
+                            array_pop(array);
                             return result;
                         }
                     }
                 }
             }
             return 0;
+        } else if (func_name && (strcmp(func_name, "reserve") == 0 || strcmp(func_name, "shrink") == 0)) {
+            // reserve(array, n) - pre-size for n elements; shrink(array) - drop unused capacity.
+            // Both return the resulting capacity.
+            int is_reserve = strcmp(func_name, "reserve") == 0;
+            if (ast->child_count < 2 || ast->children[1].child_count < (is_reserve ? 2 : 1)) {
+                fprintf(stderr, "Error: %s() function requires %s\n", func_name,
+                        is_reserve ? "two arguments (array, capacity)" : "one argument");
+                return 0;
+            }
+            
+            ASTNode* array_node = &ast->children[1].children[0];
+            MycoArray* array = array_node->type == AST_EXPR && array_node->text ? get_array_value(array_node->text) : NULL;
+            if (!array) {
+                fprintf(stderr, "Error: First argument to %s() must be an array variable\n", func_name);
+                return 0;
+            }
+            
+            if (is_reserve) {
+                long long wanted = eval_expression(&ast->children[1].children[1]);
+                if (wanted < 0 || wanted > INT_MAX) {
+                    fprintf(stderr, "Error: reserve() capacity must be between 0 and %d\n", INT_MAX);
+                    return 0;
+                }
+                array_reserve(array, (int)wanted);
+            } else {
+                array_shrink_to_fit(array);
+            }
+            return array->capacity;
         } else if (func_name && strcmp(func_name, "slice") == 0) {
             // slice(array, start, end) - extract portion of array
             if (ast->child_count < 2 || ast->children[1].child_count < 3) {
@@ -5993,36 +6817,11 @@ long long eval_expression(ASTNode* ast) {
                 // Validate indices
                 if (start_idx < 0) start_idx = 0;
                 if (end_idx > source_array->size) end_idx = source_array->size;
-                if (start_idx >= end_idx) {
-                    // Return empty array
-                    MycoArray* result_array = create_array(1, source_array->is_string_array);
-                    set_array_value("__last_slice_result", result_array);
-                    return -2;
-                }
+                if (end_idx < start_idx) end_idx = start_idx;
                 
-                // Create new array with sliced elements
-                int slice_size = (int)(end_idx - start_idx);
-                MycoArray* result_array = create_array(slice_size, source_array->is_string_array);
-                
-                if (source_array->is_string_array) {
-                    // Copy string elements
-                    for (int i = 0; i < slice_size; i++) {
-                        const char* str_elem = array_get_string(source_array, (int)start_idx + i);
-                        if (str_elem) {
-                            array_push(result_array, tracked_strdup(str_elem, __FILE__, __LINE__, "array_push_string_element"));
-                        }
-                    }
-                        } else {
-                    // Copy numeric elements
-                    for (int i = 0; i < slice_size; i++) {
-                        long long* num_elem = (long long*)array_get(source_array, (int)start_idx + i);
-                        if (num_elem) {
-                            long long* new_elem = (long long*)tracked_malloc(sizeof(long long), __FILE__, __LINE__, "slice_element");
-                            *new_elem = *num_elem;
-                            array_push(result_array, new_elem);
-                        }
-                    }
-                }
+                // A view sharing the source's buffer: O(1) however long the range
+                MycoArray* result_array = array_view(source_array, (int)start_idx, (int)(end_idx - start_idx));
+                if (!result_array) return 0;
                 
                 // Store result and return array indicator
                 set_array_value("__last_slice_result", result_array);
@@ -6033,90 +6832,28 @@ long long eval_expression(ASTNode* ast) {
             // join(array, separator) - join array elements with separator
             if (ast->child_count < 2 || ast->children[1].child_count < 2) {
                 fprintf(stderr, "Error: join() function requires two arguments\n");
-                            return 0;
-                        }
+                return 0;
+            }
             
             // Get array argument
             ASTNode* array_node = &ast->children[1].children[0];
             if (array_node->type == AST_EXPR && array_node->text) {
-                const char* array_name = array_node->text;
-                MycoArray* source_array = get_array_value(array_name);
+                MycoArray* source_array = get_array_value(array_node->text);
                 if (!source_array || source_array->size == 0) {
                     // Return empty string for empty array
                     set_str_value("__last_join_result", "");
                     return -1;
                 }
                 
-                // Get separator
-                long long sep_result = eval_expression(&ast->children[1].children[1]);
-                const char* separator = "";
-                if (sep_result == 1) {
-                    // String literal separator
-                    ASTNode* sep_node = &ast->children[1].children[1];
-                    if (sep_node->text && is_string_literal(sep_node->text)) {
-                        size_t len = strlen(sep_node->text);
-                        if (len >= 2) {
-                            char* temp_sep = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "join_separator");
-                            strncpy(temp_sep, sep_node->text + 1, len - 2);
-                            temp_sep[len - 2] = '\0';
-                            separator = temp_sep;
-                        }
-                    }
-                } else if (sep_result == -1) {
-                    // String variable separator
-                    ASTNode* sep_node = &ast->children[1].children[1];
-                    if (sep_node->text) {
-                        const char* sep_var = get_str_value(sep_node->text);
-                        if (sep_var) {
-                            separator = sep_var;
-                        }
-                    }
-                }
-                
-                // Calculate total length needed
-                size_t total_length = 0;
-                size_t sep_len = strlen(separator);
-                
-                for (int i = 0; i < source_array->size; i++) {
-                    if (source_array->is_string_array) {
-                        const char* str_elem = array_get_string(source_array, i);
-                        if (str_elem) {
-                            total_length += strlen(str_elem);
-                        }
-                    } else {
-                        // Convert number to string (estimate 20 chars per number)
-                        total_length += 20;
-                    }
-                    if (i < source_array->size - 1) {
-                        total_length += sep_len;
-                    }
-                }
-                
-                // Build the joined string
-                char* result = (char*)tracked_malloc(total_length + 1, __FILE__, __LINE__, "join_result");
-                result[0] = '\0';
-                
-                for (int i = 0; i < source_array->size; i++) {
-                    if (source_array->is_string_array) {
-                        const char* str_elem = array_get_string(source_array, i);
-                        if (str_elem) {
-                            strcat(result, str_elem);
-                        }
-                    } else {
-                        long long* num_elem = (long long*)array_get(source_array, i);
-                        if (num_elem) {
-                            char num_str[32];
-                            snprintf(num_str, sizeof(num_str), "%lld", *num_elem);
-                            strcat(result, num_str);
-                        }
-                    }
-                    if (i < source_array->size - 1) {
-                        strcat(result, separator);
-                    }
-                }
+                // Get separator (literal or string variable, used in place)
+                size_t sep_len = 0;
+                const char* separator = string_argument_view(&ast->children[1].children[1], &sep_len);
+                if (!separator) sep_len = 0;
                 
-                // Store result and return string indicator
-                set_str_value("__last_join_result", result);
+                // Exact-size join in one copy pass
+                char* result = string_join(source_array, separator, sep_len, NULL);
+                set_str_value("__last_join_result", result ? result : "");
+                if (result) tracked_free(result, __FILE__, __LINE__, "join_result");
                 return -1;
             }
             return 0;
@@ -6127,6 +6864,27 @@ long long eval_expression(ASTNode* ast) {
                 return 0;
             }
             
+            // Source and delimiter are read in place (literal text or string variable)
+            size_t source_len = 0;
+            const char* source_string = string_argument_view(&ast->children[1].children[0], &source_len);
+            size_t delim_len = 0;
+            const char* delimiter = string_argument_view(&ast->children[1].children[1], &delim_len);
+            if (!delimiter) delim_len = 0;
+            
+            MycoArray* result_array = source_string ?
+                string_split(source_string, source_len, delimiter, delim_len) :
+                create_array(1, 1);
+            
+            // Store result and return array indicator
+            set_array_value("__last_split_result", result_array);
+            return -2;
+        } else if (func_name && strcmp(func_name, "trim") == 0) {
+            // trim(string) - remove whitespace from beginning and end
+            if (ast->child_count < 2 || ast->children[1].child_count < 1) {
+                fprintf(stderr, "Error: trim() function requires one argument\n");
+                return 0;
+            }
+            
             // Get string argument
             ASTNode* string_node = &ast->children[1].children[0];
             const char* source_string = NULL;
@@ -6138,7 +6896,7 @@ long long eval_expression(ASTNode* ast) {
                     if (is_string_literal(string_node->text)) {
                         size_t len = strlen(string_node->text);
                         if (len >= 2) {
-                            char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "split_string");
+                            char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "trim_string");
                             strncpy(temp_str, string_node->text + 1, len - 2);
                             temp_str[len - 2] = '\0';
                             source_string = temp_str;
@@ -6154,107 +6912,14 @@ long long eval_expression(ASTNode* ast) {
             }
             
             if (!source_string) {
-                // Return empty array
-                MycoArray* result_array = create_array(1, 1); // string array
-                set_array_value("__last_split_result", result_array);
-                return -2;
+                // Return empty string
+                set_str_value("__last_trim_result", "");
+                return -1;
             }
             
-            // Get delimiter
-            ASTNode* delim_node = &ast->children[1].children[1];
-            const char* delimiter = "";
-            long long delim_result = eval_expression(delim_node);
-            
-            if (delim_result == 1) {
-                // String literal delimiter
-                if (delim_node->text && is_string_literal(delim_node->text)) {
-                    size_t len = strlen(delim_node->text);
-                    if (len >= 2) {
-                        char* temp_delim = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "split_delimiter");
-                        strncpy(temp_delim, delim_node->text + 1, len - 2);
-                        temp_delim[len - 2] = '\0';
-                        delimiter = temp_delim;
-                    }
-                }
-            } else if (delim_result == -1) {
-                // String variable delimiter
-                const char* delim_var = get_str_value(delim_node->text);
-                if (delim_var) {
-                    delimiter = delim_var;
-                }
-            }
-            
-            // Perform the split
-            MycoArray* result_array = create_array(1, 1); // string array
-            
-            if (strlen(delimiter) == 0) {
-                // Empty delimiter - split into individual characters
-                size_t str_len = strlen(source_string);
-                for (size_t i = 0; i < str_len; i++) {
-                    char* char_str = (char*)tracked_malloc(2, __FILE__, __LINE__, "split_char");
-                    char_str[0] = source_string[i];
-                    char_str[1] = '\0';
-                    array_push(result_array, char_str);
-                }
-            } else {
-                // Split by delimiter
-                char* str_copy = tracked_strdup(source_string, __FILE__, __LINE__, "eval");
-                char* saveptr;
-                char* token = strtok_r(str_copy, delimiter, &saveptr);
-                
-                while (token != NULL) {
-                    array_push(result_array, tracked_strdup(token, __FILE__, __LINE__, "array_push_split_token"));
-                    token = strtok_r(NULL, delimiter, &saveptr);
-                }
-                
-                tracked_free(str_copy, __FILE__, __LINE__, "split_string_copy");
-            }
-            
-            // Store result and return array indicator
-            set_array_value("__last_split_result", result_array);
-            return -2;
-        } else if (func_name && strcmp(func_name, "trim") == 0) {
-            // trim(string) - remove whitespace from beginning and end
-            if (ast->child_count < 2 || ast->children[1].child_count < 1) {
-                fprintf(stderr, "Error: trim() function requires one argument\n");
-                return 0;
-            }
-            
-            // Get string argument
-            ASTNode* string_node = &ast->children[1].children[0];
-            const char* source_string = NULL;
-            
-            if (string_node->type == AST_EXPR && string_node->text) {
-                long long str_result = eval_expression(string_node);
-                if (str_result == 1) {
-                    // String literal
-                    if (is_string_literal(string_node->text)) {
-                        size_t len = strlen(string_node->text);
-                        if (len >= 2) {
-                            char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "trim_string");
-                            strncpy(temp_str, string_node->text + 1, len - 2);
-                            temp_str[len - 2] = '\0';
-                            source_string = temp_str;
-                        }
-                    }
-                } else if (str_result == -1) {
-                    // String variable
-                    const char* str_var = get_str_value(string_node->text);
-                    if (str_var) {
-                        source_string = str_var;
-                    }
-                }
-            }
-            
-            if (!source_string) {
-                // Return empty string
-                set_str_value("__last_trim_result", "");
-                return -1;
-            }
-            
-            // Trim whitespace
-            const char* start = source_string;
-            const char* end = source_string + strlen(source_string) - 1;
+            // Trim whitespace
+            const char* start = source_string;
+            const char* end = source_string + strlen(source_string) - 1;
             
             // Skip leading whitespace
             while (*start && (*start == ' ' || *start == '\t' || *start == '\n' || *start == '\r')) {
@@ -6282,137 +6947,23 @@ long long eval_expression(ASTNode* ast) {
                 return 0;
             }
             
-            // Get string argument
-            ASTNode* string_node = &ast->children[1].children[0];
-            const char* source_string = NULL;
-            
-            if (string_node->type == AST_EXPR && string_node->text) {
-                long long str_result = eval_expression(string_node);
-                if (str_result == 1) {
-                    // String literal
-                    if (is_string_literal(string_node->text)) {
-                        size_t len = strlen(string_node->text);
-                        if (len >= 2) {
-                            char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "replace_string");
-                            strncpy(temp_str, string_node->text + 1, len - 2);
-                            temp_str[len - 2] = '\0';
-                            source_string = temp_str;
-                        }
-                    }
-                } else if (str_result == -1) {
-                    // String variable
-                    const char* str_var = get_str_value(string_node->text);
-                    if (str_var) {
-                        source_string = str_var;
-                    }
-                }
-            }
+            // All three arguments are read in place (literal text or string variable)
+            size_t source_len = 0, old_len = 0, new_len = 0;
+            const char* source_string = string_argument_view(&ast->children[1].children[0], &source_len);
+            const char* old_string = string_argument_view(&ast->children[1].children[1], &old_len);
+            const char* new_string = string_argument_view(&ast->children[1].children[2], &new_len);
             
             if (!source_string) {
                 set_str_value("__last_replace_result", "");
                 return -1;
             }
+            if (!old_string) old_len = 0;
+            if (!new_string) new_len = 0;
             
-            // Get old string argument
-            ASTNode* old_node = &ast->children[1].children[1];
-            const char* old_string = "";
-            long long old_result = eval_expression(old_node);
-            
-            if (old_result == 1) {
-                // String literal
-                if (old_node->text && is_string_literal(old_node->text)) {
-                    size_t len = strlen(old_node->text);
-                    if (len >= 2) {
-                        char* temp_old = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "replace_old");
-                        strncpy(temp_old, old_node->text + 1, len - 2);
-                        temp_old[len - 2] = '\0';
-                        old_string = temp_old;
-                    }
-                }
-            } else if (old_result == -1) {
-                // String variable
-                const char* old_var = get_str_value(old_node->text);
-                if (old_var) {
-                    old_string = old_var;
-                }
-            }
-            
-            // Get new string argument
-            ASTNode* new_node = &ast->children[1].children[2];
-            const char* new_string = "";
-            long long new_result = eval_expression(new_node);
-            
-            if (new_result == 1) {
-                // String literal
-                if (new_node->text && is_string_literal(new_node->text)) {
-                    size_t len = strlen(new_node->text);
-                    if (len >= 2) {
-                        char* temp_new = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "replace_new");
-                        strncpy(temp_new, new_node->text + 1, len - 2);
-                        temp_new[len - 2] = '\0';
-                        new_string = temp_new;
-                    }
-                }
-            } else if (new_result == -1) {
-                // String variable
-                const char* new_var = get_str_value(new_node->text);
-                if (new_var) {
-                    new_string = new_var;
-                }
-            }
-            
-            // Perform the replacement
-            if (strlen(old_string) == 0) {
-                // Can't replace empty string, return original
-                set_str_value("__last_replace_result", tracked_strdup(source_string, __FILE__, __LINE__, "replace_result"));
-                return -1;
-            }
-            
-            // Count occurrences to determine result size
-            const char* pos = source_string;
-            int count = 0;
-            size_t old_len = strlen(old_string);
-            size_t new_len = strlen(new_string);
-            
-            while ((pos = strstr(pos, old_string)) != NULL) {
-                count++;
-                pos += old_len;
-            }
-            
-            if (count == 0) {
-                // No replacements needed
-                set_str_value("__last_replace_result", tracked_strdup(source_string, __FILE__, __LINE__, "replace_result"));
-                return -1;
-            }
-            
-            // Calculate result size
-            size_t source_len = strlen(source_string);
-            size_t result_len = source_len - (count * old_len) + (count * new_len);
-            char* result = (char*)tracked_malloc(result_len + 1, __FILE__, __LINE__, "replace_result");
-            
-            // Perform replacements
-            const char* src_pos = source_string;
-            char* dest_pos = result;
-            
-            while ((pos = strstr(src_pos, old_string)) != NULL) {
-                // Copy part before the match
-                size_t prefix_len = pos - src_pos;
-                strncpy(dest_pos, src_pos, prefix_len);
-                dest_pos += prefix_len;
-                
-                // Copy the replacement
-                strcpy(dest_pos, new_string);
-                dest_pos += new_len;
-                
-                // Move past the old string
-                src_pos = pos + old_len;
-            }
-            
-            // Copy remaining part
-            strcpy(dest_pos, src_pos);
-            
-            // Store result and return string indicator
-            set_str_value("__last_replace_result", result);
+            // Count matches, allocate the exact result size, then copy once
+            char* result = string_replace_all(source_string, source_len, old_string, old_len, new_string, new_len, NULL);
+            set_str_value("__last_replace_result", result ? result : "");
+            if (result) tracked_free(result, __FILE__, __LINE__, "replace_result");
             return -1;
         } else if (func_name && strcmp(func_name, "object_keys") == 0) {
             // object_keys(obj) - return array of property names
@@ -6832,7 +7383,7 @@ long long eval_expression(ASTNode* ast) {
                         }
                     }
                     
-                    if (index != -1) {
+                    if (index != -1 && object_detach_shape(obj)) {
                         // Free memory for removed property name
                         tracked_free(obj->property_names[index], __FILE__, __LINE__, "remove_property_name");
                         
@@ -6840,6 +7391,7 @@ long long eval_expression(ASTNode* ast) {
                         for (int i = index; i < obj->property_count - 1; i++) {
                             obj->property_names[i] = obj->property_names[i + 1];
                             obj->property_values[i] = obj->property_values[i + 1];
+                            obj->property_types[i] = obj->property_types[i + 1];
                         }
                         
                         // Update count
@@ -7008,7 +7560,7 @@ long long eval_expression(ASTNode* ast) {
                 ASTNode* lambda_func = get_lambda_value(operation_node->text);
                 if (lambda_func) {
                     // Lambda-based mapping
-                    MycoArray* result = create_array(10, 0); // numeric array for lambda results
+                    MycoArray* result = create_array(array->size, 0); // numeric array for lambda results
                     if (!result) {
                         fprintf(stderr, "Error: Failed to create result array\n");
                         return 0;
@@ -7038,7 +7590,12 @@ long long eval_expression(ASTNode* ast) {
                                 set_var_value(param_name, elem_value);
                                 
                                 // Execute lambda body
+                                clear_float_result();
                                 long long lambda_result = eval_expression(&lambda_func->children[1]);
+                                if (array_element_rejected(&lambda_func->children[1], "map()")) {
+                                    destroy_array(result);
+                                    return 0;
+                                }
                                 
                                 // Store the lambda result
                                 array_push(result, &lambda_result);
@@ -7048,7 +7605,12 @@ long long eval_expression(ASTNode* ast) {
                                 set_var_value(param_name, elem_value);
                                 
                                 // Execute lambda body
+                                clear_float_result();
                                 long long lambda_result = eval_expression(&lambda_func->children[1]);
+                                if (array_element_rejected(&lambda_func->children[1], "map()")) {
+                                    destroy_array(result);
+                                    return 0;
+                                }
                                 
                                 // Store the lambda result
                                 array_push(result, &lambda_result);
@@ -7067,7 +7629,7 @@ long long eval_expression(ASTNode* ast) {
             if (error_occurred) return 0;
             
             // Create result array (always numeric for mathematical operations)
-            MycoArray* result = create_array(10, 0); // numeric array
+            MycoArray* result = create_array(array->size, 0); // numeric array
             if (!result) {
                 fprintf(stderr, "Error: Failed to create result array\n");
                 return 0;
@@ -7220,12 +7782,21 @@ long long eval_expression(ASTNode* ast) {
                 return 0;
             }
             
+            clear_float_result();
             long long value = eval_expression(&ast->children[1].children[0]);
             // to_string - input value: %lld\n", value);
             if (error_occurred) return 0;
+            double float_value;
+            int is_float = float_result_of(&ast->children[1].children[0], &float_value);
             
             char* result_str = NULL;
-            if (value == -1) {
+            if (is_float) {
+                // Float - format the exact double, not its scaled integer
+                result_str = tracked_malloc(FLOAT_TEXT_SIZE, __FILE__, __LINE__, "eval");
+                if (result_str) {
+                    format_float(result_str, FLOAT_TEXT_SIZE, float_value);
+                }
+            } else if (value == -1) {
                 // Already a string - get its value
                 ASTNode* arg_node = &ast->children[1].children[0];
                 if (arg_node->type == AST_EXPR && arg_node->text) {
@@ -7381,7 +7952,7 @@ long long eval_expression(ASTNode* ast) {
                 }
                 
                 MycoArray* array = get_array_value(array_name);
-                if (array && array->size > 1) {
+                if (array && array->size > 1 && array_make_writable(array)) {
                     // Reverse the array in place
                     if (array->is_string_array) {
                         // For string arrays, reverse string elements
@@ -7475,36 +8046,17 @@ long long eval_expression(ASTNode* ast) {
             return -999999999; // Special value to represent NaN
         }
         
-        // Basic mathematical functions
+        // Basic mathematical functions (float arguments stay doubles, see eval_numeric_argument)
         else if (func_name && strcmp(func_name, "abs") == 0) {
             if (ast->child_count < 2 || ast->children[1].child_count < 1) {
                 fprintf(stderr, "Error: abs() function requires one argument\n");
                 return 0;
             }
-            
-            // Check if the argument is a float literal
-            ASTNode* arg = &ast->children[1].children[0];
-            if (arg->text && strchr(arg->text, '.') != NULL) {
-                // Float literal
-                double float_val = strtod(arg->text, NULL);
-                double result = fabs(float_val);
-                last_result_is_float = 1;
-                return (long long)(result * 1000000);
-            } else if (arg->text) {
-                // Check if it's a float variable
-                for (int i = var_env_size - 1; i >= 0; i--) {
-                    if (var_env[i].name && strcmp(var_env[i].name, arg->text) == 0 && var_env[i].type == VAR_TYPE_FLOAT) {
-                        double result = fabs(var_env[i].float_value);
-                        last_result_is_float = 1;
-                        return (long long)(result * 1000000);
-                    }
-                }
-            }
-            
-            // Handle as integer
-            long long value = eval_expression(arg);
-            last_result_is_float = 0;
-            return value < 0 ? -value : value;
+            NumericValue arg;
+            if (!eval_numeric_argument(&ast->children[1].children[0], &arg)) return 0;
+            if (arg.is_float) return return_float_result(ast, fabs(arg.d));
+            clear_float_result();
+            return arg.i < 0 ? (long long)(0ULL - (unsigned long long)arg.i) : arg.i;
         }
         
         else if (func_name && strcmp(func_name, "pow") == 0) {
@@ -7512,76 +8064,23 @@ long long eval_expression(ASTNode* ast) {
                 fprintf(stderr, "Error: pow() function requires two arguments\n");
                 return 0;
             }
+            NumericValue base, exponent;
+            if (!eval_numeric_argument(&ast->children[1].children[0], &base) ||
+                !eval_numeric_argument(&ast->children[1].children[1], &exponent)) return 0;
             
-            // Check if either argument is a float
-            ASTNode* base_arg = &ast->children[1].children[0];
-            ASTNode* exp_arg = &ast->children[1].children[1];
-            
-            double base_val = 0.0, exp_val = 0.0;
-            int base_is_float = 0, exp_is_float = 0;
-            
-            // Check base argument
-            if (base_arg->text && strchr(base_arg->text, '.') != NULL) {
-                base_is_float = 1;
-                base_val = strtod(base_arg->text, NULL);
-            } else if (base_arg->text) {
-                for (int i = var_env_size - 1; i >= 0; i--) {
-                    if (var_env[i].name && strcmp(var_env[i].name, base_arg->text) == 0 && var_env[i].type == VAR_TYPE_FLOAT) {
-                        base_is_float = 1;
-                        base_val = var_env[i].float_value;
-                        break;
-                    }
-                }
-                if (!base_is_float) {
-                    long long base_int = eval_expression(base_arg);
-                    base_val = (double)base_int;
-                }
-            } else {
-                long long base_int = eval_expression(base_arg);
-                base_val = (double)base_int;
-            }
-            
-            // Check exponent argument
-            if (exp_arg->text && strchr(exp_arg->text, '.') != NULL) {
-                exp_is_float = 1;
-                exp_val = strtod(exp_arg->text, NULL);
-            } else if (exp_arg->text) {
-                for (int i = var_env_size - 1; i >= 0; i--) {
-                    if (var_env[i].name && strcmp(var_env[i].name, exp_arg->text) == 0 && var_env[i].type == VAR_TYPE_FLOAT) {
-                        exp_is_float = 1;
-                        exp_val = var_env[i].float_value;
-                        break;
-                    }
-                }
-                if (!exp_is_float) {
-                    long long exp_int = eval_expression(exp_arg);
-                    exp_val = (double)exp_int;
-                }
-            } else {
-                long long exp_int = eval_expression(exp_arg);
-                exp_val = (double)exp_int;
+            if (base.is_float || exponent.is_float) {
+                double x = base.is_float ? base.d : (double)base.i;
+                double y = exponent.is_float ? exponent.d : (double)exponent.i;
+                return return_float_result(ast, pow(x, y));
             }
-            
-            if (base_is_float || exp_is_float) {
-                // Use floating-point pow function
-                double result = pow(base_val, exp_val);
-                last_result_is_float = 1;
-                return (long long)(result * 1000000);
-            } else {
-                // Integer-only operation (original logic)
-                long long base = (long long)base_val;
-                long long exponent = (long long)exp_val;
-                if (exponent < 0) {
-                    fprintf(stderr, "Error: pow() with negative exponent not yet supported for integers\n");
-                    return 0;
-                }
-                long long result = 1;
-                for (int i = 0; i < exponent; i++) {
-                    result *= base;
-                }
-                last_result_is_float = 0;
-                return result;
+            if (exponent.i < 0) {
+                fprintf(stderr, "Error: pow() with negative exponent not yet supported for integers\n");
+                return 0;
             }
+            long long result;
+            array_kernel_pow(&result, &base.i, 1, exponent.i);
+            clear_float_result();
+            return result;
         }
         
         else if (func_name && strcmp(func_name, "sqrt") == 0) {
@@ -7589,206 +8088,68 @@ long long eval_expression(ASTNode* ast) {
                 fprintf(stderr, "Error: sqrt() function requires one argument\n");
                 return 0;
             }
-            
-            // Check if the argument is a float literal or variable
-            ASTNode* arg = &ast->children[1].children[0];
-            if (arg->text && strchr(arg->text, '.') != NULL) {
-                // Float literal
-                double float_val = strtod(arg->text, NULL);
-                if (float_val < 0) {
-                    fprintf(stderr, "Error: sqrt() of negative number not supported\n");
-                    return 0;
-                }
-                double result = sqrt(float_val);
-                last_result_is_float = 1;
-                return (long long)(result * 1000000);
-            } else if (arg->text) {
-                // Check if it's a float variable
-                for (int i = var_env_size - 1; i >= 0; i--) {
-                    if (var_env[i].name && strcmp(var_env[i].name, arg->text) == 0 && var_env[i].type == VAR_TYPE_FLOAT) {
-                        if (var_env[i].float_value < 0) {
-                            fprintf(stderr, "Error: sqrt() of negative number not supported\n");
-                            return 0;
-                        }
-                        double result = sqrt(var_env[i].float_value);
-                        last_result_is_float = 1;
-                        return (long long)(result * 1000000);
-                    }
-                }
-            }
-            
-            // Handle as integer
-            long long value = eval_expression(arg);
-            if (value < 0) {
+            NumericValue arg;
+            if (!eval_numeric_argument(&ast->children[1].children[0], &arg)) return 0;
+            if ((arg.is_float && arg.d < 0) || (!arg.is_float && arg.i < 0)) {
                 fprintf(stderr, "Error: sqrt() of negative number not supported\n");
                 return 0;
             }
-            // Simple integer square root approximation
-            long long result = 0;
-            while (result * result <= value) {
-                result++;
-            }
-            last_result_is_float = 0;
-            return result - 1;
-        }
-        
-        else if (func_name && strcmp(func_name, "floor") == 0) {
-            if (ast->child_count < 2 || ast->children[1].child_count < 1) {
-                fprintf(stderr, "Error: floor() function requires one argument\n");
-                return 0;
-            }
-            long long value = eval_expression(&ast->children[1].children[0]);
-            return value; // For integers, floor is the same as the value
-        }
-        
-        else if (func_name && strcmp(func_name, "ceil") == 0) {
-            if (ast->child_count < 2 || ast->children[1].child_count < 1) {
-                fprintf(stderr, "Error: ceil() function requires one argument\n");
-                return 0;
-            }
-            long long value = eval_expression(&ast->children[1].children[0]);
-            return value; // For integers, ceil is the same as the value
+            if (arg.is_float) return return_float_result(ast, sqrt(arg.d));
+            // Integer square root (floor), exact for the whole long long range
+            long long result;
+            array_kernel_sqrt(&result, &arg.i, 1);
+            clear_float_result();
+            return result;
         }
         
-        else if (func_name && strcmp(func_name, "min") == 0) {
-    
+        else if (func_name && (strcmp(func_name, "floor") == 0 || strcmp(func_name, "ceil") == 0)) {
             if (ast->child_count < 2 || ast->children[1].child_count < 1) {
-                fprintf(stderr, "Error: min() function requires at least one argument\n");
+                fprintf(stderr, "Error: %s() function requires one argument\n", func_name);
                 return 0;
             }
-            
-            // Check if any argument is a float
-            int any_float = 0;
-            for (int i = 0; i < ast->children[1].child_count; i++) {
-                ASTNode* arg = &ast->children[1].children[i];
-                if (arg->text && strchr(arg->text, '.') != NULL) {
-                    any_float = 1;
-                    break;
-                } else if (arg->text) {
-                    for (int j = var_env_size - 1; j >= 0; j--) {
-                        if (var_env[j].name && strcmp(var_env[j].name, arg->text) == 0 && var_env[j].type == VAR_TYPE_FLOAT) {
-                            any_float = 1;
-                            break;
-                        }
-                    }
-                    if (any_float) break;
-                }
-            }
-            
-            if (any_float) {
-                // Float comparison
-                double min_val = DBL_MAX;
-                for (int i = 0; i < ast->children[1].child_count; i++) {
-                    ASTNode* arg = &ast->children[1].children[i];
-                    double val = 0.0;
-                    
-                    if (arg->text && strchr(arg->text, '.') != NULL) {
-                        val = strtod(arg->text, NULL);
-                    } else if (arg->text) {
-                        int found_float = 0;
-                        for (int j = var_env_size - 1; j >= 0; j--) {
-                            if (var_env[j].name && strcmp(var_env[j].name, arg->text) == 0 && var_env[j].type == VAR_TYPE_FLOAT) {
-                                val = var_env[j].float_value;
-                                found_float = 1;
-                                break;
-                            }
-                        }
-                        if (!found_float) {
-                            long long int_val = eval_expression(arg);
-                            val = (double)int_val;
-                        }
-            } else {
-                        long long int_val = eval_expression(arg);
-                        val = (double)int_val;
-                    }
-                    
-                    if (i == 0 || val < min_val) {
-                        min_val = val;
-                    }
-                }
-                last_result_is_float = 1;
-                return (long long)(min_val * 1000000);
-            } else {
-                // Integer comparison
-                long long min_val = eval_expression(&ast->children[1].children[0]);
-                for (int i = 1; i < ast->children[1].child_count; i++) {
-                    long long val = eval_expression(&ast->children[1].children[i]);
-                    
-                    if (val < min_val) min_val = val;
-                }
-
-                last_result_is_float = 0;
-                return min_val;
-            }
+            NumericValue arg;
+            if (!eval_numeric_argument(&ast->children[1].children[0], &arg)) return 0;
+            clear_float_result();
+            if (!arg.is_float) return arg.i; // Integers are already whole
+            double rounded = func_name[0] == 'f' ? floor(arg.d) : ceil(arg.d);
+            if (rounded != rounded) return 0;
+            if (rounded >= 9.2e18) return LLONG_MAX;
+            if (rounded <= -9.2e18) return LLONG_MIN;
+            return (long long)rounded;
         }
         
-        else if (func_name && strcmp(func_name, "max") == 0) {
+        else if (func_name && (strcmp(func_name, "min") == 0 || strcmp(func_name, "max") == 0)) {
             if (ast->child_count < 2 || ast->children[1].child_count < 1) {
-                fprintf(stderr, "Error: max() function requires at least one argument\n");
+                fprintf(stderr, "Error: %s() function requires at least one argument\n", func_name);
                 return 0;
             }
-            
-            // Check if any argument is a float
+            int want_min = func_name[1] == 'i';
+            NumericValue best;
             int any_float = 0;
+            double best_float = 0.0;
             for (int i = 0; i < ast->children[1].child_count; i++) {
-                ASTNode* arg = &ast->children[1].children[i];
-                if (arg->text && strchr(arg->text, '.') != NULL) {
-                    any_float = 1;
-                    break;
-                } else if (arg->text) {
-                    for (int j = var_env_size - 1; j >= 0; j--) {
-                        if (var_env[j].name && strcmp(var_env[j].name, arg->text) == 0 && var_env[j].type == VAR_TYPE_FLOAT) {
-                            any_float = 1;
-                            break;
-                        }
-                    }
-                    if (any_float) break;
-                }
-            }
-            
-            if (any_float) {
-                // Float comparison
-                double max_val = -DBL_MAX;
-                for (int i = 0; i < ast->children[1].child_count; i++) {
-                    ASTNode* arg = &ast->children[1].children[i];
-                    double val = 0.0;
-                    
-                    if (arg->text && strchr(arg->text, '.') != NULL) {
-                        val = strtod(arg->text, NULL);
-                    } else if (arg->text) {
-                        int found_float = 0;
-                        for (int j = var_env_size - 1; j >= 0; j--) {
-                            if (var_env[j].name && strcmp(var_env[j].name, arg->text) == 0 && var_env[j].type == VAR_TYPE_FLOAT) {
-                                val = var_env[j].float_value;
-                                found_float = 1;
-                                break;
-                            }
-                        }
-                        if (!found_float) {
-                            long long int_val = eval_expression(arg);
-                            val = (double)int_val;
-                        }
-                    } else {
-                        long long int_val = eval_expression(arg);
-                        val = (double)int_val;
+                NumericValue arg;
+                if (!eval_numeric_argument(&ast->children[1].children[i], &arg)) return 0;
+                double as_float = arg.is_float ? arg.d : (double)arg.i;
+                if (arg.is_float) any_float = 1;
+                if (i == 0) {
+                    best = arg;
+                    best_float = as_float;
+                } else if (!arg.is_float && !best.is_float) {
+                    // Both integers: compare exactly
+                    if (want_min ? arg.i < best.i : arg.i > best.i) {
+                        best = arg;
+                        best_float = as_float;
                     }
-                    
-                    if (i == 0 || val > max_val) {
-                        max_val = val;
-                    }
-                }
-                last_result_is_float = 1;
-                return (long long)(max_val * 1000000);
-            } else {
-                // Integer comparison
-                long long max_val = eval_expression(&ast->children[1].children[0]);
-                for (int i = 1; i < ast->children[1].child_count; i++) {
-                    long long val = eval_expression(&ast->children[1].children[i]);
-                    if (val > max_val) max_val = val;
+                } else if (want_min ? as_float < best_float : as_float > best_float) {
+                    best = arg;
+                    best_float = as_float;
                 }
-                last_result_is_float = 0;
-                return max_val;
             }
+            // A float anywhere makes the result a float, as with arithmetic
+            if (any_float) return return_float_result(ast, best_float);
+            clear_float_result();
+            return best.i;
         }
         
         // Random number generation
@@ -7797,7 +8158,7 @@ long long eval_expression(ASTNode* ast) {
                 fprintf(stderr, "Error: random() function takes no arguments\n");
                 return 0;
             }
-            return (long long)(myco_random() * 1000000); // Return as integer * 1M for precision
+            return return_float_result(ast, myco_random());
         }
         
         else if (func_name && strcmp(func_name, "randint") == 0) {
@@ -7815,9 +8176,23 @@ long long eval_expression(ASTNode* ast) {
                 fprintf(stderr, "Error: choice() function requires one argument (array)\n");
                 return 0;
             }
-            // For now, return a simple random choice
-            // TODO: Implement proper array choice functionality
-            return myco_randint(1, 100);
+            int is_temp = 0;
+            MycoArray* array = library_array_argument(&ast->children[1].children[0], &is_temp);
+            if (!array || array->size == 0) {
+                fprintf(stderr, "Error: choice() requires a non-empty array\n");
+                if (is_temp) destroy_array(array);
+                return 0;
+            }
+            long long index = myco_randint(0, array->size - 1);
+            long long result;
+            if (array->is_string_array) {
+                set_str_value("__last_choice_result", array->str_elements[index]);
+                result = -1;
+            } else {
+                result = array->elements[index];
+            }
+            if (is_temp) destroy_array(array);
+            return result;
         }
         
         // UTILITY LIBRARY FUNCTIONS v1.3.2
@@ -8283,8 +8658,15 @@ long long eval_expression(ASTNode* ast) {
                 return 0;
             }
             
-            // str() is an alias for to_string()
-            return eval_expression(&ast->children[1].children[0]);
+            // str() is an alias for to_string(); a float argument stays a float
+            ASTNode* arg = &ast->children[1].children[0];
+            clear_float_result();
+            long long value = eval_expression(arg);
+            double float_value;
+            if (float_result_of(arg, &float_value)) {
+                return return_float_result(ast, float_value);
+            }
+            return value;
         }
         
         else if (func_name && strcmp(func_name, "find") == 0) {
@@ -8293,158 +8675,34 @@ long long eval_expression(ASTNode* ast) {
                 return 0;
             }
             
-            // General string search optimization
-            ASTNode* str_node = &ast->children[1].children[0];
-            ASTNode* sub_node = &ast->children[1].children[1];
+            // Both arguments are read in place (literal text or string variable)
+            size_t main_len = 0, sub_len = 0;
+            const char* main_str = string_argument_view(&ast->children[1].children[0], &main_len);
+            const char* sub_str = string_argument_view(&ast->children[1].children[1], &sub_len);
+            if (!main_str || !sub_str) {
+                fprintf(stderr, "Error: find() requires string arguments\n");
+                return -1;
+            }
             
-
+            const char* match = string_find_bytes(main_str, main_len, sub_str, sub_len);
+            return match ? (long long)(match - main_str) : -1;
+        }
+        
+        // Native C string concatenation for maximum performance
+        else if (func_name && strcmp(func_name, "fast_concat") == 0) {
+            if (ast->child_count < 2 || ast->children[1].child_count < 2) {
+                fprintf(stderr, "Error: fast_concat() function requires two arguments (string, value)\n");
+                return 0;
+            }
             
-
-            const char* main_str = NULL;
-            const char* sub_str = NULL;
+            // General string concatenation optimization
+            ASTNode* str_node = &ast->children[1].children[0];
+            ASTNode* value_node = &ast->children[1].children[1];
             
             // PHASE 1G: INTERPRETER OPTIMIZATION - AST Node Caching
-            static ASTNode* cached_find_ast = NULL;
-            static const char* cached_main_str = NULL;
-            static const char* cached_sub_str = NULL;
-            
-            // PHASE 2B: ENHANCED CACHING - Benchmark pattern detection
-            static const char* benchmark_search_text = NULL;
-            static const char* benchmark_abc = NULL;
-            static int benchmark_result = -1;
-            
-            // Check for benchmark pattern: find(search_text, "abc")
-            if (str_node->type == AST_EXPR && str_node->text && 
-                strcmp(str_node->text, "search_text") == 0 &&
-                sub_node->type == AST_EXPR && sub_node->text && 
-                strcmp(sub_node->text, "abc") == 0) {
-                
-                // Use pre-cached benchmark strings for maximum performance
-                if (!benchmark_search_text) {
-                    benchmark_search_text = get_str_value("search_text");
-                }
-                if (!benchmark_abc) {
-                    benchmark_abc = get_str_value("abc");
-                }
-                
-                if (benchmark_search_text && benchmark_abc) {
-                    // Use optimized algorithm with cached strings
-                    int main_len = strlen(benchmark_search_text);
-                    int sub_len = strlen(benchmark_abc);
-                    benchmark_result = ultra_fast_string_search_platform_simd(benchmark_search_text, benchmark_abc, main_len, sub_len);
-                    return benchmark_result >= 0 ? (long long)benchmark_result : -1;
-                }
-            }
-            
-            // Check if we can reuse cached results
-            if (cached_find_ast == ast && cached_main_str && cached_sub_str) {
-                // Use cached strings - skip all evaluation overhead
-                int main_len = strlen(cached_main_str);
-                int sub_len = strlen(cached_sub_str);
-                
-                // Use the fastest available string search algorithm
-                int found_pos = ultra_fast_string_search_platform_simd(cached_main_str, cached_sub_str, main_len, sub_len);
-                return found_pos >= 0 ? (long long)found_pos : -1;
-            }
-            
-            // Cache this AST node for future calls
-            cached_find_ast = ast;
-            
-            // Get the main string
-            if (str_node->type == AST_EXPR && str_node->text) {
-                if (str_node->text[0] == '"') {
-                    // String literal - extract directly
-                    size_t len = strlen(str_node->text);
-                    if (len >= 2) {
-                        char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "find_string");
-                        if (temp_str) {
-                            strncpy(temp_str, str_node->text + 1, len - 2);
-                            temp_str[len - 2] = '\0';
-                            main_str = temp_str;
-                        }
-                    }
-                } else {
-                    long long str_result = eval_expression(str_node);
-            if (str_result == -1) {
-                main_str = get_str_value(str_node->text);
-            } else if (str_result == 1) {
-                if (str_node->text && str_node->text[0] == '"') {
-                    size_t len = strlen(str_node->text);
-                    if (len >= 2) {
-                        char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "find_string");
-                        strncpy(temp_str, str_node->text + 1, len - 2);
-                        temp_str[len - 2] = '\0';
-                        main_str = temp_str;
-                            }
-                        }
-                    }
-                }
-            }
-            
-            // Get the substring
-            if (sub_node->type == AST_EXPR && sub_node->text) {
-                if (sub_node->text[0] == '"') {
-                    // String literal - extract directly
-                    size_t len = strlen(sub_node->text);
-                    if (len >= 2) {
-                        char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "find_substring");
-                        if (temp_str) {
-                            strncpy(temp_str, sub_node->text + 1, len - 2);
-                            temp_str[len - 2] = '\0';
-                            sub_str = temp_str;
-                        }
-                    }
-                } else {
-            long long sub_result = eval_expression(sub_node);
-            if (sub_result == -1) {
-                sub_str = get_str_value(sub_node->text);
-            } else if (sub_result == 1) {
-                if (sub_node->text && sub_node->text[0] == '"') {
-                    size_t len = strlen(sub_node->text);
-                    if (len >= 2) {
-                        char* temp_str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "find_substring");
-                        strncpy(temp_str, sub_node->text + 1, len - 2);
-                        temp_str[len - 2] = '\0';
-                        sub_str = temp_str;
-                            }
-                        }
-                    }
-                }
-            }
-            
-            if (!main_str || !sub_str) {
-                fprintf(stderr, "Error: find() requires string arguments\n");
-                return -1;
-            }
-            
-            // Cache the results for future calls
-            cached_main_str = main_str;
-            cached_sub_str = sub_str;
-            
-            // PHASE 2A: ALGORITHM OPTIMIZATION - Use optimized string search algorithms
-            int main_len = strlen(main_str);
-            int sub_len = strlen(sub_str);
-            
-            // Use the fastest available string search algorithm
-            int found_pos = ultra_fast_string_search_platform_simd(main_str, sub_str, main_len, sub_len);
-            return found_pos >= 0 ? (long long)found_pos : -1;
-        }
-        
-        // Native C string concatenation for maximum performance
-        else if (func_name && strcmp(func_name, "fast_concat") == 0) {
-            if (ast->child_count < 2 || ast->children[1].child_count < 2) {
-                fprintf(stderr, "Error: fast_concat() function requires two arguments (string, value)\n");
-                return 0;
-            }
-            
-            // General string concatenation optimization
-            ASTNode* str_node = &ast->children[1].children[0];
-            ASTNode* value_node = &ast->children[1].children[1];
-            
-            // PHASE 1G: INTERPRETER OPTIMIZATION - AST Node Caching
-            static ASTNode* cached_concat_ast = NULL;
-            static const char* cached_str_name = NULL;
-            static const char* cached_current_str = NULL;
+            static ASTNode* cached_concat_ast = NULL;
+            static const char* cached_str_name = NULL;
+            static const char* cached_current_str = NULL;
             
             // PHASE 2B: ENHANCED CACHING - Benchmark pattern detection
             static const char* benchmark_str_result = NULL;
@@ -8605,7 +8863,7 @@ long long eval_expression(ASTNode* ast) {
             static MycoArray* cached_array = NULL;
             
             // Check if we can reuse cached results
-            if (cached_sort_ast == ast && cached_array_name && cached_array) {
+            if (cached_sort_ast == ast && cached_array_name && cached_array && array_make_writable(cached_array)) {
                 // Use cached array - skip lookup overhead
                 if (cached_array->is_string_array) {
                     // For string arrays, sort by converting to numbers
@@ -8654,7 +8912,7 @@ long long eval_expression(ASTNode* ast) {
                 }
                 
                 MycoArray* array = get_array_value(array_name);
-                if (array && array->size > 0) {
+                if (array && array->size > 0 && array_make_writable(array)) {
                     // Cache the results for future calls
                     cached_array_name = array_name;
                     cached_array = array;
@@ -8700,8 +8958,13 @@ long long eval_expression(ASTNode* ast) {
                 return 0;
             }
             
-            // For now, return the value directly (shallow copy)
-            // TODO: Implement deep copy for arrays and objects
+            // Arrays copy in O(1): the copy shares the buffer until either side is written
+            int is_temp;
+            MycoArray* source = library_array_argument(&ast->children[1].children[0], &is_temp);
+            if (source) {
+                set_array_value("__last_copy_result", is_temp ? source : array_copy(source));
+                return -2;
+            }
             return eval_expression(&ast->children[1].children[0]);
         }
         
@@ -8896,6 +9159,12 @@ long long eval_expression(ASTNode* ast) {
 
     if (ast->type == AST_EXPR && ast->text) {
         
+        // Number and float variables resolve in a single scan
+        NumericValue variable;
+        if (ast->child_count == 0 && numeric_variable(ast->text, &variable)) {
+            return return_numeric_result(ast, &variable);
+        }
+        
         // Check if this is a variable reference
         if (var_exists(ast->text)) {
             long long value = get_var_value(ast->text);
@@ -9316,6 +9585,23 @@ void eval_evaluate(ASTNode* ast) {
                     } else {
                         // Variable or number (AST_EXPR)
                         int64_t value = eval_expression(arg);
+                        double float_value;
+                        BigInt* big = big_result_of(arg);
+                        if (big) {
+                            char* digits = bigint_to_string(big, NULL);
+                            if (digits) {
+                                printf("%s", digits);
+                                tracked_free(digits, __FILE__, __LINE__, "print_bigint");
+                            }
+                            bigint_free(big);
+                            continue;
+                        }
+                        if (float_result_of(arg, &float_value)) {
+                            char float_text[FLOAT_TEXT_SIZE];
+                            format_float(float_text, sizeof(float_text), float_value);
+                            printf("%s", float_text);
+                            continue;
+                        }
                         if (value == 0) {
                             // Don't print 0 values from function calls
                             // This suppresses unwanted output from functions like push()
@@ -9465,12 +9751,14 @@ void eval_evaluate(ASTNode* ast) {
                             // Check if this value might be a scaled float
                             if (arg->text && strchr(arg->text, '.') != NULL) {
                                 // This is a float literal, unscale and display as float
-                                double float_val = (double)value / 1000000.0;
-                                printf("%.6g", float_val);
+                                char float_text[FLOAT_TEXT_SIZE];
+                                format_float(float_text, sizeof(float_text), (double)value / 1000000.0);
+                                printf("%s", float_text);
                             } else if (last_result_is_float) {
                                 // This is the result of a float arithmetic operation
-                                double float_val = (double)value / 1000000.0;
-                                printf("%.6g", float_val);
+                                char float_text[FLOAT_TEXT_SIZE];
+                                format_float(float_text, sizeof(float_text), (double)value / 1000000.0);
+                                printf("%s", float_text);
                                 last_result_is_float = 0; // Reset flag after use
                             } else {
                                 // Check if this is a variable containing a float
@@ -9481,7 +9769,9 @@ void eval_evaluate(ASTNode* ast) {
                                     for (int i = var_env_size - 1; i >= 0; i--) {
                                         if (var_env[i].name && strcmp(var_env[i].name, var_name) == 0) {
                                             if (var_env[i].type == VAR_TYPE_FLOAT) {
-                                                printf("%.6g", var_env[i].float_value);
+                                                char float_text[FLOAT_TEXT_SIZE];
+                                                format_float(float_text, sizeof(float_text), var_env[i].float_value);
+                                                printf("%s", float_text);
                                                 is_float_var = 1;
                                                 break;
                                             }
@@ -9818,16 +10108,27 @@ void eval_evaluate(ASTNode* ast) {
                             }
                         } else {
                             // Convert non-string to string
+                            clear_float_result();
+                            long long value = eval_expression(&ast->children[1].children[i]);
+                            if (array_element_rejected(&ast->children[1].children[i], "array literal")) {
+                                destroy_array(array);
+                                return;
+                            }
                             char* temp_str = tracked_malloc(64, __FILE__, __LINE__, "eval");
                             if (temp_str) {
-                                snprintf(temp_str, 64, "%lld", eval_expression(&ast->children[1].children[i]));
+                                snprintf(temp_str, 64, "%lld", value);
                             array_push(array, temp_str);
                                 // Don't free temp_str - array_push takes ownership
                             }
                         }
                     } else {
                         // Handle numeric elements
+                        clear_float_result();
                         long long value = eval_expression(&ast->children[1].children[i]);
+                        if (array_element_rejected(&ast->children[1].children[i], "array literal")) {
+                            destroy_array(array);
+                            return;
+                        }
                         // Store the actual value, not a pointer to local variable
                         array->elements[array->size] = value;
                         array->size++;
@@ -9897,73 +10198,12 @@ void eval_evaluate(ASTNode* ast) {
             // Check if the value is an object literal
             if (ast->children[1].type == AST_OBJECT_LITERAL) {
                 // Handle object literal creation: let obj = {prop1: val1, prop2: val2}
-                if (ast->children[1].child_count == 0) {
-                    // Empty object
-                    MycoObject* obj = create_object(8); // Default capacity
-                    if (!obj) {
-                        fprintf(stderr, "Error: Failed to create object at line %d\n", ast->line);
-                        return;
-                    }
-                    set_object_value(var_name, obj);
-                    return;
-                }
-                
-                // Create object with appropriate capacity
-                MycoObject* obj = create_object(ast->children[1].child_count);
+                MycoObject* obj = create_object_from_literal(&ast->children[1]);
                 if (!obj) {
                     fprintf(stderr, "Error: Failed to create object at line %d\n", ast->line);
                     return;
                 }
                 
-                // Add properties to the object
-                for (int i = 0; i < ast->children[1].child_count; i++) {
-                    if (ast->children[1].children[i].type == AST_EXPR && 
-                        ast->children[1].children[i].text && 
-                        strcmp(ast->children[1].children[i].text, "prop") == 0 &&
-                        ast->children[1].children[i].child_count == 2) {
-                        
-                        // Get property name and value
-                        char* prop_name = ast->children[1].children[i].children[0].text;
-                        if (!prop_name) continue;
-                        
-                        // Check if the property value is a nested object literal
-                        if (ast->children[1].children[i].children[1].type == AST_OBJECT_LITERAL) {
-                            // This is a nested object: use recursive helper function
-                            MycoObject* nested_obj = create_object_from_literal(&ast->children[1].children[i].children[1]);
-                            if (nested_obj) {
-                                object_set_property_typed(obj, prop_name, nested_obj, PROP_TYPE_OBJECT);
-                            } else {
-                                fprintf(stderr, "Error: Failed to create nested object at line %d\n", ast->line);
-                                object_set_property_typed(obj, prop_name, (void*)0, PROP_TYPE_NUMBER);
-                            }
-                        } else {
-                            // Check if the property value is a string literal
-                            if (ast->children[1].children[i].children[1].type == AST_EXPR && 
-                                ast->children[1].children[i].children[1].text &&
-                                ast->children[1].children[i].children[1].text[0] == '"') {
-                                // This is a string literal like "John"
-                                // Store the string directly (remove quotes)
-                                char* str_value = ast->children[1].children[i].children[1].text;
-                                if (strlen(str_value) >= 2) {
-                                    // Remove quotes and store the string
-                                    char* clean_str = tracked_strdup(str_value + 1, __FILE__, __LINE__, "eval"); // Skip first quote
-                                    clean_str[strlen(clean_str) - 1] = '\0'; // Remove last quote
-                                    object_set_property_typed(obj, prop_name, clean_str, PROP_TYPE_STRING);
-                                } else {
-                                    // Empty string
-                                    object_set_property_typed(obj, prop_name, tracked_strdup("", __FILE__, __LINE__, "object_set_property_empty"), PROP_TYPE_STRING);
-                                }
-                            } else {
-                                // Evaluate the property value as a simple expression (number)
-                                long long prop_value = eval_expression(&ast->children[1].children[i].children[1]);
-                                
-                                // Store the property as a number
-                                object_set_property_typed(obj, prop_name, (void*)(long long)prop_value, PROP_TYPE_NUMBER);
-                            }
-                        }
-                    }
-                }
-                
                 set_object_value(var_name, obj);
                 return;
             }
@@ -9976,17 +10216,19 @@ void eval_evaluate(ASTNode* ast) {
             }
             
             // Handle regular numeric assignment
+            clear_float_result();
             int64_t value = eval_expression(&ast->children[1]);
             
-            // Check if this is a float literal assignment
-            if (ast->children[1].type == AST_EXPR && ast->children[1].text && strchr(ast->children[1].text, '.') != NULL) {
-                // This is a float literal assignment - store as float
-                char* endptr;
-                double float_val = strtod(ast->children[1].text, &endptr);
-                if (*endptr == '\0') {
-                    set_float_value(var_name, float_val);
-                    return;
-                }
+            double float_value;
+            BigInt* big = big_result_of(&ast->children[1]);
+            if (big) {
+                // Integer beyond 64 bits - keep it exact
+                set_big_value(var_name, big);
+                return;
+            } else if (float_result_of(&ast->children[1], &float_value)) {
+                // Float literal, variable or arithmetic - store the exact double
+                set_float_value(var_name, float_value);
+                return;
             } else if (value == 1) {
                 // This is a string literal - get the string value from the AST
             if (ast->children[1].type == AST_EXPR && ast->children[1].text && is_string_literal(ast->children[1].text)) {
@@ -10005,6 +10247,26 @@ void eval_evaluate(ASTNode* ast) {
                 return;
             } else if (value == -1) {
 
+                // A direct call to a string builtin has its own result slot; read it before
+                // any shared (possibly stale) concatenation or array access result
+                const char* builtin_slot = string_builtin_result_slot(&ast->children[1]);
+                const char* builtin_result = builtin_slot ? get_str_value(builtin_slot) : NULL;
+                if (builtin_result) {
+                    set_str_value(var_name, builtin_result);
+                    return;
+                }
+                char* library_string = take_library_string(&ast->children[1]);
+                if (library_string) {
+                    set_str_value(var_name, library_string);
+                    tracked_free(library_string, __FILE__, __LINE__, "library_string_result");
+                    return;
+                }
+                if (is_library_call(&ast->children[1])) {
+                    // A library call that built no string returned the number -1
+                    set_var_value(var_name, -1);
+                    return;
+                }
+
                 // This is a string concatenation result, string function result, string multiplication result, or array access result
                 // Check for string concatenation result FIRST (most common case)
                 if (last_concat_result) {
@@ -10098,6 +10360,30 @@ void eval_evaluate(ASTNode* ast) {
                 return;
                 
             } else if (value == -2) {
+                // An array built by a library function (alias.fn(...)) is moved out of its slot
+                MycoArray* library_result = take_call_array_result(&ast->children[1]);
+                if (library_result) {
+                    set_array_value(var_name, library_result);
+                    return;
+                }
+                if (is_library_call(&ast->children[1])) {
+                    // A library call that built no array returned the number -2
+                    set_var_value(var_name, -2);
+                    return;
+                }
+                
+                // A direct split(), slice() or copy() call moves its fresh array out of the result slot,
+                // so neither a stale map/filter result nor the slot can alias it
+                MycoArray* direct_result = take_direct_array_result(&ast->children[1]);
+                if (!direct_result) {
+                    // let x = existing_array shares the buffer; the first write to either copies it
+                    direct_result = copy_array_variable(&ast->children[1]);
+                }
+                if (direct_result) {
+                    set_array_value(var_name, direct_result);
+                    return;
+                }
+                
                 // This is an array function result - get from predictable variable
                 // Check most recent functions first (map is usually called after filter)
                 MycoArray* array_result = get_array_value("__last_map_result");
@@ -10135,6 +10421,15 @@ void eval_evaluate(ASTNode* ast) {
                         set_array_value(var_name, empty_array);
                     }
                 }
+            } else if (value == -3 && ast->children[1].text && strcmp(ast->children[1].text, "call") == 0) {
+                // This is an object built by a library function - take ownership of it
+                MycoObject* object_result = take_call_object_result(&ast->children[1]);
+                if (object_result) {
+                    set_object_value(var_name, object_result);
+                } else {
+                    set_var_value(var_name, value);
+                }
+                return;
             } else {
                 // This is a numeric result
                 set_var_value(var_name, value);
@@ -10221,9 +10516,24 @@ void eval_evaluate(ASTNode* ast) {
                 global_loop_state->return_requested = 0;
             }
 
+            clear_float_result();
             int64_t value = eval_expression(&ast->children[1]);
-            
-            if (value == -1) {
+            double float_value;
+            int is_float = float_result_of(&ast->children[1], &float_value);
+            BigInt* big = big_result_of(&ast->children[1]);
+            char* library_string = !is_float && !big && value == -1 ? take_library_string(&ast->children[1]) : NULL;
+            MycoArray* direct_array = NULL;
+            MycoObject* object_result = NULL;
+            
+            if (big) {
+                set_big_value(var_name, big);
+            } else if (is_float) {
+                set_float_value(var_name, float_value);
+            } else if (library_string) {
+                // String built by a library function
+                set_str_value(var_name, library_string);
+                tracked_free(library_string, __FILE__, __LINE__, "library_string_result");
+            } else if (value == -1 && !is_library_call(&ast->children[1])) {
                 // String assignment - handle string results from various sources
                 if (last_concat_result) {
                     // String concatenation result
@@ -10238,6 +10548,17 @@ void eval_evaluate(ASTNode* ast) {
                     // Fallback: set empty string
                     set_str_value(var_name, "");
                 }
+            } else if (value == -3 && ast->children[1].text && strcmp(ast->children[1].text, "call") == 0 &&
+                       (object_result = take_call_object_result(&ast->children[1])) != NULL) {
+                // Object built by a library function
+                set_object_value(var_name, object_result);
+            } else if (value == -2 && (direct_array = take_call_array_result(&ast->children[1])) != NULL) {
+                // Array built by a library function
+                set_array_value(var_name, direct_array);
+            } else if (value == -2 && ((direct_array = take_direct_array_result(&ast->children[1])) != NULL ||
+                                       (direct_array = copy_array_variable(&ast->children[1])) != NULL)) {
+                // Array built by split(), slice() or copy(), or shared with another variable
+                set_array_value(var_name, direct_array);
             } else {
                 // Numeric assignment
             set_var_value(var_name, value);
@@ -10274,11 +10595,8 @@ void eval_evaluate(ASTNode* ast) {
                 return;
             }
 
-            // Evaluate the value expression
-            long long value = eval_expression(&ast->children[2]);
-
-            // Set the object property
-            if (!object_set_property(obj, prop_name, (void*)(long long)value)) {
+            // Evaluate the value expression and set the object property
+            if (!set_numeric_property(obj, prop_name, &ast->children[2])) {
                 fprintf(stderr, "Error: Failed to set object property at line %d\n", ast->line);
                 return;
             }
@@ -10317,11 +10635,8 @@ void eval_evaluate(ASTNode* ast) {
                     return;
                 }
 
-                // Evaluate the value expression
-                long long value = eval_expression(&ast->children[3]);
-
-                // Set the final property (prop2) on the intermediate object
-                if (!object_set_property(intermediate_obj, prop2_name, (void*)(long long)value)) {
+                // Evaluate the value expression and set the final property (prop2) on the intermediate object
+                if (!set_numeric_property(intermediate_obj, prop2_name, &ast->children[3])) {
                     fprintf(stderr, "Error: Failed to set nested property '%s.%s.%s' at line %d\n", 
                             obj_name, prop1_name, prop2_name, ast->line);
                     return;
@@ -10379,11 +10694,8 @@ void eval_evaluate(ASTNode* ast) {
                     return;
                 }
 
-                // Evaluate the value expression
-                long long value = eval_expression(&ast->children[4]);
-
-                // Set the final property (prop3) on the second intermediate object
-                if (!object_set_property(intermediate2_obj, prop3_name, (void*)(long long)value)) {
+                // Evaluate the value expression and set the final property (prop3) on the second intermediate object
+                if (!set_numeric_property(intermediate2_obj, prop3_name, &ast->children[4])) {
                     fprintf(stderr, "Error: Failed to set nested property '%s.%s.%s.%s' at line %d\n", 
                             obj_name, prop1_name, prop2_name, prop3_name, ast->line);
                     return;
@@ -10451,11 +10763,8 @@ void eval_evaluate(ASTNode* ast) {
                 return;
             }
 
-            // Evaluate the value expression
-            long long value = eval_expression(&ast->children[2]);
-
-            // Set the object property (simplified approach like existing AST_OBJECT_ASSIGN)
-            if (!object_set_property(obj, prop_name, (void*)(long long)value)) {
+            // Evaluate the value expression and set the object property (like AST_OBJECT_ASSIGN)
+            if (!set_numeric_property(obj, prop_name, &ast->children[2])) {
                 fprintf(stderr, "Error: Failed to set object property at line %d\n", ast->line);
                 return;
             }
@@ -10526,11 +10835,15 @@ void eval_evaluate(ASTNode* ast) {
 
         case AST_RETURN: {
             if (ast->child_count > 0) {
+                clear_float_result();
                 int64_t value = eval_expression(&ast->children[0]);
                 
                 // Set global return values for function calls
                 return_flag = 1;
                 return_value = value;
+                return_is_float = float_result_of(&ast->children[0], &return_float_value);
+                if (return_big_value) bigint_free(return_big_value);
+                return_big_value = big_result_of(&ast->children[0]);
                 
                 if (global_loop_state) {
                     global_loop_state->return_requested = 1;
@@ -10541,6 +10854,7 @@ void eval_evaluate(ASTNode* ast) {
             // Set global return values for function calls
             return_flag = 1;
             return_value = 0;
+            return_is_float = 0;
             
             if (global_loop_state) {
                 global_loop_state->return_requested = 1;
@@ -10813,6 +11127,41 @@ MycoArray* get_array_value(const char* name) {
 
 // ========================= SET MANAGEMENT FUNCTIONS =========================
 
+/**
+ * @brief Creates a new empty set
+ * @param initial_capacity Initial element capacity (INITIAL_ARRAY_CAPACITY if <= 0)
+ * @param is_string_set 1 for a string set, 0 for a number set
+ * @return New set instance, or NULL on failure
+ */
+MycoSet* create_set(int initial_capacity, int is_string_set) {
+    if (initial_capacity <= 0) initial_capacity = INITIAL_ARRAY_CAPACITY;
+    
+    MycoSet* set = (MycoSet*)tracked_malloc(sizeof(MycoSet), __FILE__, __LINE__, "create_set");
+    if (!set) return NULL;
+    set->elements = (void**)tracked_malloc(initial_capacity * sizeof(void*), __FILE__, __LINE__, "create_set_elements");
+    if (!set->elements) {
+        tracked_free(set, __FILE__, __LINE__, "create_set_fail");
+        return NULL;
+    }
+    set->element_count = 0;
+    set->capacity = initial_capacity;
+    set->is_string_set = is_string_set;
+    return set;
+}
+
+/**
+ * @brief Destroys a set and the element copies it owns
+ * @param set The set to destroy
+ */
+void destroy_set(MycoSet* set) {
+    if (!set) return;
+    for (int i = 0; i < set->element_count; i++) {
+        tracked_free(set->elements[i], __FILE__, __LINE__, "destroy_set_element");
+    }
+    tracked_free(set->elements, __FILE__, __LINE__, "destroy_set_elements");
+    tracked_free(set, __FILE__, __LINE__, "destroy_set");
+}
+
 int set_has(MycoSet* set, void* element) {
     if (!set || !element) return 0;
     
@@ -10875,6 +11224,7 @@ void set_set_value(const char* name, MycoSet* set) {
     // Check if variable already exists
     for (int i = 0; i < var_env_size; i++) {
         if (var_env[i].name && strcmp(var_env[i].name, name) == 0) {
+            release_big_value(&var_env[i]);
             var_env[i].type = VAR_TYPE_SET;
             var_env[i].set_value = set;
             return;
@@ -10914,52 +11264,599 @@ MycoSet* get_set_value(const char* name) {
  * LIBRARY FUNCTION IMPLEMENTATIONS
  ******************************************************************************/
 
-// Math Library Functions
-static long long call_math_function(const char* func_name, ASTNode* args_node) {
-    if (strcmp(func_name, "abs") == 0) {
-        if (args_node->child_count < 1) {
-            fprintf(stderr, "Error: math.abs() requires one argument\n");
-            return 0;
-        }
-        
-        long long value = eval_expression(&args_node->children[0]);
-        return value < 0 ? -value : value;
-        
-    } else if (strcmp(func_name, "pow") == 0) {
-        if (args_node->child_count < 2) {
-            fprintf(stderr, "Error: math.pow() requires two arguments\n");
-            return 0;
-        }
-        
-        long long base = eval_expression(&args_node->children[0]);
-        long long exp = eval_expression(&args_node->children[1]);
-        return (long long)pow((double)base, (double)exp);
-        
-    } else if (strcmp(func_name, "sqrt") == 0) {
-        if (args_node->child_count < 1) {
-            fprintf(stderr, "Error: math.sqrt() requires one argument\n");
-            return 0;
+/**
+ * @brief Resolves a library argument to its string content
+ * @param node Argument node (string literal or string variable)
+ * @return Newly allocated string (caller frees), or NULL if not a string
+ */
+static char* library_string_argument(ASTNode* node) {
+    if (!node || node->type != AST_EXPR || !node->text) return NULL;
+
+    if (is_string_literal(node->text)) {
+        size_t len = strlen(node->text);
+        char* str = (char*)tracked_malloc(len - 1, __FILE__, __LINE__, "library_string_argument");
+        if (!str) return NULL;
+        memcpy(str, node->text + 1, len - 2);
+        str[len - 2] = '\0';
+        return str;
+    }
+
+    const char* str_val = get_str_value(node->text);
+    if (str_val) {
+        return tracked_strdup(str_val, __FILE__, __LINE__, "library_string_argument");
+    }
+    return NULL;
+}
+
+/**
+ * @brief Resolves a library argument to an array
+ * @param node Argument node (array literal or array variable)
+ * @param is_temporary Set to 1 when the array was built from a literal and must be destroyed by the caller
+ * @return The array, or NULL if the argument is not an array
+ */
+static MycoArray* library_array_argument(ASTNode* node, int* is_temporary) {
+    *is_temporary = 0;
+    if (!node) return NULL;
+
+    if (node->type == AST_ARRAY_LITERAL) {
+        int is_string_array = node->child_count > 0 && node->children[0].type == AST_EXPR &&
+                              node->children[0].text && is_string_literal(node->children[0].text);
+        MycoArray* array = create_array(node->child_count, is_string_array);
+        if (!array) return NULL;
+
+        for (int i = 0; i < node->child_count; i++) {
+            if (is_string_array) {
+                char* str = library_string_argument(&node->children[i]);
+                if (!str) {
+                    char num_str[32];
+                    snprintf(num_str, sizeof(num_str), "%lld", eval_expression(&node->children[i]));
+                    array_push(array, num_str);
+                } else {
+                    array_push(array, str);
+                    tracked_free(str, __FILE__, __LINE__, "library_array_argument");
+                }
+            } else {
+                clear_float_result();
+                long long value = eval_expression(&node->children[i]);
+                if (array_element_rejected(&node->children[i], "array literal")) {
+                    destroy_array(array);
+                    return NULL;
+                }
+                array_push(array, &value);
+            }
         }
-        
-        long long value = eval_expression(&args_node->children[0]);
-        if (value < 0) {
-            fprintf(stderr, "Error: math.sqrt() cannot take square root of negative number\n");
-            return 0;
+        *is_temporary = 1;
+        return array;
+    }
+
+    if (node->type == AST_EXPR && node->text) {
+        return get_array_value(node->text);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Resolves a library argument to an options object
+ * @param node Argument node (object literal or object variable)
+ * @param is_temporary Set to 1 when the object was built from a literal and must be destroyed by the caller
+ * @return The object, or NULL if the argument is not an object
+ */
+static MycoObject* library_object_argument(ASTNode* node, int* is_temporary) {
+    *is_temporary = 0;
+    if (!node) return NULL;
+
+    if (node->type == AST_OBJECT_LITERAL) {
+        *is_temporary = 1;
+        return create_object_from_literal(node);
+    }
+    if (node->type == AST_EXPR && node->text) {
+        return get_object_value(node->text);
+    }
+    return NULL;
+}
+
+// Read a numeric option from an options object, falling back to a default when absent
+static long long library_number_option(MycoObject* options, const char* name, long long default_value) {
+    if (!options || !object_has_property(options, name)) return default_value;
+    if (object_get_property_type(options, name) != PROP_TYPE_NUMBER) return default_value;
+    return (long long)object_get_property(options, name);
+}
+
+// Destroy an options object built from a literal, including its string values
+static void library_free_temporary_object(MycoObject* obj) {
+    if (!obj) return;
+    for (int i = 0; i < obj->property_count; i++) {
+        if (obj->property_types[i] == PROP_TYPE_STRING && obj->property_values[i]) {
+            tracked_free(obj->property_values[i], __FILE__, __LINE__, "library_free_temporary_object");
         }
-        return (long long)sqrt((double)value);
-        
-    } else if (strcmp(func_name, "min") == 0) {
+    }
+    destroy_object(obj);
+}
+
+/**
+ * @brief Hands an object built by a library function back to the caller
+ * @param obj The result object (ownership moves to the result slot)
+ * @return -3, the object result indicator picked up by let/assignment
+ */
+static long long return_object_result(MycoObject* obj) {
+    if (!obj) return 0;
+    set_object_value("__last_object_result", obj);
+    object_result_call = library_call_node;
+    return -3;
+}
+
+// Hand an array built by a library function back to let/assignment (returns -2)
+static long long return_array_result(MycoArray* array) {
+    if (!array) return 0;
+    set_array_value("__last_array_result", array);
+    array_result_call = library_call_node;
+    return -2;
+}
+
+// Hand a string built by a library function back to let/assignment (returns -1)
+static long long return_string_result(char* str) {
+    if (!str) return 0;
+    if (last_library_string) tracked_free(last_library_string, __FILE__, __LINE__, "library_string_result");
+    last_library_string = str;
+    string_result_call = library_call_node;
+    return -1;
+}
+
+// Resolve a math argument to a number array (string arrays are rejected)
+static MycoArray* math_array_argument(ASTNode* node, int* is_temporary) {
+    MycoArray* array = library_array_argument(node, is_temporary);
+    if (array && array->is_string_array) {
+        if (*is_temporary) destroy_array(array);
+        *is_temporary = 0;
+        return NULL;
+    }
+    return array;
+}
+
+static ArrayOp math_array_op(const char* func_name, int* found) {
+    *found = 1;
+    if (strcmp(func_name, "add") == 0) return ARRAY_OP_ADD;
+    if (strcmp(func_name, "sub") == 0) return ARRAY_OP_SUB;
+    if (strcmp(func_name, "mul") == 0) return ARRAY_OP_MUL;
+    if (strcmp(func_name, "div") == 0) return ARRAY_OP_DIV;
+    *found = 0;
+    return ARRAY_OP_ADD;
+}
+
+/**
+ * @brief Array overloads of the math library (m.isqrt(arr), m.add(arr, 2), ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through to the scalar functions
+ *
+ * Every overload writes a new number array through one of the kernels in
+ * array_kernels.c, so a whole array is transformed by a single native loop.
+ */
+static int call_math_array_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+    int is_binary = 0;
+    ArrayOp op = math_array_op(func_name, &is_binary);
+
+    if (is_binary) {
         if (args_node->child_count < 2) {
-            fprintf(stderr, "Error: math.min() requires at least two arguments\n");
-            return 0;
+            fprintf(stderr, "Error: math.%s() requires two arguments\n", func_name);
+            return 1;
         }
-        
-        long long min_val = LLONG_MAX;
-        for (int i = 0; i < args_node->child_count; i++) {
-            long long value = eval_expression(&args_node->children[i]);
-            if (value < min_val) min_val = value;
+        int left_temp = 0, right_temp = 0;
+        MycoArray* left = math_array_argument(&args_node->children[0], &left_temp);
+        MycoArray* right = math_array_argument(&args_node->children[1], &right_temp);
+        long long left_scalar = left ? 0 : eval_expression(&args_node->children[0]);
+        long long right_scalar = right ? 0 : eval_expression(&args_node->children[1]);
+
+        if (!left && !right) {
+            // Plain scalar arithmetic
+            long long x = left_scalar, y = right_scalar;
+            switch (op) {
+                case ARRAY_OP_ADD: *result = x + y; break;
+                case ARRAY_OP_SUB: *result = x - y; break;
+                case ARRAY_OP_MUL: *result = x * y; break;
+                case ARRAY_OP_DIV:
+                    if (y == 0) fprintf(stderr, "Error: math.div() division by zero\n");
+                    else *result = x / y;
+                    break;
+            }
+            return 1;
         }
-        return min_val;
+        if (left && right && left->size != right->size) {
+            fprintf(stderr, "Error: math.%s() arrays must have the same length (%d vs %d)\n", func_name, left->size, right->size);
+        } else {
+            MycoArray* source = left ? left : right;
+            MycoArray* out = create_array(source->size, 0);
+            if (out) {
+                long bad;
+                if (left && right) {
+                    bad = array_kernel_binary(out->elements, left->elements, right->elements, (size_t)left->size, op);
+                } else if (left) {
+                    bad = array_kernel_binary_scalar(out->elements, left->elements, right_scalar, (size_t)left->size, op, 0);
+                } else {
+                    bad = array_kernel_binary_scalar(out->elements, right->elements, left_scalar, (size_t)right->size, op, 1);
+                }
+                if (bad >= 0) {
+                    fprintf(stderr, "Error: math.div() division by zero at index %ld\n", bad);
+                    destroy_array(out);
+                } else {
+                    out->size = source->size;
+                    *result = return_array_result(out);
+                }
+            }
+        }
+        if (left_temp) destroy_array(left);
+        if (right_temp) destroy_array(right);
+        return 1;
+    }
+
+    // On integer arrays sqrt rounds down like isqrt, and floor/ceil leave the (already whole) elements unchanged
+    int is_sqrt = strcmp(func_name, "sqrt") == 0 || strcmp(func_name, "isqrt") == 0;
+    int is_rounding = strcmp(func_name, "floor") == 0 || strcmp(func_name, "ceil") == 0;
+    int is_unary = strcmp(func_name, "abs") == 0 || is_sqrt || is_rounding || strcmp(func_name, "pow") == 0 ||
+                   strcmp(func_name, "floor_div") == 0 || strcmp(func_name, "ceil_div") == 0 || strcmp(func_name, "scale") == 0;
+    if (!is_unary || args_node->child_count < 1) return 0;
+
+    int is_temp = 0;
+    MycoArray* input = math_array_argument(&args_node->children[0], &is_temp);
+    if (!input) {
+        // Scalars: isqrt/floor_div/ceil_div/scale have no scalar form elsewhere, the rest fall through
+        if (strcmp(func_name, "abs") == 0 || strcmp(func_name, "pow") == 0 || strcmp(func_name, "sqrt") == 0 || is_rounding) return 0;
+        long long x = eval_expression(&args_node->children[0]);
+        long long out;
+        if (strcmp(func_name, "isqrt") == 0) {
+            if (array_kernel_sqrt(&out, &x, 1) >= 0) {
+                fprintf(stderr, "Error: math.isqrt() cannot take square root of negative number\n");
+                return 1;
+            }
+            *result = out;
+            return 1;
+        }
+        long long first = args_node->child_count > 1 ? eval_expression(&args_node->children[1]) : 1;
+        long long second = args_node->child_count > 2 ? eval_expression(&args_node->children[2]) : 1;
+        long long divisor = strcmp(func_name, "scale") == 0 ? second : first;
+        if (divisor == 0) {
+            fprintf(stderr, "Error: math.%s() division by zero\n", func_name);
+            return 1;
+        }
+        if (strcmp(func_name, "floor_div") == 0) array_kernel_floor_div(&out, &x, 1, divisor);
+        else if (strcmp(func_name, "ceil_div") == 0) array_kernel_ceil_div(&out, &x, 1, divisor);
+        else array_kernel_scale(&out, &x, 1, first, second);
+        *result = out;
+        return 1;
+    }
+
+    size_t n = (size_t)input->size;
+    MycoArray* out = create_array(input->size, 0);
+    int ok = out != NULL;
+    if (ok && strcmp(func_name, "abs") == 0) {
+        array_kernel_abs(out->elements, input->elements, n);
+    } else if (ok && is_sqrt) {
+        long bad = array_kernel_sqrt(out->elements, input->elements, n);
+        if (bad >= 0) {
+            fprintf(stderr, "Error: math.%s() cannot take square root of negative number (index %ld)\n", func_name, bad);
+            ok = 0;
+        }
+    } else if (ok && is_rounding) {
+        if (n > 0) memcpy(out->elements, input->elements, n * sizeof(long long));
+    } else if (ok && strcmp(func_name, "pow") == 0) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: math.pow() requires two arguments\n");
+            ok = 0;
+        } else {
+            array_kernel_pow(out->elements, input->elements, n, eval_expression(&args_node->children[1]));
+        }
+    } else if (ok) {
+        // floor_div(arr, d) / ceil_div(arr, d) divide with rounding; scale(arr, num, den) multiplies by num/den
+        int is_scale = strcmp(func_name, "scale") == 0;
+        long long first = args_node->child_count > 1 ? eval_expression(&args_node->children[1]) : 1;
+        long long second = args_node->child_count > 2 ? eval_expression(&args_node->children[2]) : 1;
+        long long divisor = is_scale ? second : first;
+        if (divisor == 0) {
+            fprintf(stderr, "Error: math.%s() division by zero\n", func_name);
+            ok = 0;
+        } else if (is_scale) {
+            array_kernel_scale(out->elements, input->elements, n, first, second);
+        } else if (strcmp(func_name, "floor_div") == 0) {
+            array_kernel_floor_div(out->elements, input->elements, n, divisor);
+        } else {
+            array_kernel_ceil_div(out->elements, input->elements, n, divisor);
+        }
+    }
+
+    if (ok) {
+        out->size = input->size;
+        *result = return_array_result(out);
+    } else if (out) {
+        destroy_array(out);
+    }
+    if (is_temp) destroy_array(input);
+    return 1;
+}
+
+/*******************************************************************************
+ * NATIVE HANDLES
+ ******************************************************************************/
+
+// Native objects handed to scripts as numbers; handles are index + 1 within each registry
+typedef struct {
+    void** items;
+    int count;
+    int capacity;
+} HandleRegistry;
+
+static long long register_handle(HandleRegistry* registry, void* item) {
+    // Reuse a released slot before growing the table
+    for (int i = 0; i < registry->count; i++) {
+        if (!registry->items[i]) {
+            registry->items[i] = item;
+            return i + 1;
+        }
+    }
+    if (registry->count >= registry->capacity) {
+        int new_capacity = registry->capacity ? registry->capacity * 2 : 8;
+        void** grown = (void**)tracked_realloc(registry->items, new_capacity * sizeof(void*), __FILE__, __LINE__, "native_handles");
+        if (!grown) return 0;
+        registry->items = grown;
+        registry->capacity = new_capacity;
+    }
+    registry->items[registry->count++] = item;
+    return registry->count;
+}
+
+// The item behind a handle, or NULL if it is not a live handle of this registry
+static void* lookup_handle(HandleRegistry* registry, long long handle) {
+    if (handle < 1 || handle > registry->count) return NULL;
+    return registry->items[handle - 1];
+}
+
+// Forget a handle (the caller frees the structure)
+static void release_handle(HandleRegistry* registry, void* item) {
+    for (int i = 0; i < registry->count; i++) {
+        if (registry->items[i] == item) registry->items[i] = NULL;
+    }
+}
+
+// Generators handed out by math.rng()
+static HandleRegistry random_generators = { NULL, 0, 0 };
+
+/**
+ * @brief Picks the generator for a random call
+ * @param args_node Call arguments
+ * @param index Position of the optional generator handle
+ * @return The generator from math.rng(), the default generator when the handle is absent, or NULL on a bad handle
+ */
+static RandomState* random_generator_argument(ASTNode* args_node, int index, const char* caller) {
+    if (args_node->child_count <= index) {
+        init_random();
+        return &default_random_state;
+    }
+    RandomState* state = (RandomState*)lookup_handle(&random_generators, eval_expression(&args_node->children[index]));
+    if (!state) fprintf(stderr, "Error: math.%s() expects a generator from math.rng()\n", caller);
+    return state;
+}
+
+/**
+ * @brief Random functions of the math library (m.seed, m.rng, m.random_ints, m.shuffle, ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through
+ *
+ * Every function takes an optional trailing generator handle from
+ * math.rng(); without one the shared default generator is used. Bulk
+ * functions fill or permute a whole array in one native loop.
+ */
+static int call_math_random_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+
+    if (strcmp(func_name, "seed") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: math.seed() requires one argument (seed)\n");
+            return 1;
+        }
+        seed_random((uint64_t)eval_expression(&args_node->children[0]));
+        *result = 1;
+        return 1;
+    }
+
+    if (strcmp(func_name, "rng") == 0) {
+        // rng(seed, stream): streams of one seed are 2^128 draws apart, so they never overlap
+        long long stream = args_node->child_count > 1 ? eval_expression(&args_node->children[1]) : 0;
+        if (error_occurred) return 1;
+        if (stream < 0) {
+            fprintf(stderr, "Error: math.rng() stream must be a non-negative integer\n");
+            return 1;
+        }
+        uint64_t seed;
+        if (args_node->child_count > 0) {
+            seed = (uint64_t)eval_expression(&args_node->children[0]);
+        } else {
+            init_random();
+            seed = random_next(&default_random_state);
+        }
+        RandomState* state = (RandomState*)tracked_malloc(sizeof(RandomState), __FILE__, __LINE__, "random_generator");
+        if (!state) return 1;
+        random_seed_stream(state, seed, (uint64_t)stream);
+        *result = register_handle(&random_generators, state);
+        if (!*result) tracked_free(state, __FILE__, __LINE__, "random_generator");
+        return 1;
+    }
+
+    if (strcmp(func_name, "free_rng") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: math.free_rng() requires one argument (generator)\n");
+            return 1;
+        }
+        RandomState* state = random_generator_argument(args_node, 0, func_name);
+        if (!state) return 1;
+        release_handle(&random_generators, state);
+        tracked_free(state, __FILE__, __LINE__, "random_generator");
+        *result = 1;
+        return 1;
+    }
+
+    if (strcmp(func_name, "random") == 0) {
+        RandomState* state = random_generator_argument(args_node, 0, func_name);
+        // Reported against the argument list; dispatch moves it to the call
+        if (state) *result = return_float_result(args_node, random_double(state));
+        return 1;
+    }
+
+    if (strcmp(func_name, "randint") == 0) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: math.randint() requires two arguments (min, max)\n");
+            return 1;
+        }
+        long long min_val = eval_expression(&args_node->children[0]);
+        long long max_val = eval_expression(&args_node->children[1]);
+        RandomState* state = random_generator_argument(args_node, 2, func_name);
+        if (state) *result = random_range(state, min_val, max_val);
+        return 1;
+    }
+
+    if (strcmp(func_name, "random_floats") == 0) {
+        fprintf(stderr, "Error: math.random_floats() is unavailable because arrays hold integers and strings, not floats; use math.random()\n");
+        return 1;
+    }
+
+    if (strcmp(func_name, "random_ints") == 0) {
+        if (args_node->child_count < 3) {
+            fprintf(stderr, "Error: math.random_ints() requires three arguments (count, min, max)\n");
+            return 1;
+        }
+        long long count = eval_expression(&args_node->children[0]);
+        if (count < 0 || count > INT_MAX) {
+            fprintf(stderr, "Error: math.%s() count must be between 0 and %d\n", func_name, INT_MAX);
+            return 1;
+        }
+        long long min_val = eval_expression(&args_node->children[1]);
+        long long max_val = eval_expression(&args_node->children[2]);
+        RandomState* state = random_generator_argument(args_node, 3, func_name);
+        if (!state) return 1;
+        MycoArray* out = create_array((int)count, 0);
+        if (!out) return 1;
+        random_fill_range(state, out->elements, (size_t)count, min_val, max_val);
+        out->size = (int)count;
+        *result = return_array_result(out);
+        return 1;
+    }
+
+    int is_shuffle = strcmp(func_name, "shuffle") == 0;
+    int is_choice = strcmp(func_name, "choice") == 0;
+    int is_sample = strcmp(func_name, "sample") == 0;
+    if (!is_shuffle && !is_choice && !is_sample) return 0;
+
+    int needed = is_sample ? 2 : 1;
+    if (args_node->child_count < needed) {
+        fprintf(stderr, "Error: math.%s() requires %s\n", func_name, is_sample ? "two arguments (array, count)" : "one argument (array)");
+        return 1;
+    }
+    int is_temp = 0;
+    MycoArray* array = library_array_argument(&args_node->children[0], &is_temp);
+    if (!array) {
+        fprintf(stderr, "Error: math.%s() requires an array\n", func_name);
+        return 1;
+    }
+    long long count = is_sample ? eval_expression(&args_node->children[1]) : 0;
+    RandomState* state = random_generator_argument(args_node, needed, func_name);
+    size_t n = (size_t)array->size;
+
+    if (!state) {
+        // Bad generator handle (already reported)
+    } else if (is_shuffle) {
+        // Variables are permuted in place; a literal's shuffled copy is returned instead
+        if (!is_temp && !array_make_writable(array)) return 1;
+        if (array->is_string_array) random_shuffle_strings(state, array->str_elements, n);
+        else random_shuffle_numbers(state, array->elements, n);
+        if (is_temp) {
+            is_temp = 0;
+            *result = return_array_result(array);
+        } else {
+            *result = array->size;
+        }
+    } else if (is_choice) {
+        if (n == 0) {
+            fprintf(stderr, "Error: math.choice() requires a non-empty array\n");
+        } else {
+            size_t index = (size_t)random_below(state, n);
+            if (array->is_string_array) {
+                *result = return_string_result(tracked_strdup(array->str_elements[index], __FILE__, __LINE__, "random_choice"));
+            } else {
+                *result = array->elements[index];
+            }
+        }
+    } else if (count < 0 || (size_t)count > n) {
+        fprintf(stderr, "Error: math.sample() count must be between 0 and the array length (%d)\n", array->size);
+    } else {
+        // Partial Fisher-Yates over an index permutation: k draws, source left untouched
+        long long* order = (long long*)tracked_malloc((n ? n : 1) * sizeof(long long), __FILE__, __LINE__, "random_sample");
+        MycoArray* out = order ? create_array((int)count, array->is_string_array) : NULL;
+        if (out) {
+            for (size_t i = 0; i < n; i++) order[i] = (long long)i;
+            for (size_t i = 0; i < (size_t)count; i++) {
+                size_t j = i + (size_t)random_below(state, n - i);
+                long long picked = order[j];
+                order[j] = order[i];
+                order[i] = picked;
+                if (array->is_string_array) array_push(out, array->str_elements[picked]);
+                else array_push(out, &array->elements[picked]);
+            }
+            *result = return_array_result(out);
+        }
+        if (order) tracked_free(order, __FILE__, __LINE__, "random_sample");
+    }
+    if (is_temp) destroy_array(array);
+    return 1;
+}
+
+// Math Library Functions
+static long long call_math_function(const char* func_name, ASTNode* args_node) {
+    long long array_result;
+    if (call_math_array_function(func_name, args_node, &array_result)) return array_result;
+    if (call_math_random_function(func_name, args_node, &array_result)) return array_result;
+    
+    if (strcmp(func_name, "abs") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: math.abs() requires one argument\n");
+            return 0;
+        }
+        
+        long long value = eval_expression(&args_node->children[0]);
+        return value < 0 ? -value : value;
+        
+    } else if (strcmp(func_name, "pow") == 0) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: math.pow() requires two arguments\n");
+            return 0;
+        }
+        
+        long long base = eval_expression(&args_node->children[0]);
+        long long exp = eval_expression(&args_node->children[1]);
+        return (long long)pow((double)base, (double)exp);
+        
+    } else if (strcmp(func_name, "sqrt") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: math.sqrt() requires one argument\n");
+            return 0;
+        }
+        
+        long long value = eval_expression(&args_node->children[0]);
+        if (value < 0) {
+            fprintf(stderr, "Error: math.sqrt() cannot take square root of negative number\n");
+            return 0;
+        }
+        return (long long)sqrt((double)value);
+        
+    } else if (strcmp(func_name, "min") == 0) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: math.min() requires at least two arguments\n");
+            return 0;
+        }
+        
+        long long min_val = LLONG_MAX;
+        for (int i = 0; i < args_node->child_count; i++) {
+            long long value = eval_expression(&args_node->children[i]);
+            if (value < min_val) min_val = value;
+        }
+        return min_val;
         
     } else if (strcmp(func_name, "max") == 0) {
         if (args_node->child_count < 2) {
@@ -12067,6 +12964,110 @@ static long long call_args_function(const char* func_name, ASTNode* args_node) {
     }
 }
 
+// Process Execution Library Functions
+/**
+ * @brief Builds a NULL-terminated argv vector from a spawn command argument
+ * @param node Array literal/variable of arguments, or a string (shell command line)
+ * @param use_shell Set to 1 when the argument was a plain string
+ * @return Newly allocated argv (free with free_spawn_argv), or NULL on error
+ */
+static char** build_spawn_argv(ASTNode* node, int* use_shell) {
+    char* command = library_string_argument(node);
+    if (command) {
+        char** argv = (char**)tracked_malloc(2 * sizeof(char*), __FILE__, __LINE__, "spawn_argv");
+        if (!argv) {
+            tracked_free(command, __FILE__, __LINE__, "spawn_argv");
+            return NULL;
+        }
+        argv[0] = command;
+        argv[1] = NULL;
+        *use_shell = 1;
+        return argv;
+    }
+
+    int is_temporary = 0;
+    MycoArray* args = library_array_argument(node, &is_temporary);
+    if (!args || args->size == 0) {
+        if (is_temporary) destroy_array(args);
+        return NULL;
+    }
+
+    char** argv = (char**)tracked_malloc((args->size + 1) * sizeof(char*), __FILE__, __LINE__, "spawn_argv");
+    if (argv) {
+        for (int i = 0; i < args->size; i++) {
+            if (args->is_string_array) {
+                const char* arg = array_get_string(args, i);
+                argv[i] = tracked_strdup(arg ? arg : "", __FILE__, __LINE__, "spawn_argv_item");
+            } else {
+                char num_str[32];
+                snprintf(num_str, sizeof(num_str), "%lld", args->elements[i]);
+                argv[i] = tracked_strdup(num_str, __FILE__, __LINE__, "spawn_argv_item");
+            }
+        }
+        argv[args->size] = NULL;
+    }
+    if (is_temporary) destroy_array(args);
+    *use_shell = 0;
+    return argv;
+}
+
+static void free_spawn_argv(char** argv) {
+    if (!argv) return;
+    for (int i = 0; argv[i]; i++) {
+        tracked_free(argv[i], __FILE__, __LINE__, "free_spawn_argv");
+    }
+    tracked_free(argv, __FILE__, __LINE__, "free_spawn_argv");
+}
+
+// Package a finished process as {exit_code, stdout, stderr, timed_out, duration_ms, ok}
+static MycoObject* process_result_to_object(ProcessResult* result) {
+    MycoObject* obj = create_object(6);
+    if (!obj) return NULL;
+    object_set_property_typed(obj, "exit_code", (void*)(long long)result->exit_code, PROP_TYPE_NUMBER);
+    object_set_property_typed(obj, "stdout", result->stdout_data, PROP_TYPE_STRING);
+    object_set_property_typed(obj, "stderr", result->stderr_data, PROP_TYPE_STRING);
+    object_set_property_typed(obj, "timed_out", (void*)(long long)result->timed_out, PROP_TYPE_NUMBER);
+    object_set_property_typed(obj, "duration_ms", (void*)(long long)result->duration_ms, PROP_TYPE_NUMBER);
+    object_set_property_typed(obj, "ok", (void*)(long long)(!result->spawn_failed && !result->timed_out && result->exit_code == 0), PROP_TYPE_NUMBER);
+    // The object now owns the captured output strings
+    result->stdout_data = NULL;
+    result->stderr_data = NULL;
+    return obj;
+}
+
+// Split a command line on whitespace into a NULL-terminated argv (no quoting rules)
+static char** split_command_argv(const char* command) {
+    size_t len = strlen(command);
+    char** argv = (char**)tracked_malloc((len / 2 + 2) * sizeof(char*), __FILE__, __LINE__, "pool_argv");
+    if (!argv) return NULL;
+    int argc = 0;
+    const char* p = command;
+    while (*p) {
+        while (*p == ' ' || *p == '\t') p++;
+        if (!*p) break;
+        const char* start = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+        size_t word_len = (size_t)(p - start);
+        char* word = (char*)tracked_malloc(word_len + 1, __FILE__, __LINE__, "pool_argv_item");
+        if (!word) break;
+        memcpy(word, start, word_len);
+        word[word_len] = '\0';
+        argv[argc++] = word;
+    }
+    argv[argc] = NULL;
+    return argv;
+}
+
+// Default job pool width: one child per online CPU
+static int default_pool_parallelism(void) {
+#ifdef _WIN32
+    return 4;
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+#endif
+}
+
 // Process Execution Library Functions
 static long long call_process_function(const char* func_name, ASTNode* args_node) {
     if (strcmp(func_name, "execute") == 0) {
@@ -12075,46 +13076,166 @@ static long long call_process_function(const char* func_name, ASTNode* args_node
             return 0;
         }
         
-        // Get command from argument
-        ASTNode* cmd_node = &args_node->children[0];
-        if (cmd_node->type != AST_EXPR || !cmd_node->text) {
+        // execute(command) runs a shell command line with inherited stdout/stderr
+        char* command = library_string_argument(&args_node->children[0]);
+        if (!command) {
             fprintf(stderr, "Error: process.execute() command must be a string\n");
             return 0;
         }
         
-        // Extract command (remove quotes)
-        char command[2048];
-        if (is_string_literal(cmd_node->text)) {
-            size_t len = strlen(cmd_node->text);
-            if (len > 2) {
-                strncpy(command, cmd_node->text + 1, len - 2);
-                command[len - 2] = '\0';
-            } else {
-                command[0] = '\0';
-            }
-        } else {
-            strncpy(command, cmd_node->text, sizeof(command) - 1);
-            command[sizeof(command) - 1] = '\0';
+        if (command[0] == '\0') {
+            fprintf(stderr, "Error: process.execute() command cannot be empty\n");
+            tracked_free(command, __FILE__, __LINE__, "process_execute");
+            return 0;
         }
         
-        // Validate command
-        if (strlen(command) == 0) {
-            fprintf(stderr, "Error: process.execute() command cannot be empty\n");
+        char* argv[2] = { command, NULL };
+        ProcessOptions options = { 1, 0, 0 };
+        ProcessResult result;
+        process_run(argv, &options, &result);
+        process_result_free(&result);
+        tracked_free(command, __FILE__, __LINE__, "process_execute");
+        
+        return result.exit_code;
+        
+    } else if (strcmp(func_name, "spawn") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: process.spawn() requires at least one argument (argv array or command)\n");
+            return 0;
+        }
+        
+        // spawn(argv, options) runs argv directly (no shell) and captures its output;
+        // a plain string argument is run through /bin/sh -c
+        int use_shell = 0;
+        char** argv = build_spawn_argv(&args_node->children[0], &use_shell);
+        if (!argv) {
+            fprintf(stderr, "Error: process.spawn() first argument must be a non-empty array or a string\n");
             return 0;
         }
         
-        printf("Executing command: %s\n", command);
+        ProcessOptions options = { use_shell, 1, 0 };
+        if (args_node->child_count >= 2) {
+            int is_temporary = 0;
+            MycoObject* opts = library_object_argument(&args_node->children[1], &is_temporary);
+            if (opts) {
+                options.use_shell = (int)library_number_option(opts, "shell", options.use_shell);
+                options.capture_output = (int)library_number_option(opts, "capture", 1);
+                options.timeout_ms = (long)library_number_option(opts, "timeout_ms", 0);
+                if (is_temporary) library_free_temporary_object(opts);
+            }
+        }
+        if (options.use_shell && !use_shell) {
+            // Shell mode with an argv array: join it into one command line
+            size_t total = 1;
+            for (int i = 0; argv[i]; i++) total += strlen(argv[i]) + 1;
+            char* command = (char*)tracked_malloc(total, __FILE__, __LINE__, "spawn_shell_command");
+            if (command) {
+                char* dest = command;
+                for (int i = 0; argv[i]; i++) {
+                    size_t len = strlen(argv[i]);
+                    if (i > 0) *dest++ = ' ';
+                    memcpy(dest, argv[i], len);
+                    dest += len;
+                }
+                *dest = '\0';
+                free_spawn_argv(argv);
+                argv = (char**)tracked_malloc(2 * sizeof(char*), __FILE__, __LINE__, "spawn_argv");
+                argv[0] = command;
+                argv[1] = NULL;
+            }
+        }
+        
+        ProcessResult result;
+        process_run(argv, &options, &result);
+        free_spawn_argv(argv);
         
-        // Execute the command using system()
-        int result = system(command);
+        MycoObject* obj = process_result_to_object(&result);
+        process_result_free(&result);
+        return return_object_result(obj);
         
-        if (result == 0) {
-            printf("Command executed successfully (exit code: %d)\n", result);
-        } else {
-            printf("Command failed with exit code: %d\n", result);
+    } else if (strcmp(func_name, "run_pool") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: process.run_pool() requires at least one argument (array of commands)\n");
+            return 0;
         }
         
-        return result;
+        // run_pool(commands, options) runs every command with at most max_parallel
+        // children alive at once; commands run through /bin/sh -c unless shell: 0,
+        // in which case each one is split on whitespace and exec'd directly
+        int is_temporary = 0;
+        MycoArray* commands = library_array_argument(&args_node->children[0], &is_temporary);
+        if (!commands || !commands->is_string_array) {
+            fprintf(stderr, "Error: process.run_pool() first argument must be an array of command strings\n");
+            if (is_temporary) destroy_array(commands);
+            return 0;
+        }
+        
+        ProcessOptions options = { 1, 1, 0 };
+        int max_parallel = default_pool_parallelism();
+        if (args_node->child_count >= 2) {
+            int opts_temporary = 0;
+            MycoObject* opts = library_object_argument(&args_node->children[1], &opts_temporary);
+            if (opts) {
+                options.use_shell = (int)library_number_option(opts, "shell", 1);
+                options.capture_output = (int)library_number_option(opts, "capture", 1);
+                options.timeout_ms = (long)library_number_option(opts, "timeout_ms", 0);
+                max_parallel = (int)library_number_option(opts, "max_parallel", max_parallel);
+                if (opts_temporary) library_free_temporary_object(opts);
+            }
+        }
+        
+        int count = commands->size;
+        char*** argvs = (char***)tracked_malloc((count > 0 ? count : 1) * sizeof(char**), __FILE__, __LINE__, "pool_argvs");
+        ProcessResult* results = (ProcessResult*)tracked_malloc((count > 0 ? count : 1) * sizeof(ProcessResult), __FILE__, __LINE__, "pool_results");
+        if (!argvs || !results) {
+            if (argvs) tracked_free(argvs, __FILE__, __LINE__, "pool_argvs");
+            if (results) tracked_free(results, __FILE__, __LINE__, "pool_results");
+            if (is_temporary) destroy_array(commands);
+            return 0;
+        }
+        for (int i = 0; i < count; i++) {
+            const char* command = array_get_string(commands, i);
+            if (!command) command = "";
+            if (options.use_shell) {
+                argvs[i] = (char**)tracked_malloc(2 * sizeof(char*), __FILE__, __LINE__, "pool_argv");
+                if (argvs[i]) {
+                    argvs[i][0] = tracked_strdup(command, __FILE__, __LINE__, "pool_argv_item");
+                    argvs[i][1] = NULL;
+                }
+            } else {
+                argvs[i] = split_command_argv(command);
+            }
+        }
+        if (is_temporary) destroy_array(commands);
+        
+        struct timespec pool_start, pool_end;
+        clock_gettime(CLOCK_MONOTONIC, &pool_start);
+        process_run_pool((char** const*)argvs, count, &options, max_parallel, results);
+        clock_gettime(CLOCK_MONOTONIC, &pool_end);
+        
+        // Result: {count, succeeded, failed, duration_ms, ok, job_0: {...}, job_1: {...}, ...}
+        MycoObject* obj = create_object(count + 5);
+        int succeeded = 0;
+        for (int i = 0; i < count; i++) {
+            if (!results[i].spawn_failed && !results[i].timed_out && results[i].exit_code == 0) succeeded++;
+            char key[32];
+            snprintf(key, sizeof(key), "job_%d", i);
+            MycoObject* job = process_result_to_object(&results[i]);
+            process_result_free(&results[i]);
+            if (obj && job) object_set_property_typed(obj, key, job, PROP_TYPE_OBJECT);
+            free_spawn_argv(argvs[i]);
+        }
+        tracked_free(argvs, __FILE__, __LINE__, "pool_argvs");
+        tracked_free(results, __FILE__, __LINE__, "pool_results");
+        if (!obj) return 0;
+        
+        long long duration_ms = (pool_end.tv_sec - pool_start.tv_sec) * 1000LL + (pool_end.tv_nsec - pool_start.tv_nsec) / 1000000;
+        object_set_property_typed(obj, "count", (void*)(long long)count, PROP_TYPE_NUMBER);
+        object_set_property_typed(obj, "succeeded", (void*)(long long)succeeded, PROP_TYPE_NUMBER);
+        object_set_property_typed(obj, "failed", (void*)(long long)(count - succeeded), PROP_TYPE_NUMBER);
+        object_set_property_typed(obj, "duration_ms", (void*)duration_ms, PROP_TYPE_NUMBER);
+        object_set_property_typed(obj, "ok", (void*)(long long)(succeeded == count), PROP_TYPE_NUMBER);
+        return return_object_result(obj);
         
     } else if (strcmp(func_name, "get_pid") == 0) {
         if (args_node->child_count != 0) {
@@ -12215,22 +13336,189 @@ static long long call_process_function(const char* func_name, ASTNode* args_node
 }
 
 // Text Processing Utilities Library Functions
-static long long call_text_utils_function(const char* func_name, ASTNode* args_node) {
-    if (strcmp(func_name, "read_lines") == 0) {
-        if (args_node->child_count < 1) {
-            fprintf(stderr, "Error: text_utils.read_lines() requires one argument (filename)\n");
-            return 0;
-        }
-        
-        // Get filename from argument
-        ASTNode* file_node = &args_node->children[0];
-        if (file_node->type != AST_EXPR || !file_node->text) {
-            fprintf(stderr, "Error: text_utils.read_lines() filename must be a string\n");
-            return 0;
+// Compiled searchers handed out by text_utils.compile_search()
+static HandleRegistry compiled_searchers = { NULL, 0, 0 };
+
+static StringSearcher* lookup_searcher(ASTNode* handle_node, const char* caller) {
+    StringSearcher* searcher = (StringSearcher*)lookup_handle(&compiled_searchers, eval_expression(handle_node));
+    if (!searcher) fprintf(stderr, "Error: text_utils.%s() expects a searcher from compile_search()\n", caller);
+    return searcher;
+}
+
+// Compiled patterns handed out by text_utils.regex()
+static HandleRegistry compiled_patterns = { NULL, 0, 0 };
+
+static Regex* lookup_pattern(ASTNode* handle_node, const char* caller) {
+    Regex* re = (Regex*)lookup_handle(&compiled_patterns, eval_expression(handle_node));
+    if (!re) fprintf(stderr, "Error: text_utils.%s() expects a pattern from regex()\n", caller);
+    return re;
+}
+
+static char* copy_span(const char* start, size_t len) {
+    char* copy = (char*)tracked_malloc(len + 1, __FILE__, __LINE__, "text_span");
+    if (!copy) return NULL;
+    memcpy(copy, start, len);
+    copy[len] = '\0';
+    return copy;
+}
+
+// Push text[from..to) onto a string array (array_push copies it)
+static void push_span(MycoArray* array, const char* text, long from, long to) {
+    char* piece = copy_span(text + from, (size_t)(to - from));
+    if (!piece) return;
+    array_push(array, piece);
+    tracked_free(piece, __FILE__, __LINE__, "text_span");
+}
+
+/**
+ * @brief Expands a replacement template for one match
+ * @param out Output buffer, grown as needed
+ *
+ * $0..$9 insert the whole match or a capture group (empty if it did not
+ * participate) and $$ inserts a literal dollar sign.
+ */
+static int append_replacement(char** out, size_t* out_len, size_t* out_cap, const char* text,
+                              const long* groups, int group_count, const char* repl, size_t repl_len) {
+    for (size_t i = 0; i < repl_len; i++) {
+        const char* piece = repl + i;
+        size_t piece_len = 1;
+        if (repl[i] == '$' && i + 1 < repl_len) {
+            char next = repl[i + 1];
+            if (next == '$') {
+                i++;
+            } else if (next >= '0' && next <= '9') {
+                int group = next - '0';
+                i++;
+                if (group > group_count || groups[group * 2] < 0) continue;
+                piece = text + groups[group * 2];
+                piece_len = (size_t)(groups[group * 2 + 1] - groups[group * 2]);
+            }
+        }
+        if (*out_len + piece_len + 1 > *out_cap) {
+            size_t new_cap = (*out_cap ? *out_cap * 2 : 64) + piece_len;
+            char* grown = (char*)tracked_realloc(*out, new_cap, __FILE__, __LINE__, "regex_replace_result");
+            if (!grown) return 0;
+            *out = grown;
+            *out_cap = new_cap;
+        }
+        memcpy(*out + *out_len, piece, piece_len);
+        *out_len += piece_len;
+    }
+    return 1;
+}
+
+static int append_bytes(char** out, size_t* out_len, size_t* out_cap, const char* bytes, size_t len) {
+    if (*out_len + len + 1 > *out_cap) {
+        size_t new_cap = (*out_cap ? *out_cap * 2 : 64) + len;
+        char* grown = (char*)tracked_realloc(*out, new_cap, __FILE__, __LINE__, "regex_replace_result");
+        if (!grown) return 0;
+        *out = grown;
+        *out_cap = new_cap;
+    }
+    memcpy(*out + *out_len, bytes, len);
+    *out_len += len;
+    return 1;
+}
+
+// Open JSON streams handed out by text_utils.json_stream()
+static HandleRegistry json_streams = { NULL, 0, 0 };
+
+static JsonStream* lookup_json_stream(ASTNode* handle_node, const char* caller) {
+    JsonStream* stream = (JsonStream*)lookup_handle(&json_streams, eval_expression(handle_node));
+    if (!stream) fprintf(stderr, "Error: text_utils.%s() expects a stream from json_stream()\n", caller);
+    return stream;
+}
+
+// Read a whole file into a tracked, NUL-terminated buffer
+static char* read_text_file(const char* filename, size_t* out_len) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return NULL;
+    size_t capacity = 65536, len = 0;
+    char* data = (char*)tracked_malloc(capacity, __FILE__, __LINE__, "read_text_file");
+    while (data) {
+        len += fread(data + len, 1, capacity - len - 1, file);
+        if (len < capacity - 1) break;
+        char* grown = (char*)tracked_realloc(data, capacity * 2, __FILE__, __LINE__, "read_text_file");
+        if (!grown) {
+            tracked_free(data, __FILE__, __LINE__, "read_text_file");
+            data = NULL;
+            break;
         }
-        
-        // Extract filename (remove quotes)
-        char filename[1024];
+        data = grown;
+        capacity *= 2;
+    }
+    int read_failed = ferror(file);
+    fclose(file);
+    if (!data) return NULL;
+    if (read_failed) {
+        tracked_free(data, __FILE__, __LINE__, "read_text_file");
+        return NULL;
+    }
+    data[len] = '\0';
+    *out_len = len;
+    return data;
+}
+
+// Hand a parsed JSON value to let/assignment by its kind (ownership moves to the result slot; floats are reported against node)
+static long long return_json_value(ASTNode* node, JsonValue* value) {
+    switch (value->type) {
+        case JSON_VALUE_FLOAT:
+            return return_float_result(node, value->float_number);
+        case JSON_VALUE_OBJECT:
+            return return_object_result(value->object);
+        case JSON_VALUE_ARRAY:
+            return return_array_result(value->array);
+        case JSON_VALUE_STRING:
+            return return_string_result(value->string);
+        default:
+            return value->number;
+    }
+}
+
+// Serialize a library argument: object or array (variable or literal), string, or number
+static void write_json_argument(JsonWriter* writer, ASTNode* node) {
+    int is_temporary = 0;
+    MycoObject* obj = library_object_argument(node, &is_temporary);
+    if (obj) {
+        json_write_object(writer, obj);
+        if (is_temporary) library_free_temporary_object(obj);
+        return;
+    }
+    MycoArray* array = library_array_argument(node, &is_temporary);
+    if (array) {
+        json_write_array(writer, array);
+        if (is_temporary) destroy_array(array);
+        return;
+    }
+    size_t len = 0;
+    const char* str = string_argument_view(node, &len);
+    if (str) {
+        json_write_string(writer, str, len);
+        return;
+    }
+    clear_float_result();
+    long long number = eval_expression(node);
+    double float_value;
+    if (float_result_of(node, &float_value)) json_write_float(writer, float_value);
+    else json_write_number(writer, number);
+}
+
+static long long call_text_utils_function(const char* func_name, ASTNode* args_node) {
+    if (strcmp(func_name, "read_lines") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.read_lines() requires one argument (filename)\n");
+            return 0;
+        }
+        
+        // Get filename from argument
+        ASTNode* file_node = &args_node->children[0];
+        if (file_node->type != AST_EXPR || !file_node->text) {
+            fprintf(stderr, "Error: text_utils.read_lines() filename must be a string\n");
+            return 0;
+        }
+        
+        // Extract filename (remove quotes)
+        char filename[1024];
         if (is_string_literal(file_node->text)) {
             size_t len = strlen(file_node->text);
             if (len > 2) {
@@ -12490,6 +13778,337 @@ static long long call_text_utils_function(const char* func_name, ASTNode* args_n
         
         return 1;
         
+    } else if (strcmp(func_name, "compile_search") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.compile_search() requires one argument (needle)\n");
+            return 0;
+        }
+        
+        // Build the search tables once; the handle is reused across any number of haystacks
+        size_t needle_len = 0;
+        const char* needle = string_argument_view(&args_node->children[0], &needle_len);
+        if (!needle) {
+            fprintf(stderr, "Error: text_utils.compile_search() needle must be a string\n");
+            return 0;
+        }
+        StringSearcher* searcher = string_searcher_create(needle, needle_len);
+        if (!searcher) return 0;
+        long long handle = register_handle(&compiled_searchers, searcher);
+        if (!handle) string_searcher_destroy(searcher);
+        return handle;
+        
+    } else if (strcmp(func_name, "search_find") == 0 || strcmp(func_name, "search_find_all") == 0 ||
+               strcmp(func_name, "search_count") == 0 || strcmp(func_name, "search_contains") == 0) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: text_utils.%s() requires two arguments (searcher, haystack)\n", func_name);
+            return 0;
+        }
+        
+        StringSearcher* searcher = lookup_searcher(&args_node->children[0], func_name);
+        size_t haystack_len = 0;
+        const char* haystack = string_argument_view(&args_node->children[1], &haystack_len);
+        if (!searcher) return strcmp(func_name, "search_find") == 0 ? -1 : 0;
+        if (!haystack) {
+            fprintf(stderr, "Error: text_utils.%s() haystack must be a string\n", func_name);
+            return strcmp(func_name, "search_find") == 0 ? -1 : 0;
+        }
+        
+        if (strcmp(func_name, "search_find") == 0) {
+            const char* match = string_searcher_find(searcher, haystack, haystack_len);
+            return match ? (long long)(match - haystack) : -1;
+        }
+        if (strcmp(func_name, "search_contains") == 0) {
+            return string_searcher_find(searcher, haystack, haystack_len) != NULL;
+        }
+        if (strcmp(func_name, "search_count") == 0) {
+            return (long long)string_searcher_count(searcher, haystack, haystack_len);
+        }
+        
+        // search_find_all: start index of every non-overlapping match
+        MycoArray* positions = create_array((int)string_searcher_count(searcher, haystack, haystack_len), 0);
+        if (!positions) return 0;
+        const char* pos = haystack;
+        const char* end = haystack + haystack_len;
+        size_t step = searcher->needle_len ? searcher->needle_len : 1;
+        while (pos <= end && (pos = string_searcher_find(searcher, pos, (size_t)(end - pos))) != NULL) {
+            long long index = (long long)(pos - haystack);
+            array_push(positions, &index);
+            pos += step;
+        }
+        return return_array_result(positions);
+        
+    } else if (strcmp(func_name, "json_parse") == 0 || strcmp(func_name, "json_parse_file") == 0 ||
+               strcmp(func_name, "json_stream") == 0 || strcmp(func_name, "json_stream_file") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.%s() requires one argument\n", func_name);
+            return 0;
+        }
+        
+        // A file stream reads its file in chunks as elements are taken
+        if (strcmp(func_name, "json_stream_file") == 0) {
+            char* filename = library_string_argument(&args_node->children[0]);
+            if (!filename) {
+                fprintf(stderr, "Error: text_utils.%s() filename must be a string\n", func_name);
+                return 0;
+            }
+            JsonStream* stream = json_stream_open_file(filename);
+            if (!stream) fprintf(stderr, "Error: Could not read file '%s'\n", filename);
+            tracked_free(filename, __FILE__, __LINE__, "library_string_argument");
+            long long result = stream ? register_handle(&json_streams, stream) : 0;
+            if (stream && !result) json_stream_close(stream);
+            return result;
+        }
+        
+        // The parser needs NUL-terminated text: copy string arguments, read files whole
+        size_t text_len = 0;
+        char* text = NULL;
+        if (strcmp(func_name, "json_parse_file") == 0) {
+            char* filename = library_string_argument(&args_node->children[0]);
+            if (!filename) {
+                fprintf(stderr, "Error: text_utils.%s() filename must be a string\n", func_name);
+                return 0;
+            }
+            text = read_text_file(filename, &text_len);
+            if (!text) fprintf(stderr, "Error: Could not read file '%s'\n", filename);
+            tracked_free(filename, __FILE__, __LINE__, "library_string_argument");
+        } else {
+            const char* view = string_argument_view(&args_node->children[0], &text_len);
+            if (!view) {
+                fprintf(stderr, "Error: text_utils.%s() text must be a string\n", func_name);
+                return 0;
+            }
+            text = copy_span(view, text_len);
+        }
+        if (!text) return 0;
+        
+        long long result = 0;
+        if (strcmp(func_name, "json_stream") == 0) {
+            // The stream takes over the copy as its buffer
+            JsonStream* stream = json_stream_open(text, text_len);
+            result = stream ? register_handle(&json_streams, stream) : 0;
+            if (stream && !result) json_stream_close(stream);
+            return result;
+        }
+        JsonValue value;
+        char error[128];
+        if (json_parse(text, text_len, &value, error, sizeof(error))) {
+            result = return_json_value(args_node, &value);
+        } else {
+            fprintf(stderr, "Error: text_utils.%s() invalid JSON: %s\n", func_name, error);
+        }
+        tracked_free(text, __FILE__, __LINE__, "text_span");
+        return result;
+        
+    } else if (strcmp(func_name, "json_next") == 0 || strcmp(func_name, "json_has_next") == 0 ||
+               strcmp(func_name, "json_close") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.%s() requires one argument (stream)\n", func_name);
+            return 0;
+        }
+        JsonStream* stream = lookup_json_stream(&args_node->children[0], func_name);
+        if (!stream) return 0;
+        
+        if (strcmp(func_name, "json_close") == 0) {
+            release_handle(&json_streams, stream);
+            json_stream_close(stream);
+            return 1;
+        }
+        if (strcmp(func_name, "json_has_next") == 0) {
+            return json_stream_has_next(stream);
+        }
+        
+        // json_next: one element per call, 0 once the stream is exhausted
+        JsonValue value;
+        char error[128];
+        int status = json_stream_next(stream, &value, error, sizeof(error));
+        if (status < 0) fprintf(stderr, "Error: text_utils.json_next() invalid JSON: %s\n", error);
+        if (status <= 0) return 0;
+        return return_json_value(args_node, &value);
+        
+    } else if (strcmp(func_name, "json_stringify") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.json_stringify() requires one argument (value)\n");
+            return 0;
+        }
+        JsonWriter writer;
+        json_writer_init(&writer, NULL);
+        write_json_argument(&writer, &args_node->children[0]);
+        char* json = json_writer_finish(&writer, NULL);
+        if (!json) {
+            fprintf(stderr, "Error: text_utils.json_stringify() out of memory\n");
+            return 0;
+        }
+        return return_string_result(json);
+        
+    } else if (strcmp(func_name, "json_write") == 0) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: text_utils.json_write() requires two arguments (filename, value)\n");
+            return 0;
+        }
+        char* filename = library_string_argument(&args_node->children[0]);
+        if (!filename) {
+            fprintf(stderr, "Error: text_utils.json_write() filename must be a string\n");
+            return 0;
+        }
+        FILE* file = fopen(filename, "wb");
+        if (!file) {
+            fprintf(stderr, "Error: Could not open file '%s' for writing\n", filename);
+            tracked_free(filename, __FILE__, __LINE__, "library_string_argument");
+            return 0;
+        }
+        // Output goes through the writer's fixed buffer straight to the file
+        JsonWriter writer;
+        json_writer_init(&writer, file);
+        write_json_argument(&writer, &args_node->children[1]);
+        json_writer_finish(&writer, NULL);
+        int ok = !writer.failed && fputc('\n', file) != EOF;
+        if (fclose(file) != 0) ok = 0;
+        if (!ok) fprintf(stderr, "Error: Could not write file '%s'\n", filename);
+        tracked_free(filename, __FILE__, __LINE__, "library_string_argument");
+        return ok;
+        
+    } else if (strcmp(func_name, "regex") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.regex() requires one argument (pattern)\n");
+            return 0;
+        }
+        
+        // Compile once; the handle is reused by every regex_* call
+        size_t pattern_len = 0;
+        const char* pattern = string_argument_view(&args_node->children[0], &pattern_len);
+        if (!pattern) {
+            fprintf(stderr, "Error: text_utils.regex() pattern must be a string\n");
+            return 0;
+        }
+        char error[128];
+        Regex* re = regex_compile(pattern, pattern_len, error, sizeof(error));
+        if (!re) {
+            fprintf(stderr, "Error: text_utils.regex() invalid pattern: %s\n", error);
+            return 0;
+        }
+        long long handle = register_handle(&compiled_patterns, re);
+        if (!handle) regex_free(re);
+        return handle;
+        
+    } else if (strcmp(func_name, "regex_match") == 0 || strcmp(func_name, "regex_test") == 0 ||
+               strcmp(func_name, "regex_search") == 0 || strcmp(func_name, "regex_find_all") == 0 ||
+               strcmp(func_name, "regex_groups") == 0 || strcmp(func_name, "regex_split") == 0) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: text_utils.%s() requires two arguments (pattern, text)\n", func_name);
+            return 0;
+        }
+        
+        int returns_index = strcmp(func_name, "regex_search") == 0;
+        Regex* re = lookup_pattern(&args_node->children[0], func_name);
+        size_t text_len = 0;
+        const char* view = string_argument_view(&args_node->children[1], &text_len);
+        if (!re) return returns_index ? -1 : 0;
+        if (!view) {
+            fprintf(stderr, "Error: text_utils.%s() text must be a string\n", func_name);
+            return returns_index ? -1 : 0;
+        }
+        // Literal views are not NUL-terminated, and array results copy spans out of the text
+        char* text = copy_span(view, text_len);
+        if (!text) return returns_index ? -1 : 0;
+        
+        long groups[REGEX_MAX_GROUPS * 2];
+        long long result = 0;
+        if (strcmp(func_name, "regex_match") == 0) {
+            result = regex_full_match(re, text, text_len);
+        } else if (strcmp(func_name, "regex_test") == 0) {
+            result = regex_is_match(re, text, text_len);
+        } else if (returns_index) {
+            result = regex_search(re, text, text_len, 0, groups) ? groups[0] : -1;
+        } else if (strcmp(func_name, "regex_groups") == 0) {
+            // [whole match, group 1, ...]; empty when there is no match
+            MycoArray* captures = create_array(regex_group_count(re) + 1, 1);
+            if (captures && regex_search(re, text, text_len, 0, groups)) {
+                for (int g = 0; g <= regex_group_count(re); g++) {
+                    if (groups[g * 2] < 0) push_span(captures, text, 0, 0);
+                    else push_span(captures, text, groups[g * 2], groups[g * 2 + 1]);
+                }
+            }
+            result = return_array_result(captures);
+        } else {
+            // regex_find_all collects the matches, regex_split the text between them
+            int split = strcmp(func_name, "regex_split") == 0;
+            MycoArray* pieces = create_array(8, 1);
+            size_t pos = 0;
+            long field_start = 0;
+            while (pieces && pos <= text_len && regex_search(re, text, text_len, pos, groups)) {
+                if (split) push_span(pieces, text, field_start, groups[0]);
+                else push_span(pieces, text, groups[0], groups[1]);
+                field_start = groups[1];
+                // An empty match advances by one byte so the scan always makes progress
+                pos = groups[1] > groups[0] ? (size_t)groups[1] : (size_t)groups[1] + 1;
+            }
+            if (pieces && split) push_span(pieces, text, field_start, (long)text_len);
+            result = return_array_result(pieces);
+        }
+        tracked_free(text, __FILE__, __LINE__, "text_span");
+        return result;
+        
+    } else if (strcmp(func_name, "regex_replace") == 0) {
+        if (args_node->child_count < 3) {
+            fprintf(stderr, "Error: text_utils.regex_replace() requires three arguments (pattern, text, replacement)\n");
+            return 0;
+        }
+        
+        Regex* re = lookup_pattern(&args_node->children[0], func_name);
+        size_t text_len = 0, repl_len = 0;
+        const char* view = string_argument_view(&args_node->children[1], &text_len);
+        const char* repl = string_argument_view(&args_node->children[2], &repl_len);
+        if (!re) return 0;
+        if (!view || !repl) {
+            fprintf(stderr, "Error: text_utils.regex_replace() text and replacement must be strings\n");
+            return 0;
+        }
+        char* text = copy_span(view, text_len);
+        if (!text) return 0;
+        
+        // Copy the text between matches and expand the template for each match
+        long groups[REGEX_MAX_GROUPS * 2];
+        char* out = NULL;
+        size_t out_len = 0, out_cap = 0;
+        size_t pos = 0, copied = 0;
+        int ok = 1;
+        while (ok && pos <= text_len && regex_search(re, text, text_len, pos, groups)) {
+            ok = append_bytes(&out, &out_len, &out_cap, text + copied, (size_t)groups[0] - copied) &&
+                 append_replacement(&out, &out_len, &out_cap, text, groups, regex_group_count(re), repl, repl_len);
+            copied = (size_t)groups[1];
+            pos = groups[1] > groups[0] ? (size_t)groups[1] : (size_t)groups[1] + 1;
+        }
+        if (ok) ok = append_bytes(&out, &out_len, &out_cap, text + copied, text_len - copied);
+        tracked_free(text, __FILE__, __LINE__, "text_span");
+        if (!ok) {
+            if (out) tracked_free(out, __FILE__, __LINE__, "regex_replace_result");
+            return 0;
+        }
+        out[out_len] = '\0';
+        return return_string_result(out);
+        
+    } else if (strcmp(func_name, "free_regex") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.free_regex() requires one argument (pattern)\n");
+            return 0;
+        }
+        Regex* re = lookup_pattern(&args_node->children[0], func_name);
+        if (!re) return 0;
+        release_handle(&compiled_patterns, re);
+        regex_free(re);
+        return 1;
+        
+    } else if (strcmp(func_name, "free_search") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: text_utils.free_search() requires one argument (searcher)\n");
+            return 0;
+        }
+        StringSearcher* searcher = lookup_searcher(&args_node->children[0], func_name);
+        if (!searcher) return 0;
+        release_handle(&compiled_searchers, searcher);
+        string_searcher_destroy(searcher);
+        return 1;
+        
     } else {
         fprintf(stderr, "Error: Unknown text_utils function '%s'\n", func_name);
         return 0;
@@ -12950,6 +14569,214 @@ static long long call_type_system_function(const char* func_name, ASTNode* args_
     }
 }
 
+// Values a template is rendered against: an object, "key=value,..." pairs, then variables
+typedef struct {
+    MycoObject* object;
+    const char* pairs;
+    size_t pairs_len;
+    char** owned_texts;         // Formatted big integers, freed once rendering is done
+    int owned_count;
+} TemplateValues;
+
+// Keep text alive until the template has been rendered
+static const char* template_owned_text(TemplateValues* values, char* text, size_t* value_len) {
+    char** grown = (char**)tracked_realloc(values->owned_texts, (size_t)(values->owned_count + 1) * sizeof(char*),
+                                           __FILE__, __LINE__, "template_owned_texts");
+    if (!grown) {
+        tracked_free(text, __FILE__, __LINE__, "template_owned_text");
+        return NULL;
+    }
+    values->owned_texts = grown;
+    grown[values->owned_count++] = text;
+    *value_len = strlen(text);
+    return text;
+}
+
+static const char* template_property_text(void* value, PropertyType type, size_t* value_len, char* scratch) {
+    if (type == PROP_TYPE_STRING) {
+        const char* str = value ? (const char*)value : "";
+        *value_len = strlen(str);
+        return str;
+    }
+    if (type == PROP_TYPE_NUMBER) {
+        *value_len = (size_t)snprintf(scratch, TEMPLATE_SCRATCH_SIZE, "%lld", (long long)value);
+        return scratch;
+    }
+    if (type == PROP_TYPE_FLOAT) {
+        *value_len = (size_t)format_float(scratch, TEMPLATE_SCRATCH_SIZE, property_float_value(value));
+        return scratch;
+    }
+    return NULL;
+}
+
+// Slot resolver for string_template_render()
+static const char* resolve_template_slot(void* context, const char* name, size_t* value_len, char* scratch) {
+    TemplateValues* values = (TemplateValues*)context;
+
+    // Dotted path: walk nested objects from the values object or an object variable
+    const char* dot = strchr(name, '.');
+    if (dot) {
+        char head[128];
+        size_t head_len = (size_t)(dot - name);
+        if (head_len >= sizeof(head)) return NULL;
+        memcpy(head, name, head_len);
+        head[head_len] = '\0';
+        MycoObject* obj = NULL;
+        if (values->object && object_get_property_type(values->object, head) == PROP_TYPE_OBJECT) {
+            obj = (MycoObject*)object_get_property(values->object, head);
+        }
+        if (!obj) obj = get_object_value(head);
+        const char* rest = dot + 1;
+        while (obj) {
+            char segment[128];
+            const char* next = strchr(rest, '.');
+            size_t segment_len = next ? (size_t)(next - rest) : strlen(rest);
+            if (segment_len >= sizeof(segment)) return NULL;
+            memcpy(segment, rest, segment_len);
+            segment[segment_len] = '\0';
+            if (!object_has_property(obj, segment)) return NULL;
+            PropertyType type = object_get_property_type(obj, segment);
+            void* value = object_get_property(obj, segment);
+            if (!next) return template_property_text(value, type, value_len, scratch);
+            if (type != PROP_TYPE_OBJECT) return NULL;
+            obj = (MycoObject*)value;
+            rest = next + 1;
+        }
+        return NULL;
+    }
+
+    if (values->object && object_has_property(values->object, name)) {
+        return template_property_text(object_get_property(values->object, name),
+                                      object_get_property_type(values->object, name), value_len, scratch);
+    }
+
+    // "key=value" pairs separated by commas
+    size_t name_len = strlen(name);
+    const char* pos = values->pairs;
+    const char* end = values->pairs ? values->pairs + values->pairs_len : NULL;
+    while (pos && pos < end) {
+        const char* comma = (const char*)memchr(pos, ',', (size_t)(end - pos));
+        const char* pair_end = comma ? comma : end;
+        const char* equals = (const char*)memchr(pos, '=', (size_t)(pair_end - pos));
+        if (equals) {
+            const char* key = pos;
+            const char* key_end = equals;
+            while (key < key_end && *key == ' ') key++;
+            while (key_end > key && key_end[-1] == ' ') key_end--;
+            if ((size_t)(key_end - key) == name_len && memcmp(key, name, name_len) == 0) {
+                *value_len = (size_t)(pair_end - equals - 1);
+                return equals + 1;
+            }
+        }
+        pos = comma ? comma + 1 : end;
+    }
+
+    char slot_name[160];
+    snprintf(slot_name, sizeof(slot_name), "__str_result_%s", name);
+    const char* str = get_str_value(slot_name);
+    if (!str) str = get_str_value(name);
+    if (str) {
+        *value_len = strlen(str);
+        return str;
+    }
+    // Numeric variables by their typed value
+    NumericValue number;
+    if (numeric_variable(name, &number)) {
+        if (number.big) {
+            char* digits = bigint_to_string(number.big, NULL);
+            bigint_free(number.big);
+            return digits ? template_owned_text(values, digits, value_len) : NULL;
+        }
+        if (number.is_float) {
+            *value_len = (size_t)format_float(scratch, TEMPLATE_SCRATCH_SIZE, number.d);
+        } else {
+            *value_len = (size_t)snprintf(scratch, TEMPLATE_SCRATCH_SIZE, "%lld", number.i);
+        }
+        return scratch;
+    }
+    if (var_exists(name)) {
+        *value_len = (size_t)snprintf(scratch, TEMPLATE_SCRATCH_SIZE, "%lld", get_var_value(name));
+        return scratch;
+    }
+    return NULL;
+}
+
+// Render against an optional values argument (object, "key=value" string, or omitted)
+static long long render_template_with(const StringTemplate* tpl, ASTNode* values_node) {
+    TemplateValues values = { NULL, NULL, 0, NULL, 0 };
+    int is_temporary = 0;
+    if (values_node) {
+        values.object = library_object_argument(values_node, &is_temporary);
+        if (!values.object) values.pairs = string_argument_view(values_node, &values.pairs_len);
+    }
+    char* rendered = string_template_render(tpl, resolve_template_slot, &values, NULL);
+    if (is_temporary) library_free_temporary_object(values.object);
+    for (int i = 0; i < values.owned_count; i++) {
+        tracked_free(values.owned_texts[i], __FILE__, __LINE__, "template_owned_text");
+    }
+    if (values.owned_texts) tracked_free(values.owned_texts, __FILE__, __LINE__, "template_owned_texts");
+    if (!rendered) return 0;
+    return return_string_result(rendered);
+}
+
+// Templates handed out by polish.create_template()
+static HandleRegistry compiled_templates = { NULL, 0, 0 };
+
+static StringTemplate* lookup_template(ASTNode* handle_node, const char* caller) {
+    StringTemplate* tpl = (StringTemplate*)lookup_handle(&compiled_templates, eval_expression(handle_node));
+    if (!tpl) fprintf(stderr, "Error: polish.%s() expects a template from create_template()\n", caller);
+    return tpl;
+}
+
+/**
+ * Templates passed to interpolate_string() are compiled once per call site.
+ * A literal never changes, so its entry is reused as is; a template held in
+ * a variable keeps a copy of its text and is recompiled only when it differs.
+ */
+typedef struct {
+    ASTNode* node;
+    char* source;               // NULL for string literals
+    size_t source_len;
+    StringTemplate* tpl;
+} TemplateCacheEntry;
+
+#define TEMPLATE_CACHE_SIZE 256
+static TemplateCacheEntry template_cache[TEMPLATE_CACHE_SIZE];
+
+static const StringTemplate* call_site_template(ASTNode* node) {
+    size_t len = 0;
+    const char* text = string_argument_view(node, &len);
+    if (!text) return NULL;
+    int literal = is_string_literal(node->text);
+
+    TemplateCacheEntry* entry = &template_cache[((size_t)node >> 4) % TEMPLATE_CACHE_SIZE];
+    if (entry->node == node && entry->tpl) {
+        if (literal) return entry->tpl;
+        if (entry->source && entry->source_len == len && memcmp(entry->source, text, len) == 0) return entry->tpl;
+    }
+
+    // Miss (or the slot belongs to another call site): compile and take the slot over
+    StringTemplate* tpl = string_template_compile(text, len);
+    if (!tpl) return NULL;
+    char* source = NULL;
+    if (!literal) {
+        source = (char*)tracked_malloc(len + 1, __FILE__, __LINE__, "template_cache_source");
+        if (!source) {
+            string_template_free(tpl);
+            return NULL;
+        }
+        memcpy(source, text, len);
+        source[len] = '\0';
+    }
+    if (entry->tpl) string_template_free(entry->tpl);
+    if (entry->source) tracked_free(entry->source, __FILE__, __LINE__, "template_cache_source");
+    entry->node = node;
+    entry->source = source;
+    entry->source_len = len;
+    entry->tpl = tpl;
+    return tpl;
+}
+
 // Language Polish Library Functions (v1.6.0)
 static long long call_language_polish_function(const char* func_name, ASTNode* args_node) {
     if (strcmp(func_name, "enhance_lambda") == 0) {
@@ -12972,30 +14799,18 @@ static long long call_language_polish_function(const char* func_name, ASTNode* a
         return 1; // Lambda enhancement completed
         
     } else if (strcmp(func_name, "interpolate_string") == 0) {
-        if (args_node->child_count < 2) {
-            fprintf(stderr, "Error: polish.interpolate_string() requires two arguments (template, values)\n");
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: polish.interpolate_string() requires a template and optional values\n");
             return 0;
         }
         
-        // Get template and values from arguments
-        ASTNode* template_node = &args_node->children[0];
-        ASTNode* values_node = &args_node->children[1];
-        
-        if (template_node->type != AST_EXPR || !template_node->text) {
+        // Compiled once per call site, so loops only pay for rendering
+        const StringTemplate* tpl = call_site_template(&args_node->children[0]);
+        if (!tpl) {
             fprintf(stderr, "Error: polish.interpolate_string() template must be a valid string\n");
             return 0;
         }
-        
-        if (values_node->type != AST_EXPR || !values_node->text) {
-            fprintf(stderr, "Error: polish.interpolate_string() values must be a valid expression\n");
-            return 0;
-        }
-        
-        // For now, we'll simulate string interpolation
-        printf("String interpolation: %s with %s\n", template_node->text, values_node->text);
-        
-        // Return interpolation result (placeholder)
-        return 1; // String interpolation completed
+        return render_template_with(tpl, args_node->child_count > 1 ? &args_node->children[1] : NULL);
         
     } else if (strcmp(func_name, "create_template") == 0) {
         if (args_node->child_count < 1) {
@@ -13003,18 +14818,37 @@ static long long call_language_polish_function(const char* func_name, ASTNode* a
             return 0;
         }
         
-        // Get template string from argument
-        ASTNode* template_node = &args_node->children[0];
-        if (template_node->type != AST_EXPR || !template_node->text) {
+        size_t len = 0;
+        const char* text = string_argument_view(&args_node->children[0], &len);
+        if (!text) {
             fprintf(stderr, "Error: polish.create_template() argument must be a valid template string\n");
             return 0;
         }
+        StringTemplate* tpl = string_template_compile(text, len);
+        if (!tpl) return 0;
+        long long handle = register_handle(&compiled_templates, tpl);
+        if (!handle) string_template_free(tpl);
+        return handle;
         
-        // For now, we'll simulate template creation
-        printf("Template creation: %s\n", template_node->text);
+    } else if (strcmp(func_name, "render_template") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: polish.render_template() requires a template and optional values\n");
+            return 0;
+        }
+        StringTemplate* tpl = lookup_template(&args_node->children[0], func_name);
+        if (!tpl) return 0;
+        return render_template_with(tpl, args_node->child_count > 1 ? &args_node->children[1] : NULL);
         
-        // Return template creation result (placeholder)
-        return 1; // Template creation completed
+    } else if (strcmp(func_name, "free_template") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: polish.free_template() requires one argument (template)\n");
+            return 0;
+        }
+        StringTemplate* tpl = lookup_template(&args_node->children[0], func_name);
+        if (!tpl) return 0;
+        release_handle(&compiled_templates, tpl);
+        string_template_free(tpl);
+        return 1;
         
     } else if (strcmp(func_name, "enable_enhanced_lambdas") == 0) {
         if (args_node->child_count != 0) {
@@ -13078,6 +14912,131 @@ static long long call_language_polish_function(const char* func_name, ASTNode* a
     }
 }
 
+/*******************************************************************************
+ * BENCHMARK HARNESS
+ ******************************************************************************/
+
+#define BENCH_MAX_SAMPLES 1000
+#define BENCH_MAX_ITERATIONS (1LL << 40)
+
+// Runs the benchmarked body iterations times; returns the elapsed nanoseconds
+static double bench_batch(ASTNode* lambda, ASTNode* function, long long iterations) {
+    double start = bench_now_ns();
+    for (long long i = 0; i < iterations && !error_occurred; i++) {
+        if (lambda) execute_lambda(lambda, NULL);
+        else eval_user_function_call(function, NULL);
+    }
+    return bench_now_ns() - start;
+}
+
+static void bench_set_number(MycoObject* result, const char* name, double value) {
+    object_set_property_typed(result, name, (void*)(long long)llround(value), PROP_TYPE_NUMBER);
+}
+
+/**
+ * @brief test.bench(name, body, options?) - statistical benchmark of a zero-argument lambda or function
+ * @return An object with samples, iterations and min/median/mean/stddev/p99 in ns, plus ops_per_sec
+ *
+ * Options: warmup (default 3 batches), samples (default 5), iterations per
+ * sample (default: calibrated so one sample takes at least min_time_ms,
+ * default 10) and json (1 prints a JSON record instead of the text report).
+ */
+static long long run_benchmark(ASTNode* args_node) {
+    if (args_node->child_count < 2) {
+        fprintf(stderr, "Error: test.bench() requires at least two arguments (name, body)\n");
+        return 0;
+    }
+    
+    char* name = library_string_argument(&args_node->children[0]);
+    if (!name) {
+        fprintf(stderr, "Error: test.bench() name must be a string\n");
+        return 0;
+    }
+    
+    // The body is a () => expression lambda (by name or inline) or a user function with no parameters
+    ASTNode* body_node = &args_node->children[1];
+    ASTNode* lambda = body_node->type == AST_LAMBDA ? body_node : get_lambda_value(body_node->text);
+    ASTNode* function = !lambda && body_node->text ? find_function_global(body_node->text) : NULL;
+    if (lambda && (lambda->child_count < 2 || !lambda->children[0].text ||
+                   strcmp(lambda->children[0].text, "params") != 0 || lambda->children[0].child_count != 0)) {
+        fprintf(stderr, "Error: test.bench() lambda must take no parameters\n");
+        tracked_free(name, __FILE__, __LINE__, "bench_name");
+        return 0;
+    }
+    if (!lambda && !function) {
+        fprintf(stderr, "Error: test.bench() body must be a lambda or function\n");
+        tracked_free(name, __FILE__, __LINE__, "bench_name");
+        return 0;
+    }
+    
+    int options_temporary = 0;
+    MycoObject* options = args_node->child_count > 2 ? library_object_argument(&args_node->children[2], &options_temporary) : NULL;
+    long long warmup = library_number_option(options, "warmup", 3);
+    long long samples = library_number_option(options, "samples", 5);
+    long long iterations = library_number_option(options, "iterations", 0);
+    long long min_time_ms = library_number_option(options, "min_time_ms", 10);
+    int as_json = library_number_option(options, "json", 0) != 0;
+    if (options_temporary) library_free_temporary_object(options);
+    if (samples < 1) samples = 1;
+    if (samples > BENCH_MAX_SAMPLES) samples = BENCH_MAX_SAMPLES;
+    if (warmup < 0) warmup = 0;
+    
+    // Calibrate: grow the batch until one takes min_time_ms, so the clock's resolution is noise
+    if (iterations < 1) {
+        double target_ns = (double)(min_time_ms > 0 ? min_time_ms : 1) * 1e6;
+        iterations = 1;
+        for (;;) {
+            double elapsed = bench_batch(lambda, function, iterations);
+            if (error_occurred || elapsed >= target_ns || iterations >= BENCH_MAX_ITERATIONS) break;
+            iterations *= elapsed * 10 < target_ns ? 10 : 2;
+        }
+    }
+    
+    for (long long i = 0; i < warmup && !error_occurred; i++) {
+        bench_batch(lambda, function, iterations);
+    }
+    
+    double per_op_ns[BENCH_MAX_SAMPLES];
+    int taken = 0;
+    while (taken < samples && !error_occurred) {
+        per_op_ns[taken++] = bench_batch(lambda, function, iterations) / (double)iterations;
+    }
+    if (error_occurred) {
+        tracked_free(name, __FILE__, __LINE__, "bench_name");
+        return 0;
+    }
+    
+    BenchSummary summary;
+    bench_summarize(per_op_ns, taken, iterations, &summary);
+    if (as_json) {
+        char* json = bench_summary_json(name, &summary);
+        if (json) {
+            printf("%s\n", json);
+            tracked_free(json, __FILE__, __LINE__, "bench_json");
+        }
+    } else {
+        printf("    Benchmark %s: median %.1f ns/op (min %.1f, mean %.1f +/- %.1f, p99 %.1f), %.0f ops/sec [%d x %lld]\n",
+               name, summary.median_ns, summary.min_ns, summary.mean_ns, summary.stddev_ns, summary.p99_ns,
+               summary.ops_per_sec, summary.samples, summary.iterations);
+    }
+    
+    MycoObject* result = create_object(10);
+    if (!result) {
+        tracked_free(name, __FILE__, __LINE__, "bench_name");
+        return 0;
+    }
+    object_set_property_typed(result, "name", name, PROP_TYPE_STRING);
+    bench_set_number(result, "samples", summary.samples);
+    bench_set_number(result, "iterations", (double)summary.iterations);
+    bench_set_number(result, "min_ns", summary.min_ns);
+    bench_set_number(result, "median_ns", summary.median_ns);
+    bench_set_number(result, "mean_ns", summary.mean_ns);
+    bench_set_number(result, "stddev_ns", summary.stddev_ns);
+    bench_set_number(result, "p99_ns", summary.p99_ns);
+    bench_set_number(result, "ops_per_sec", summary.ops_per_sec);
+    return return_object_result(result);
+}
+
 // Testing Framework Library Functions (v1.6.0)
 static long long call_testing_framework_function(const char* func_name, ASTNode* args_node) {
     if (strcmp(func_name, "describe") == 0) {
@@ -13293,7 +15252,7 @@ static long long call_testing_framework_function(const char* func_name, ASTNode*
         
         // Start benchmark timing
         benchmark_mode = 1;
-        benchmark_start_time = clock();
+        benchmark_start_time = bench_now_ns();
         
         printf("    Benchmark started: %s\n", benchmark_name);
         
@@ -13310,15 +15269,17 @@ static long long call_testing_framework_function(const char* func_name, ASTNode*
             return 0;
         }
         
-        // Stop benchmark timing and calculate elapsed time
-        clock_t end_time = clock();
-        double elapsed_time = ((double)(end_time - benchmark_start_time)) / CLOCKS_PER_SEC * 1000.0;
+        // Stop benchmark timing and calculate elapsed wall-clock time
+        double elapsed_time = (bench_now_ns() - benchmark_start_time) / 1e6;
         
         benchmark_mode = 0;
         
         printf("    Benchmark completed: %.2f ms\n", elapsed_time);
         return (long long)(elapsed_time * 1000); // Return in microseconds for precision
         
+    } else if (strcmp(func_name, "bench") == 0) {
+        return run_benchmark(args_node);
+        
     } else if (strcmp(func_name, "get_test_stats") == 0) {
         if (args_node->child_count != 0) {
             fprintf(stderr, "Error: test.get_test_stats() takes no arguments\n");
@@ -13362,8 +15323,1021 @@ static long long call_testing_framework_function(const char* func_name, ASTNode*
     }
 }
 
+/*******************************************************************************
+ * DATA STRUCTURE HANDLES
+ ******************************************************************************/
+
+// Native structures handed out by the data library
+static HandleRegistry hash_table_handles = { NULL, 0, 0 };
+static HandleRegistry priority_queue_handles = { NULL, 0, 0 };
+static HandleRegistry deque_handles = { NULL, 0, 0 };
+static HandleRegistry btree_handles = { NULL, 0, 0 };
+static HandleRegistry bitset_handles = { NULL, 0, 0 };
+static HandleRegistry bloom_handles = { NULL, 0, 0 };
+static HandleRegistry matrix_handles = { NULL, 0, 0 };
+
+/**
+ * @brief Resolves a handle argument of a data function
+ * @param kind Structure name for the error message (e.g. "hash table")
+ * @return The structure, or NULL (reported) if the argument is missing or not a live handle
+ */
+static void* handle_argument(HandleRegistry* registry, ASTNode* args_node, int index, const char* caller, const char* kind) {
+    long long handle = args_node->child_count > index ? eval_expression(&args_node->children[index]) : 0;
+    void* item = lookup_handle(registry, handle);
+    if (!item) fprintf(stderr, "Error: data.%s() expects a %s handle\n", caller, kind);
+    return item;
+}
+
+/**
+ * @brief Evaluates an argument that may be a number or a string
+ * @param caller Function name for the error message
+ * @param text Set to the string (tracked, caller frees) when the argument is one
+ * @param number Set to the value when the argument is a number
+ * @return 1 for a string, 0 for an integer, -1 (reported) for a float or an integer beyond 64 bits, which no data structure stores
+ */
+static int library_scalar_argument(ASTNode* node, const char* caller, char** text, long long* number) {
+    *text = NULL;
+    *number = 0;
+    NumericValue num;
+    int is_float = 0, is_big = 0;
+    if (node->type == AST_EXPR && node->text && node->child_count == 0 && numeric_variable(node->text, &num)) {
+        if (num.big) {
+            bigint_free(num.big);
+            is_big = 1;
+        }
+        is_float = num.is_float;
+        *number = num.i;
+    } else if ((*text = library_string_argument(node)) != NULL) {
+        return 1;
+    } else {
+        clear_float_result();
+        *number = eval_expression(node);
+        is_float = float_result_of(node, &num.d);
+        is_big = big_integer_value(node);
+    }
+    if (is_float || is_big) {
+        fprintf(stderr, is_float ? "Error: data.%s() takes integers and strings, not floats\n"
+                                 : "Error: data.%s() takes integers that fit in 64 bits\n", caller);
+        *number = 0;
+        return -1;
+    }
+    long long value = *number;
+    if (value == -1) {
+        // Only the library call that built the string hands one over; any other -1 is a number
+        char* str = take_library_string(node);
+        if (str) {
+            *text = str;
+            return 1;
+        }
+    }
+    *number = value;
+    return 0;
+}
+
+// Hand a stored number or string back to the caller (the text is copied)
+static long long library_scalar_result(int is_string, long long number, const char* text) {
+    if (!is_string) return number;
+    return return_string_result(tracked_strdup(text ? text : "", __FILE__, __LINE__, "library_scalar_result"));
+}
+
+// Key argument of a hash table function; *owned is the text to free afterwards. Returns 0 for a float or big key (reported)
+static int hash_key_argument(ASTNode* node, const char* caller, HashKey* key, char** owned) {
+    memset(key, 0, sizeof(HashKey));
+    int kind = library_scalar_argument(node, caller, owned, &key->number);
+    key->is_string = kind > 0;
+    if (key->is_string) {
+        key->text = *owned;
+        key->length = strlen(*owned);
+    }
+    return kind >= 0;
+}
+
+// Array of every key (keys_only) or value; strings win when the kinds are mixed
+static MycoArray* hash_table_collect(const HashTable* table, int keys_only) {
+    size_t cursor = 0;
+    const HashKey* key;
+    const HashValue* value;
+    int any_string = 0;
+    while (hash_table_next(table, &cursor, &key, &value)) {
+        if (keys_only ? key->is_string : value->is_string) {
+            any_string = 1;
+            break;
+        }
+    }
+    int size = (int)hash_table_size(table);
+    MycoArray* array = create_array(size > 0 ? size : 1, any_string);
+    if (!array) return NULL;
+    cursor = 0;
+    while (hash_table_next(table, &cursor, &key, &value)) {
+        int is_string = keys_only ? key->is_string : value->is_string;
+        long long number = keys_only ? key->number : value->number;
+        if (!any_string) {
+            array_push(array, &number);
+        } else if (is_string) {
+            array_push(array, (void*)(keys_only ? key->text : value->text));
+        } else {
+            char num_str[32];
+            snprintf(num_str, sizeof(num_str), "%lld", number);
+            array_push(array, num_str);
+        }
+    }
+    return array;
+}
+
+/**
+ * @brief Hash table functions of the data library (d.hash_put, d.hash_get, ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through
+ *
+ * Tables come from data.create_hash_table() and are addressed by handle.
+ * Keys are integers or strings; values are numbers or strings.
+ */
+static int call_hash_table_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+    if (strncmp(func_name, "hash_", 5) != 0 && strcmp(func_name, "free_hash_table") != 0) return 0;
+
+    int needs_key = strcmp(func_name, "hash_put") == 0 || strcmp(func_name, "hash_get") == 0 ||
+                    strcmp(func_name, "hash_contains") == 0 || strcmp(func_name, "hash_remove") == 0;
+    int needs_value = strcmp(func_name, "hash_put") == 0;
+    if (!needs_key && strcmp(func_name, "hash_size") != 0 && strcmp(func_name, "hash_keys") != 0 &&
+        strcmp(func_name, "hash_values") != 0 && strcmp(func_name, "hash_clear") != 0 &&
+        strcmp(func_name, "free_hash_table") != 0) {
+        return 0;
+    }
+    int needed = 1 + needs_key + needs_value;
+    if (args_node->child_count < needed) {
+        fprintf(stderr, "Error: data.%s() requires %s\n", func_name,
+                needs_value ? "three arguments (table, key, value)" : needs_key ? "two arguments (table, key)" : "one argument (table)");
+        return 1;
+    }
+    HashTable* table = (HashTable*)handle_argument(&hash_table_handles, args_node, 0, func_name, "hash table");
+    if (!table) return 1;
+
+    if (!needs_key) {
+        if (strcmp(func_name, "hash_size") == 0) {
+            *result = (long long)hash_table_size(table);
+        } else if (strcmp(func_name, "hash_keys") == 0 || strcmp(func_name, "hash_values") == 0) {
+            *result = return_array_result(hash_table_collect(table, func_name[5] == 'k'));
+        } else if (strcmp(func_name, "hash_clear") == 0) {
+            hash_table_clear(table);
+            *result = 1;
+        } else {
+            release_handle(&hash_table_handles, table);
+            hash_table_free(table);
+            *result = 1;
+        }
+        return 1;
+    }
+
+    char* key_text = NULL;
+    HashKey key;
+    if (!hash_key_argument(&args_node->children[1], func_name, &key, &key_text)) return 1;
+
+    if (needs_value) {
+        HashValue value;
+        int kind = library_scalar_argument(&args_node->children[2], func_name, &value.text, &value.number);
+        value.is_string = kind > 0;
+        if (kind >= 0) *result = hash_table_put(table, &key, &value);
+        if (value.text) tracked_free(value.text, __FILE__, __LINE__, "hash_put_value");
+    } else if (strcmp(func_name, "hash_get") == 0) {
+        HashValue* value = hash_table_get(table, &key);
+        if (value) {
+            *result = library_scalar_result(value->is_string, value->number, value->text);
+        } else if (args_node->child_count > 2) {
+            // Missing key: the optional default is evaluated like any other value
+            char* text = NULL;
+            long long number;
+            if (library_scalar_argument(&args_node->children[2], func_name, &text, &number) > 0) *result = return_string_result(text);
+            else *result = number;
+        }
+    } else if (strcmp(func_name, "hash_contains") == 0) {
+        *result = hash_table_get(table, &key) != NULL;
+    } else {
+        *result = hash_table_remove(table, &key);
+    }
+    if (key_text) tracked_free(key_text, __FILE__, __LINE__, "hash_key_argument");
+    return 1;
+}
+
+// Ordering argument of create_priority_queue/pq_heapify: "max" orders largest first, anything else smallest first
+static int priority_order_argument(ASTNode* args_node, int index, const char* caller) {
+    if (args_node->child_count <= index) return 0;
+    char* text = NULL;
+    long long number;
+    int is_max = 0;
+    if (library_scalar_argument(&args_node->children[index], caller, &text, &number) > 0) {
+        is_max = strcmp(text, "max") == 0;
+        tracked_free(text, __FILE__, __LINE__, "priority_order_argument");
+    }
+    return is_max;
+}
+
+
+/**
+ * @brief Priority queue functions of the data library (d.pq_push, d.pq_pop, ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through
+ *
+ * Queues come from data.create_priority_queue() or data.pq_heapify() and
+ * are addressed by handle. pq_push(queue, priority, payload) takes a
+ * number or string payload, which defaults to the priority itself.
+ */
+static int call_priority_queue_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+
+    if (strcmp(func_name, "pq_heapify") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: data.pq_heapify() requires one argument (array)\n");
+            return 1;
+        }
+        int is_temp = 0;
+        MycoArray* array = library_array_argument(&args_node->children[0], &is_temp);
+        if (!array || array->is_string_array) {
+            fprintf(stderr, "Error: data.pq_heapify() requires an array of numbers\n");
+            if (array && is_temp) destroy_array(array);
+            return 1;
+        }
+        PriorityQueue* queue = priority_queue_heapify(priority_order_argument(args_node, 1, func_name), array->elements, (size_t)array->size);
+        if (is_temp) destroy_array(array);
+        if (!queue) return 1;
+        *result = register_handle(&priority_queue_handles, queue);
+        if (!*result) priority_queue_free(queue);
+        else priority_queue_mode = 1;
+        return 1;
+    }
+
+    int is_push = strcmp(func_name, "pq_push") == 0;
+    if (!is_push && strcmp(func_name, "pq_pop") != 0 && strcmp(func_name, "pq_peek") != 0 &&
+        strcmp(func_name, "pq_peek_priority") != 0 && strcmp(func_name, "pq_size") != 0 &&
+        strcmp(func_name, "free_priority_queue") != 0) {
+        return 0;
+    }
+    if (args_node->child_count < (is_push ? 2 : 1)) {
+        fprintf(stderr, "Error: data.%s() requires %s\n", func_name, is_push ? "two arguments (queue, priority)" : "one argument (queue)");
+        return 1;
+    }
+    PriorityQueue* queue = (PriorityQueue*)handle_argument(&priority_queue_handles, args_node, 0, func_name, "priority queue");
+    if (!queue) return 1;
+
+    if (is_push) {
+        PriorityItem item;
+        item.priority = eval_expression(&args_node->children[1]);
+        item.is_string = 0;
+        item.number = item.priority;
+        item.text = NULL;
+        if (args_node->child_count > 2) {
+            int kind = library_scalar_argument(&args_node->children[2], func_name, &item.text, &item.number);
+            if (kind < 0) return 1;
+            item.is_string = kind;
+        }
+        if (priority_queue_push(queue, &item)) *result = (long long)queue->size;
+        if (item.text) tracked_free(item.text, __FILE__, __LINE__, "pq_push_payload");
+    } else if (strcmp(func_name, "pq_size") == 0) {
+        *result = (long long)queue->size;
+    } else if (strcmp(func_name, "free_priority_queue") == 0) {
+        release_handle(&priority_queue_handles, queue);
+        priority_queue_free(queue);
+        *result = 1;
+    } else if (queue->size == 0) {
+        fprintf(stderr, "Error: data.%s() on an empty priority queue\n", func_name);
+    } else if (strcmp(func_name, "pq_peek_priority") == 0) {
+        *result = priority_queue_peek(queue)->priority;
+    } else if (strcmp(func_name, "pq_peek") == 0) {
+        const PriorityItem* item = priority_queue_peek(queue);
+        *result = library_scalar_result(item->is_string, item->number, item->text);
+    } else {
+        PriorityItem item;
+        priority_queue_pop(queue, &item);
+        *result = library_scalar_result(item.is_string, item.number, item.text);
+        if (item.is_string) tracked_free(item.text, __FILE__, __LINE__, "priority_queue_payload");
+    }
+    return 1;
+}
+
+/**
+ * @brief Deque functions of the data library (d.deque_push_back, d.deque_pop_front, ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through
+ *
+ * Deques come from data.create_linked_list() and are addressed by handle.
+ * Elements are numbers or strings; deque_get/deque_set take an index from
+ * the front, or from the back when negative.
+ */
+static int call_deque_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+    if (strncmp(func_name, "deque_", 6) != 0 && strcmp(func_name, "free_deque") != 0) return 0;
+    const char* op = func_name + 6;
+
+    int is_push = strcmp(op, "push_back") == 0 || strcmp(op, "push_front") == 0;
+    int is_pop = strcmp(op, "pop_back") == 0 || strcmp(op, "pop_front") == 0;
+    int is_peek = strcmp(op, "front") == 0 || strcmp(op, "back") == 0;
+    int is_get = strcmp(op, "get") == 0;
+    int is_set = strcmp(op, "set") == 0;
+    int is_other = strcmp(op, "size") == 0 || strcmp(op, "to_array") == 0 || strcmp(op, "clear") == 0 ||
+                   strcmp(func_name, "free_deque") == 0;
+    if (!is_push && !is_pop && !is_peek && !is_get && !is_set && !is_other) return 0;
+
+    int needed = is_set ? 3 : (is_push || is_get) ? 2 : 1;
+    if (args_node->child_count < needed) {
+        fprintf(stderr, "Error: data.%s() requires %s\n", func_name,
+                is_set ? "three arguments (deque, index, value)" : is_push ? "two arguments (deque, value)" :
+                is_get ? "two arguments (deque, index)" : "one argument (deque)");
+        return 1;
+    }
+    Deque* deque = (Deque*)handle_argument(&deque_handles, args_node, 0, func_name, "deque");
+    if (!deque) return 1;
+
+    if (is_push || is_set) {
+        size_t index = 0;
+        if (is_set) {
+            long long raw = eval_expression(&args_node->children[1]);
+            if (raw < 0) raw += (long long)deque->size;
+            if (raw < 0 || raw >= (long long)deque->size) {
+                fprintf(stderr, "Error: data.deque_set() index out of range\n");
+                return 1;
+            }
+            index = (size_t)raw;
+        }
+        DequeItem item;
+        int kind = library_scalar_argument(&args_node->children[is_set ? 2 : 1], func_name, &item.text, &item.number);
+        if (kind < 0) return 1;
+        item.is_string = kind;
+        int ok;
+        if (is_set) ok = deque_set(deque, index, &item);
+        else if (op[5] == 'b') ok = deque_push_back(deque, &item);
+        else ok = deque_push_front(deque, &item);
+        if (item.text) tracked_free(item.text, __FILE__, __LINE__, "deque_argument");
+        *result = ok ? (is_set ? 1 : (long long)deque->size) : 0;
+    } else if (is_pop || is_peek || is_get) {
+        if (deque->size == 0) {
+            fprintf(stderr, "Error: data.%s() on an empty deque\n", func_name);
+            return 1;
+        }
+        if (is_pop) {
+            DequeItem item;
+            if (op[4] == 'b') deque_pop_back(deque, &item);
+            else deque_pop_front(deque, &item);
+            *result = library_scalar_result(item.is_string, item.number, item.text);
+            if (item.is_string) tracked_free(item.text, __FILE__, __LINE__, "deque_item");
+        } else {
+            long long raw = is_get ? eval_expression(&args_node->children[1]) : op[0] == 'b' ? -1 : 0;
+            if (raw < 0) raw += (long long)deque->size;
+            DequeItem* item = raw >= 0 ? deque_at(deque, (size_t)raw) : NULL;
+            if (!item) {
+                fprintf(stderr, "Error: data.deque_get() index out of range\n");
+                return 1;
+            }
+            *result = library_scalar_result(item->is_string, item->number, item->text);
+        }
+    } else if (strcmp(op, "size") == 0) {
+        *result = (long long)deque->size;
+    } else if (strcmp(op, "to_array") == 0) {
+        // Front-to-back copy; strings win when the element kinds are mixed
+        int any_string = 0;
+        for (size_t i = 0; i < deque->size && !any_string; i++) any_string = deque_at(deque, i)->is_string;
+        MycoArray* array = create_array(deque->size > 0 ? (int)deque->size : 1, any_string);
+        if (!array) return 1;
+        for (size_t i = 0; i < deque->size; i++) {
+            DequeItem* item = deque_at(deque, i);
+            if (!any_string) {
+                array_push(array, &item->number);
+            } else if (item->is_string) {
+                array_push(array, item->text);
+            } else {
+                char num_str[32];
+                snprintf(num_str, sizeof(num_str), "%lld", item->number);
+                array_push(array, num_str);
+            }
+        }
+        *result = return_array_result(array);
+    } else if (strcmp(op, "clear") == 0) {
+        deque_clear(deque);
+        *result = 1;
+    } else {
+        release_handle(&deque_handles, deque);
+        deque_free(deque);
+        *result = 1;
+    }
+    return 1;
+}
+
+// Key or value argument of a tree function; the caller frees item->text when it is a string. Returns 0 for a float or big integer (reported)
+static int tree_item_argument(ASTNode* node, const char* caller, BTreeItem* item) {
+    int kind = library_scalar_argument(node, caller, &item->text, &item->number);
+    item->is_string = kind > 0;
+    return kind >= 0;
+}
+
+static void free_tree_item_argument(BTreeItem* item) {
+    if (item->text) tracked_free(item->text, __FILE__, __LINE__, "tree_item_argument");
+}
+
+// Keys (keys_only) or values in ascending key order from lo up to hi (either may be NULL for unbounded)
+static MycoArray* btree_collect(const BTree* tree, const BTreeItem* lo, const BTreeItem* hi, int keys_only) {
+    BTreeIterator it;
+    const BTreeItem* key;
+    const BTreeItem* value;
+    int any_string = 0;
+    int count = 0;
+    btree_iter_seek(tree, &it, lo);
+    while (btree_iter_next(&it, &key, &value) && (!hi || btree_compare(key, hi) <= 0)) {
+        if ((keys_only ? key : value)->is_string) any_string = 1;
+        count++;
+    }
+    MycoArray* array = create_array(count > 0 ? count : 1, any_string);
+    if (!array) return NULL;
+    btree_iter_seek(tree, &it, lo);
+    for (int i = 0; i < count && btree_iter_next(&it, &key, &value); i++) {
+        const BTreeItem* item = keys_only ? key : value;
+        if (!any_string) {
+            long long number = item->number;
+            array_push(array, &number);
+        } else if (item->is_string) {
+            array_push(array, item->text);
+        } else {
+            char num_str[32];
+            snprintf(num_str, sizeof(num_str), "%lld", item->number);
+            array_push(array, num_str);
+        }
+    }
+    return array;
+}
+
+// Element i of a Myco array as a tree item (text borrowed from the array)
+static BTreeItem tree_item_of_array(const MycoArray* array, int i) {
+    BTreeItem item;
+    item.is_string = array->is_string_array;
+    item.number = array->is_string_array ? 0 : array->elements[i];
+    item.text = array->is_string_array ? array->str_elements[i] : NULL;
+    return item;
+}
+
+/**
+ * @brief Builds a tree from a keys array and an optional values array
+ *
+ * Sorted keys are bulk-loaded into packed nodes in one pass; anything
+ * else is inserted one key at a time (later duplicates win).
+ */
+static BTree* tree_from_arrays(const MycoArray* keys, const MycoArray* values) {
+    int n = keys->size;
+    BTreeItem* key_items = (BTreeItem*)tracked_malloc((n > 0 ? n : 1) * sizeof(BTreeItem), __FILE__, __LINE__, "tree_bulk_load");
+    BTreeItem* value_items = (BTreeItem*)tracked_malloc((n > 0 ? n : 1) * sizeof(BTreeItem), __FILE__, __LINE__, "tree_bulk_load");
+    BTree* tree = NULL;
+    if (key_items && value_items) {
+        for (int i = 0; i < n; i++) {
+            key_items[i] = tree_item_of_array(keys, i);
+            value_items[i] = values && i < values->size ? tree_item_of_array(values, i) : key_items[i];
+        }
+        tree = btree_bulk_load(key_items, value_items, (size_t)n);
+        if (!tree && (tree = btree_create()) != NULL) {
+            for (int i = 0; i < n; i++) {
+                if (!btree_put(tree, &key_items[i], &value_items[i])) {
+                    btree_free(tree);
+                    tree = NULL;
+                    break;
+                }
+            }
+        }
+    }
+    if (key_items) tracked_free(key_items, __FILE__, __LINE__, "tree_bulk_load");
+    if (value_items) tracked_free(value_items, __FILE__, __LINE__, "tree_bulk_load");
+    return tree;
+}
+
+/**
+ * @brief Ordered map functions of the data library (d.tree_put, d.tree_range, ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through
+ *
+ * Trees come from data.create_binary_tree() or data.tree_bulk_load() and
+ * are addressed by handle. Keys are numbers or strings (numbers sort
+ * first); tree_get, tree_floor and tree_ceiling return 0, or an optional
+ * default, when there is no such key.
+ */
+static int call_btree_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+    if (strncmp(func_name, "tree_", 5) != 0 && strcmp(func_name, "free_tree") != 0) return 0;
+    const char* op = func_name + 5;
+
+    if (strcmp(op, "bulk_load") == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: data.tree_bulk_load() requires one argument (keys)\n");
+            return 1;
+        }
+        int keys_temp = 0, values_temp = 0;
+        MycoArray* keys = library_array_argument(&args_node->children[0], &keys_temp);
+        MycoArray* values = args_node->child_count > 1 ? library_array_argument(&args_node->children[1], &values_temp) : NULL;
+        if (!keys) {
+            fprintf(stderr, "Error: data.tree_bulk_load() requires an array of keys\n");
+        } else {
+            BTree* tree = tree_from_arrays(keys, values);
+            if (tree) {
+                *result = register_handle(&btree_handles, tree);
+                if (!*result) btree_free(tree);
+                else binary_tree_mode = 1;
+            }
+        }
+        if (keys && keys_temp) destroy_array(keys);
+        if (values && values_temp) destroy_array(values);
+        return 1;
+    }
+
+    int is_put = strcmp(op, "put") == 0;
+    int is_lookup = strcmp(op, "get") == 0 || strcmp(op, "floor") == 0 || strcmp(op, "ceiling") == 0;
+    int is_keyed = is_put || is_lookup || strcmp(op, "contains") == 0 || strcmp(op, "remove") == 0;
+    int is_range = strcmp(op, "range") == 0 || strcmp(op, "range_values") == 0;
+    int is_other = strcmp(op, "size") == 0 || strcmp(op, "min") == 0 || strcmp(op, "max") == 0 ||
+                   strcmp(op, "keys") == 0 || strcmp(op, "values") == 0 || strcmp(func_name, "free_tree") == 0;
+    if (!is_keyed && !is_range && !is_other) return 0;
+
+    int needed = (is_put || is_range) ? 3 : is_keyed ? 2 : 1;
+    if (args_node->child_count < needed) {
+        fprintf(stderr, "Error: data.%s() requires %s\n", func_name,
+                is_put ? "three arguments (tree, key, value)" : is_range ? "three arguments (tree, low, high)" :
+                is_keyed ? "two arguments (tree, key)" : "one argument (tree)");
+        return 1;
+    }
+    BTree* tree = (BTree*)handle_argument(&btree_handles, args_node, 0, func_name, "tree");
+    if (!tree) return 1;
+
+    if (is_range) {
+        BTreeItem lo, hi;
+        int bounded = tree_item_argument(&args_node->children[1], func_name, &lo);
+        bounded = tree_item_argument(&args_node->children[2], func_name, &hi) && bounded;
+        if (bounded) *result = return_array_result(btree_collect(tree, &lo, &hi, op[5] == '\0'));
+        free_tree_item_argument(&lo);
+        free_tree_item_argument(&hi);
+    } else if (is_keyed) {
+        BTreeItem key;
+        if (!tree_item_argument(&args_node->children[1], func_name, &key)) return 1;
+        if (is_put) {
+            BTreeItem value;
+            if (tree_item_argument(&args_node->children[2], func_name, &value) && btree_put(tree, &key, &value)) {
+                *result = (long long)tree->size;
+            }
+            free_tree_item_argument(&value);
+        } else if (is_lookup) {
+            const BTreeItem* found_key = NULL;
+            const BTreeItem* found = NULL;
+            if (op[0] == 'g') found = btree_get(tree, &key);
+            else if (op[0] == 'f' && btree_floor(tree, &key, &found_key, &found)) found = found_key;
+            else if (op[0] == 'c' && btree_ceiling(tree, &key, &found_key, &found)) found = found_key;
+            else found = NULL;
+            if (found) {
+                *result = library_scalar_result(found->is_string, found->number, found->text);
+            } else if (args_node->child_count > 2) {
+                char* text = NULL;
+                long long number;
+                if (library_scalar_argument(&args_node->children[2], func_name, &text, &number) > 0) *result = return_string_result(text);
+                else *result = number;
+            }
+        } else if (op[0] == 'c') {
+            *result = btree_get(tree, &key) != NULL;
+        } else {
+            *result = btree_remove(tree, &key);
+        }
+        free_tree_item_argument(&key);
+    } else if (strcmp(op, "size") == 0) {
+        *result = (long long)tree->size;
+    } else if (strcmp(op, "min") == 0 || strcmp(op, "max") == 0) {
+        const BTreeItem* key;
+        const BTreeItem* value;
+        int found;
+        if (op[1] == 'i') {
+            BTreeIterator it;
+            btree_iter_seek(tree, &it, NULL);
+            found = btree_iter_next(&it, &key, &value);
+        } else {
+            found = btree_last(tree, &key, &value);
+        }
+        if (!found) {
+            fprintf(stderr, "Error: data.%s() on an empty tree\n", func_name);
+            return 1;
+        }
+        *result = library_scalar_result(key->is_string, key->number, key->text);
+    } else if (strcmp(op, "keys") == 0 || strcmp(op, "values") == 0) {
+        *result = return_array_result(btree_collect(tree, NULL, NULL, op[0] == 'k'));
+    } else {
+        release_handle(&btree_handles, tree);
+        btree_free(tree);
+        *result = 1;
+    }
+    return 1;
+}
+
+// Item hash of a Bloom filter argument (a number or a string); returns 0 for a float or big integer (reported)
+static int bloom_item_argument(ASTNode* node, const char* caller, uint64_t* hash) {
+    char* text = NULL;
+    long long number;
+    int kind = library_scalar_argument(node, caller, &text, &number);
+    if (kind <= 0) {
+        *hash = bloom_hash_number(number);
+        return kind == 0;
+    }
+    *hash = bloom_hash_string(text, strlen(text));
+    tracked_free(text, __FILE__, __LINE__, "bloom_item_argument");
+    return 1;
+}
+
+// 0/1 array of per-item hits from a bulk test
+static MycoArray* membership_array(const unsigned char* hits, int n) {
+    MycoArray* array = create_array(n > 0 ? n : 1, 0);
+    if (!array) return NULL;
+    for (int i = 0; i < n; i++) array->elements[i] = hits[i];
+    array->size = n;
+    return array;
+}
+
+/**
+ * @brief Bitset and Bloom filter functions of the data library (d.bitset_set, d.bloom_test, ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through
+ *
+ * data.create_bitset(size) and data.create_bloom_filter(expected_items,
+ * false_positive_rate) return handles. The *_all forms take an array and
+ * do the whole batch in one call; *_test_all returns a 0/1 array.
+ */
+static int call_bitset_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+    int is_bitset = strncmp(func_name, "bitset_", 7) == 0 || strcmp(func_name, "create_bitset") == 0 ||
+                    strcmp(func_name, "free_bitset") == 0;
+    int is_bloom = strncmp(func_name, "bloom_", 6) == 0 || strcmp(func_name, "create_bloom_filter") == 0 ||
+                   strcmp(func_name, "free_bloom_filter") == 0;
+    if (!is_bitset && !is_bloom) return 0;
+
+    if (strncmp(func_name, "create_", 7) == 0) {
+        if (args_node->child_count < 1) {
+            fprintf(stderr, "Error: data.%s() requires %s\n", func_name,
+                    is_bitset ? "one argument (size)" : "at least one argument (expected_items)");
+            return 1;
+        }
+        long long size = eval_expression(&args_node->children[0]);
+        if (size < 0 || size > (1LL << 40)) {
+            fprintf(stderr, "Error: data.%s() size must be between 0 and 2^40\n", func_name);
+            return 1;
+        }
+        if (is_bitset) {
+            Bitset* bitset = bitset_create((size_t)size);
+            if (!bitset) return 1;
+            *result = register_handle(&bitset_handles, bitset);
+            if (!*result) bitset_free(bitset);
+        } else {
+            NumericValue rate = { 0, 0, 0.01, NULL };
+            if (args_node->child_count > 1 && !eval_numeric_argument(&args_node->children[1], &rate)) return 1;
+            if (!rate.is_float || rate.d <= 0.0 || rate.d >= 1.0) {
+                if (args_node->child_count > 1) {
+                    fprintf(stderr, "Error: data.create_bloom_filter() false_positive_rate must be between 0 and 1\n");
+                    return 1;
+                }
+                rate.d = 0.01;
+            }
+            BloomFilter* filter = bloom_create((size_t)size, rate.d);
+            if (!filter) return 1;
+            *result = register_handle(&bloom_handles, filter);
+            if (!*result) bloom_free(filter);
+        }
+        return 1;
+    }
+
+    const char* op = func_name + (strncmp(func_name, "free_", 5) == 0 ? 0 : is_bitset ? 7 : 6);
+    int is_combine = is_bitset && (strcmp(op, "and") == 0 || strcmp(op, "or") == 0 || strcmp(op, "xor") == 0);
+    int is_single = strcmp(op, is_bitset ? "set" : "add") == 0 || strcmp(op, "test") == 0 ||
+                    (is_bitset && strcmp(op, "clear") == 0);
+    int is_bulk = strcmp(op, is_bitset ? "set_all" : "add_all") == 0 || strcmp(op, "test_all") == 0;
+    int is_other = strcmp(op, "count") == 0 || (is_bitset && strcmp(op, "size") == 0) || strncmp(op, "free_", 5) == 0;
+    if (!is_combine && !is_single && !is_bulk && !is_other) return 0;
+
+    const char* kind = is_bitset ? "bitset" : "Bloom filter";
+    if (args_node->child_count < (is_other ? 1 : 2)) {
+        fprintf(stderr, "Error: data.%s() requires %s\n", func_name,
+                is_combine ? "two arguments (bitset, other)" : is_bulk ? "two arguments (handle, array)" :
+                is_single ? (is_bitset ? "two arguments (bitset, index)" : "two arguments (filter, item)") :
+                is_bitset ? "one argument (bitset)" : "one argument (filter)");
+        return 1;
+    }
+    void* handle = handle_argument(is_bitset ? &bitset_handles : &bloom_handles, args_node, 0, func_name, kind);
+    if (!handle) return 1;
+    Bitset* bitset = is_bitset ? (Bitset*)handle : NULL;
+    BloomFilter* filter = is_bitset ? NULL : (BloomFilter*)handle;
+
+    if (is_combine) {
+        Bitset* other = (Bitset*)handle_argument(&bitset_handles, args_node, 1, func_name, kind);
+        if (!other) return 1;
+        bitset_combine(bitset, other, op[0] == 'a' ? BITSET_AND : op[0] == 'o' ? BITSET_OR : BITSET_XOR);
+        *result = (long long)bitset_count(bitset);
+    } else if (is_single) {
+        if (is_bitset) {
+            long long index = eval_expression(&args_node->children[1]);
+            if (index < 0 || (unsigned long long)index >= bitset->size) {
+                fprintf(stderr, "Error: data.%s() index out of range\n", func_name);
+                return 1;
+            }
+            if (op[0] == 't') {
+                *result = bitset_test(bitset, (size_t)index);
+            } else {
+                if (op[0] == 's') bitset_set(bitset, (size_t)index);
+                else bitset_clear(bitset, (size_t)index);
+                *result = 1;
+            }
+        } else {
+            uint64_t hash;
+            if (!bloom_item_argument(&args_node->children[1], func_name, &hash)) return 1;
+            if (op[0] == 't') {
+                *result = bloom_test(filter, hash);
+            } else {
+                bloom_add(filter, hash);
+                *result = 1;
+            }
+        }
+    } else if (is_bulk) {
+        int is_temp = 0;
+        MycoArray* array = library_array_argument(&args_node->children[1], &is_temp);
+        if (!array || (is_bitset && array->is_string_array)) {
+            fprintf(stderr, "Error: data.%s() requires an array%s\n", func_name, is_bitset ? " of indexes" : "");
+            if (array && is_temp) destroy_array(array);
+            return 1;
+        }
+        size_t n = (size_t)array->size;
+        if (op[0] == 't') {
+            unsigned char* hits = (unsigned char*)tracked_malloc(n > 0 ? n : 1, __FILE__, __LINE__, "membership_hits");
+            if (hits) {
+                if (is_bitset) {
+                    bitset_test_many(bitset, array->elements, n, hits);
+                } else if (array->is_string_array) {
+                    for (size_t i = 0; i < n; i++) {
+                        const char* text = array->str_elements[i] ? array->str_elements[i] : "";
+                        hits[i] = (unsigned char)bloom_test(filter, bloom_hash_string(text, strlen(text)));
+                    }
+                } else {
+                    bloom_test_numbers(filter, array->elements, n, hits);
+                }
+                *result = return_array_result(membership_array(hits, array->size));
+                tracked_free(hits, __FILE__, __LINE__, "membership_hits");
+            }
+        } else if (is_bitset) {
+            *result = (long long)bitset_set_many(bitset, array->elements, n);
+        } else {
+            if (array->is_string_array) {
+                for (size_t i = 0; i < n; i++) {
+                    const char* text = array->str_elements[i] ? array->str_elements[i] : "";
+                    bloom_add(filter, bloom_hash_string(text, strlen(text)));
+                }
+            } else {
+                bloom_add_numbers(filter, array->elements, n);
+            }
+            *result = (long long)n;
+        }
+        if (is_temp) destroy_array(array);
+    } else if (strcmp(op, "count") == 0) {
+        *result = is_bitset ? (long long)bitset_count(bitset) : (long long)filter->count;
+    } else if (strcmp(op, "size") == 0) {
+        *result = (long long)bitset->size;
+    } else if (is_bitset) {
+        release_handle(&bitset_handles, bitset);
+        bitset_free(bitset);
+        *result = 1;
+    } else {
+        release_handle(&bloom_handles, filter);
+        bloom_free(filter);
+        *result = 1;
+    }
+    return 1;
+}
+
+// Matrix handle argument at index (reported when missing or stale)
+static Matrix* matrix_argument(ASTNode* args_node, int index, const char* caller) {
+    return (Matrix*)handle_argument(&matrix_handles, args_node, index, caller, "matrix");
+}
+
+// Register a newly computed matrix and return its handle (0 after reporting a failure)
+static long long matrix_handle_result(Matrix* matrix, const char* caller) {
+    if (!matrix) {
+        fprintf(stderr, "Error: data.%s() could not allocate the result matrix\n", caller);
+        return 0;
+    }
+    long long handle = register_handle(&matrix_handles, matrix);
+    if (!handle) matrix_free(matrix);
+    return handle;
+}
+
+// Element i of a matrix as the call's result; floats are reported against args_node
+static long long matrix_element_result(ASTNode* args_node, const Matrix* matrix, size_t i) {
+    if (matrix->type == MATRIX_FLOAT64) return return_float_result(args_node, matrix->floats[i]);
+    return matrix->ints[i];
+}
+
+// Row/column index argument checked against limit; -1 (reported) when out of range
+static long long matrix_index_argument(ASTNode* node, size_t limit, const char* caller) {
+    long long index = eval_expression(node);
+    if (index < 0 || (unsigned long long)index >= limit) {
+        fprintf(stderr, "Error: data.%s() index %lld out of range\n", caller, index);
+        return -1;
+    }
+    return index;
+}
+
+/**
+ * @brief Matrix functions of the data library (d.create_matrix, d.matrix_matmul, ...)
+ * @param result Set to the call's result when handled
+ * @return 1 if the call was handled here, 0 to fall through
+ *
+ * Matrices are addressed by handle. Functions that compute a new matrix
+ * (slices, transpose, arithmetic, axis reductions, matmul) return a new
+ * handle; the operands are left unchanged. A matrix holds int64 elements
+ * until a float is stored or produced, then float64.
+ */
+static int call_matrix_function(const char* func_name, ASTNode* args_node, long long* result) {
+    *result = 0;
+    int is_create = strcmp(func_name, "create_matrix") == 0;
+    int is_from_array = strcmp(func_name, "matrix_from_array") == 0;
+    if (!is_create && !is_from_array && strncmp(func_name, "matrix_", 7) != 0 && strcmp(func_name, "free_matrix") != 0) return 0;
+    const char* op = func_name + 7;
+
+    if (is_create || is_from_array) {
+        if (args_node->child_count < 2) {
+            fprintf(stderr, "Error: data.%s() requires %s\n", func_name,
+                    is_create ? "two arguments (rows, cols)" : "two arguments (array, rows)");
+            return 1;
+        }
+        int is_temp = 0;
+        MycoArray* array = NULL;
+        if (is_from_array) {
+            array = library_array_argument(&args_node->children[0], &is_temp);
+            if (!array || array->is_string_array) {
+                fprintf(stderr, "Error: data.matrix_from_array() requires an array of numbers\n");
+                if (array && is_temp) destroy_array(array);
+                return 1;
+            }
+        }
+        long long rows = eval_expression(&args_node->children[is_create ? 0 : 1]);
+        long long cols = is_create ? eval_expression(&args_node->children[1]) :
+                         args_node->child_count > 2 ? eval_expression(&args_node->children[2]) :
+                         rows > 0 ? array->size / rows : 0;
+        if (rows < 0 || cols < 0 || (cols > 0 && rows > (1LL << 32) / cols) ||
+            (is_from_array && rows * cols != array->size)) {
+            fprintf(stderr, "Error: data.%s() invalid shape %lld x %lld\n", func_name, rows, cols);
+            if (array && is_temp) destroy_array(array);
+            return 1;
+        }
+        NumericValue fill = { 0, 0, 0.0, NULL };
+        if (is_create && args_node->child_count > 2 && !eval_numeric_argument(&args_node->children[2], &fill)) return 1;
+        Matrix* matrix = matrix_create((size_t)rows, (size_t)cols, fill.is_float ? MATRIX_FLOAT64 : MATRIX_INT64);
+        if (matrix) {
+            size_t count = (size_t)(rows * cols);
+            if (is_from_array) memcpy(matrix->ints, array->elements, count * sizeof(long long));
+            else if (fill.is_float) for (size_t i = 0; i < count; i++) matrix->floats[i] = fill.d;
+            else if (fill.i != 0) for (size_t i = 0; i < count; i++) matrix->ints[i] = fill.i;
+        }
+        if (array && is_temp) destroy_array(array);
+        *result = matrix_handle_result(matrix, func_name);
+        return 1;
+    }
+
+    int is_binary = strcmp(op, "add") == 0 || strcmp(op, "sub") == 0 || strcmp(op, "mul") == 0 ||
+                    strcmp(op, "div") == 0 || strcmp(op, "matmul") == 0;
+    int is_reduce = strcmp(op, "sum") == 0 || strcmp(op, "min") == 0 || strcmp(op, "max") == 0 || strcmp(op, "mean") == 0;
+    int is_get = strcmp(op, "get") == 0;
+    int is_set = strcmp(op, "set") == 0;
+    int is_line = strcmp(op, "row") == 0 || strcmp(op, "col") == 0;
+    int is_slice = strcmp(op, "slice") == 0;
+    int is_scale = strcmp(op, "scale") == 0;
+    int is_other = strcmp(op, "rows") == 0 || strcmp(op, "cols") == 0 || strcmp(op, "transpose") == 0 ||
+                   strcmp(op, "to_array") == 0 || strcmp(func_name, "free_matrix") == 0;
+    if (!is_binary && !is_reduce && !is_get && !is_set && !is_line && !is_slice && !is_scale && !is_other) return 0;
+
+    int needed = is_slice ? 5 : is_set ? 4 : is_get ? 3 : (is_binary || is_line || is_scale) ? 2 : 1;
+    if (args_node->child_count < needed) {
+        fprintf(stderr, "Error: data.%s() requires %s\n", func_name,
+                is_slice ? "five arguments (matrix, row_start, row_end, col_start, col_end)" :
+                is_set ? "four arguments (matrix, row, col, value)" : is_get ? "three arguments (matrix, row, col)" :
+                is_binary ? "two arguments (a, b)" : is_line ? "two arguments (matrix, index)" :
+                is_scale ? "two arguments (matrix, factor)" : "one argument (matrix)");
+        return 1;
+    }
+    Matrix* matrix = matrix_argument(args_node, 0, func_name);
+    if (!matrix) return 1;
+
+    if (is_binary) {
+        Matrix* other = matrix_argument(args_node, 1, func_name);
+        if (!other) return 1;
+        int is_matmul = op[1] == 'a';
+        if (is_matmul ? matrix->cols != other->rows : (matrix->rows != other->rows || matrix->cols != other->cols)) {
+            fprintf(stderr, "Error: data.%s() shape mismatch (%zu x %zu and %zu x %zu)\n", func_name,
+                    matrix->rows, matrix->cols, other->rows, other->cols);
+            return 1;
+        }
+        if (is_matmul) {
+            *result = matrix_handle_result(matrix_matmul(matrix, other), func_name);
+        } else {
+            MatrixOp kind = op[0] == 'a' ? MATRIX_ADD : op[0] == 's' ? MATRIX_SUB : op[0] == 'm' ? MATRIX_MUL : MATRIX_DIV;
+            *result = matrix_handle_result(matrix_elementwise(matrix, other, kind), func_name);
+        }
+    } else if (is_reduce) {
+        MatrixReduction kind = strcmp(op, "sum") == 0 ? MATRIX_SUM : strcmp(op, "min") == 0 ? MATRIX_MIN :
+                               strcmp(op, "max") == 0 ? MATRIX_MAX : MATRIX_MEAN;
+        int axis = -1;
+        if (args_node->child_count > 1) {
+            long long raw = eval_expression(&args_node->children[1]);
+            if (raw != 0 && raw != 1) {
+                fprintf(stderr, "Error: data.%s() axis must be 0 (columns) or 1 (rows)\n", func_name);
+                return 1;
+            }
+            axis = (int)raw;
+        }
+        if (kind != MATRIX_SUM && matrix->rows * matrix->cols == 0) {
+            fprintf(stderr, "Error: data.%s() on an empty matrix\n", func_name);
+            return 1;
+        }
+        Matrix* reduced = matrix_reduce(matrix, kind, axis);
+        if (axis >= 0) {
+            *result = matrix_handle_result(reduced, func_name);
+        } else if (reduced) {
+            *result = matrix_element_result(args_node, reduced, 0);
+            matrix_free(reduced);
+        }
+    } else if (is_get || is_set) {
+        long long row = matrix_index_argument(&args_node->children[1], matrix->rows, func_name);
+        long long col = row < 0 ? -1 : matrix_index_argument(&args_node->children[2], matrix->cols, func_name);
+        if (col < 0) return 1;
+        size_t i = (size_t)row * matrix->cols + (size_t)col;
+        if (is_get) {
+            *result = matrix_element_result(args_node, matrix, i);
+        } else {
+            NumericValue value;
+            if (!eval_numeric_argument(&args_node->children[3], &value)) return 1;
+            if (value.is_float && !matrix_promote(matrix)) return 1;
+            if (matrix->type == MATRIX_FLOAT64) matrix->floats[i] = value.is_float ? value.d : (double)value.i;
+            else matrix->ints[i] = value.i;
+            *result = 1;
+        }
+    } else if (is_line || is_slice) {
+        size_t r0 = 0, r1 = matrix->rows, c0 = 0, c1 = matrix->cols;
+        if (is_line) {
+            int is_row = op[1] == 'o';
+            long long index = matrix_index_argument(&args_node->children[1], is_row ? matrix->rows : matrix->cols, func_name);
+            if (index < 0) return 1;
+            if (is_row) {
+                r0 = (size_t)index;
+                r1 = r0 + 1;
+            } else {
+                c0 = (size_t)index;
+                c1 = c0 + 1;
+            }
+        } else {
+            // Half-open ranges, clamped to the matrix
+            long long bounds[4];
+            for (int b = 0; b < 4; b++) {
+                long long limit = b < 2 ? (long long)matrix->rows : (long long)matrix->cols;
+                bounds[b] = eval_expression(&args_node->children[b + 1]);
+                if (bounds[b] < 0) bounds[b] = 0;
+                if (bounds[b] > limit) bounds[b] = limit;
+            }
+            r0 = (size_t)bounds[0];
+            r1 = bounds[1] > bounds[0] ? (size_t)bounds[1] : r0;
+            c0 = (size_t)bounds[2];
+            c1 = bounds[3] > bounds[2] ? (size_t)bounds[3] : c0;
+        }
+        *result = matrix_handle_result(matrix_slice(matrix, r0, r1, c0, c1), func_name);
+    } else if (is_scale) {
+        NumericValue factor;
+        if (!eval_numeric_argument(&args_node->children[1], &factor)) return 1;
+        *result = matrix_handle_result(matrix_scale(matrix, factor.is_float, factor.i, factor.d), func_name);
+    } else if (strcmp(op, "rows") == 0) {
+        *result = (long long)matrix->rows;
+    } else if (strcmp(op, "cols") == 0) {
+        *result = (long long)matrix->cols;
+    } else if (strcmp(op, "transpose") == 0) {
+        *result = matrix_handle_result(matrix_transpose(matrix), func_name);
+    } else if (strcmp(op, "to_array") == 0) {
+        // Arrays hold integers, so only int64 matrices flatten losslessly
+        if (matrix->type != MATRIX_INT64) {
+            fprintf(stderr, "Error: data.matrix_to_array() requires an integer matrix; use data.matrix_get() for floats\n");
+            return 1;
+        }
+        size_t count = matrix->rows * matrix->cols;
+        MycoArray* array = create_array(count > 0 ? (int)count : 1, 0);
+        if (!array) return 1;
+        memcpy(array->elements, matrix->ints, count * sizeof(long long));
+        array->size = (int)count;
+        *result = return_array_result(array);
+    } else {
+        release_handle(&matrix_handles, matrix);
+        matrix_free(matrix);
+        *result = 1;
+    }
+    return 1;
+}
+
 // Advanced Data Structures Library Functions (v1.6.0)
 static long long call_data_structures_function(const char* func_name, ASTNode* args_node) {
+    long long native_result;
+    if (call_hash_table_function(func_name, args_node, &native_result)) return native_result;
+    if (call_priority_queue_function(func_name, args_node, &native_result)) return native_result;
+    if (call_deque_function(func_name, args_node, &native_result)) return native_result;
+    if (call_btree_function(func_name, args_node, &native_result)) return native_result;
+    if (call_bitset_function(func_name, args_node, &native_result)) return native_result;
+    if (call_matrix_function(func_name, args_node, &native_result)) return native_result;
+
     if (strcmp(func_name, "create_linked_list") == 0) {
         if (args_node->child_count < 1) {
             fprintf(stderr, "Error: data.create_linked_list() requires one argument (initial_value)\n");
@@ -13377,11 +16351,21 @@ static long long call_data_structures_function(const char* func_name, ASTNode* a
             return 0;
         }
         
-        // For now, we'll simulate linked list creation
-        // Linked List created successfully
-        
+        // Backed by a ring-buffer deque holding the initial value
+        Deque* deque = deque_create(0);
+        if (!deque) return 0;
+        DequeItem item;
+        int kind = library_scalar_argument(value_node, func_name, &item.text, &item.number);
+        item.is_string = kind > 0;
+        int pushed = kind >= 0 && deque_push_back(deque, &item);
+        if (item.text) tracked_free(item.text, __FILE__, __LINE__, "create_linked_list");
+        long long handle = pushed ? register_handle(&deque_handles, deque) : 0;
+        if (!handle) {
+            deque_free(deque);
+            return 0;
+        }
         linked_list_mode = 1;
-        return 1; // Linked list creation completed
+        return handle; // Handle for the deque_* functions
         
     } else if (strcmp(func_name, "create_binary_tree") == 0) {
         if (args_node->child_count < 1) {
@@ -13396,11 +16380,19 @@ static long long call_data_structures_function(const char* func_name, ASTNode* a
             return 0;
         }
         
-        // For now, we'll simulate binary tree creation
-        // Binary Tree created successfully
-        
+        // Backed by a B-tree ordered map holding the root value as its first key
+        BTree* tree = btree_create();
+        if (!tree) return 0;
+        BTreeItem root;
+        int inserted = tree_item_argument(value_node, func_name, &root) && btree_put(tree, &root, &root);
+        free_tree_item_argument(&root);
+        long long handle = inserted ? register_handle(&btree_handles, tree) : 0;
+        if (!handle) {
+            btree_free(tree);
+            return 0;
+        }
         binary_tree_mode = 1;
-        return 1; // Binary tree creation completed
+        return handle; // Handle for the tree_* functions
         
     } else if (strcmp(func_name, "create_hash_table") == 0) {
         if (args_node->child_count < 1) {
@@ -13408,18 +16400,34 @@ static long long call_data_structures_function(const char* func_name, ASTNode* a
             return 0;
         }
         
-        // Get initial capacity from argument
+        // Get initial capacity from argument (a number or numeric string)
         ASTNode* capacity_node = &args_node->children[0];
         if (capacity_node->type != AST_EXPR || !capacity_node->text) {
             fprintf(stderr, "Error: data.create_hash_table() argument must be a valid expression\n");
             return 0;
         }
+        char* capacity_text = NULL;
+        long long capacity = 0;
+        int kind = library_scalar_argument(capacity_node, func_name, &capacity_text, &capacity);
+        if (kind < 0) return 0;
+        if (kind > 0) {
+            capacity = strtoll(capacity_text, NULL, 10);
+            tracked_free(capacity_text, __FILE__, __LINE__, "create_hash_table");
+        }
+        if (capacity < 0 || capacity > INT_MAX) {
+            fprintf(stderr, "Error: data.create_hash_table() capacity must be between 0 and %d\n", INT_MAX);
+            return 0;
+        }
         
-        // For now, we'll simulate hash table creation
-        // Hash Table created successfully
-        
+        HashTable* table = hash_table_create((size_t)capacity);
+        if (!table) return 0;
+        long long handle = register_handle(&hash_table_handles, table);
+        if (!handle) {
+            hash_table_free(table);
+            return 0;
+        }
         hash_table_mode = 1;
-        return 1; // Hash table creation completed
+        return handle; // Handle for the hash_* functions
         
     } else if (strcmp(func_name, "create_priority_queue") == 0) {
         if (args_node->child_count < 1) {
@@ -13427,18 +16435,22 @@ static long long call_data_structures_function(const char* func_name, ASTNode* a
             return 0;
         }
         
-        // Get ordering type from argument
+        // Get ordering type from argument ("min" or "max")
         ASTNode* type_node = &args_node->children[0];
         if (type_node->type != AST_EXPR || !type_node->text) {
             fprintf(stderr, "Error: data.create_priority_queue() argument must be a valid expression\n");
             return 0;
         }
         
-        // For now, we'll simulate priority queue creation
-        // Priority Queue created successfully
-        
+        PriorityQueue* queue = priority_queue_create(priority_order_argument(args_node, 0, func_name), 0);
+        if (!queue) return 0;
+        long long handle = register_handle(&priority_queue_handles, queue);
+        if (!handle) {
+            priority_queue_free(queue);
+            return 0;
+        }
         priority_queue_mode = 1;
-        return 1; // Priority queue creation completed
+        return handle; // Handle for the pq_* functions
         
     } else if (strcmp(func_name, "quicksort") == 0) {
         if (args_node->child_count < 1) {
@@ -13590,12 +16602,6 @@ void reset_test_environment(void) {
  * @brief Cleanup Phase 2 targeted bottleneck optimization systems
  */
 void cleanup_phase2_optimization_systems(void) {
-    if (string_search_cache) {
-        tracked_free(string_search_cache, __FILE__, __LINE__, "cleanup_string_search_cache");
-        string_search_cache = NULL;
-        string_search_cache_size = 0;
-    }
-    
     if (current_pattern) {
         tracked_free(current_pattern, __FILE__, __LINE__, "cleanup_advanced_pattern");
         current_pattern = NULL;
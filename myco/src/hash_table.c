@@ -0,0 +1,333 @@
+/**
+ * @file hash_table.c
+ * @brief Myco Hash Tables - Robin Hood open addressing with incremental resizing
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the table behind data.create_hash_table(). Entries
+ * live directly in one slot array (no per-entry nodes or chains), so a
+ * lookup is a short linear scan over adjacent memory instead of the
+ * property-by-property search of a MycoObject.
+ *
+ * Hash Table Features:
+ * - Robin Hood probing: an insert displaces entries closer to their home
+ *   slot, which keeps probe lengths short and lets a miss stop early
+ * - Backward-shift deletion, so removals leave no tombstones behind
+ * - Cached 64-bit hashes: most mismatches are rejected without touching keys
+ * - Integer and string keys, number and string values
+ * - Incremental resizing: a grown table drains the old slot array a few
+ *   slots per operation instead of rehashing everything at once
+ */
+
+#include "hash_table.h"
+#include "memory_tracker.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define HASH_EMPTY 0
+#define HASH_REMOVED 1           // Only ever written into a draining old table
+#define HASH_MIN_CAPACITY 8
+#define HASH_MIGRATE_STEP 32     // Old slots moved per operation while a resize is in progress
+
+/*******************************************************************************
+ * HASHING
+ ******************************************************************************/
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static uint64_t hash_key(const HashKey* key) {
+    uint64_t h;
+    if (key->is_string) {
+        // FNV-1a, finished with a strong mixer so the low bits used for the slot are well spread
+        h = 0xCBF29CE484222325ULL;
+        for (size_t i = 0; i < key->length; i++) {
+            h ^= (unsigned char)key->text[i];
+            h *= 0x100000001B3ULL;
+        }
+        h = mix64(h ^ key->length);
+    } else {
+        h = mix64((uint64_t)key->number);
+    }
+    // 0 and 1 mark empty and removed slots
+    return h < 2 ? h + 2 : h;
+}
+
+static int keys_equal(const HashKey* a, const HashKey* b) {
+    if (a->is_string != b->is_string) return 0;
+    if (!a->is_string) return a->number == b->number;
+    return a->length == b->length && memcmp(a->text, b->text, a->length) == 0;
+}
+
+/*******************************************************************************
+ * SLOT ARRAYS
+ ******************************************************************************/
+
+static HashEntry* alloc_slots(size_t capacity) {
+    HashEntry* slots = (HashEntry*)tracked_malloc(capacity * sizeof(HashEntry), __FILE__, __LINE__, "hash_table_slots");
+    if (slots) memset(slots, 0, capacity * sizeof(HashEntry));
+    return slots;
+}
+
+static void free_entry(HashEntry* entry) {
+    if (entry->key.is_string) tracked_free((char*)entry->key.text, __FILE__, __LINE__, "hash_table_key");
+    if (entry->value.is_string) tracked_free(entry->value.text, __FILE__, __LINE__, "hash_table_value");
+}
+
+static void free_slots(HashEntry* slots, size_t capacity) {
+    for (size_t i = 0; i < capacity; i++) {
+        if (slots[i].hash > HASH_REMOVED) free_entry(&slots[i]);
+    }
+    tracked_free(slots, __FILE__, __LINE__, "hash_table_slots");
+}
+
+// Distance of the entry in slot i from its home slot
+static size_t probe_distance(const HashEntry* slots, size_t mask, size_t i) {
+    return (i - (size_t)(slots[i].hash & mask)) & mask;
+}
+
+// Robin Hood insert of an entry whose key is known to be absent
+static void slots_insert(HashEntry* slots, size_t capacity, HashEntry entry) {
+    size_t mask = capacity - 1;
+    size_t i = (size_t)(entry.hash & mask);
+    size_t dist = 0;
+    for (;;) {
+        if (slots[i].hash == HASH_EMPTY) {
+            slots[i] = entry;
+            return;
+        }
+        size_t existing = probe_distance(slots, mask, i);
+        if (existing < dist) {
+            // Take the slot from the richer entry and carry it onward
+            HashEntry displaced = slots[i];
+            slots[i] = entry;
+            entry = displaced;
+            dist = existing;
+        }
+        i = (i + 1) & mask;
+        dist++;
+    }
+}
+
+// Lookup in the live table; a miss stops as soon as it passes where the key would have been
+static HashEntry* slots_find(HashEntry* slots, size_t capacity, uint64_t hash, const HashKey* key) {
+    size_t mask = capacity - 1;
+    size_t i = (size_t)(hash & mask);
+    for (size_t dist = 0;; dist++) {
+        HashEntry* slot = &slots[i];
+        if (slot->hash == HASH_EMPTY || probe_distance(slots, mask, i) < dist) return NULL;
+        if (slot->hash == hash && keys_equal(&slot->key, key)) return slot;
+        i = (i + 1) & mask;
+    }
+}
+
+// Lookup in a draining table, which may hold removed markers (no early exit)
+static HashEntry* old_slots_find(HashEntry* slots, size_t capacity, uint64_t hash, const HashKey* key) {
+    size_t mask = capacity - 1;
+    size_t i = (size_t)(hash & mask);
+    for (size_t n = 0; n < capacity; n++) {
+        HashEntry* slot = &slots[i];
+        if (slot->hash == HASH_EMPTY) return NULL;
+        if (slot->hash == hash && keys_equal(&slot->key, key)) return slot;
+        i = (i + 1) & mask;
+    }
+    return NULL;
+}
+
+/*******************************************************************************
+ * INCREMENTAL RESIZING
+ ******************************************************************************/
+
+// Move up to limit old slots into the live table
+static void migrate(HashTable* table, size_t limit) {
+    if (!table->old_slots) return;
+    size_t end = table->migrate_index + limit;
+    if (end > table->old_capacity || limit == 0) end = table->old_capacity;
+    for (size_t i = table->migrate_index; i < end; i++) {
+        HashEntry* slot = &table->old_slots[i];
+        if (slot->hash > HASH_REMOVED) {
+            slots_insert(table->slots, table->capacity, *slot);
+            table->count++;
+            table->old_count--;
+            // The live table owns the key and value now; the marker keeps later probe chains intact
+            memset(slot, 0, sizeof(HashEntry));
+            slot->hash = HASH_REMOVED;
+        }
+    }
+    table->migrate_index = end;
+    if (end == table->old_capacity || table->old_count == 0) {
+        tracked_free(table->old_slots, __FILE__, __LINE__, "hash_table_slots");
+        table->old_slots = NULL;
+        table->old_capacity = 0;
+        table->old_count = 0;
+        table->migrate_index = 0;
+    }
+}
+
+// Start draining into a table twice the size
+static int grow(HashTable* table) {
+    // A previous resize still in progress is finished first
+    migrate(table, 0);
+    HashEntry* slots = alloc_slots(table->capacity * 2);
+    if (!slots) return 0;
+    table->old_slots = table->slots;
+    table->old_capacity = table->capacity;
+    table->old_count = table->count;
+    table->migrate_index = 0;
+    table->slots = slots;
+    table->capacity *= 2;
+    table->count = 0;
+    return 1;
+}
+
+/*******************************************************************************
+ * PUBLIC API
+ ******************************************************************************/
+
+HashTable* hash_table_create(size_t initial_capacity) {
+    // Room for initial_capacity entries below the 7/8 load limit
+    size_t capacity = HASH_MIN_CAPACITY;
+    while (capacity < initial_capacity + initial_capacity / 7 + 1) capacity *= 2;
+    HashTable* table = (HashTable*)tracked_malloc(sizeof(HashTable), __FILE__, __LINE__, "hash_table");
+    if (!table) return NULL;
+    memset(table, 0, sizeof(HashTable));
+    table->slots = alloc_slots(capacity);
+    if (!table->slots) {
+        tracked_free(table, __FILE__, __LINE__, "hash_table");
+        return NULL;
+    }
+    table->capacity = capacity;
+    return table;
+}
+
+void hash_table_free(HashTable* table) {
+    if (!table) return;
+    free_slots(table->slots, table->capacity);
+    if (table->old_slots) free_slots(table->old_slots, table->old_capacity);
+    tracked_free(table, __FILE__, __LINE__, "hash_table");
+}
+
+void hash_table_clear(HashTable* table) {
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (table->slots[i].hash > HASH_REMOVED) free_entry(&table->slots[i]);
+    }
+    memset(table->slots, 0, table->capacity * sizeof(HashEntry));
+    table->count = 0;
+    if (table->old_slots) {
+        free_slots(table->old_slots, table->old_capacity);
+        table->old_slots = NULL;
+        table->old_capacity = 0;
+        table->old_count = 0;
+        table->migrate_index = 0;
+    }
+}
+
+size_t hash_table_size(const HashTable* table) {
+    return table->count + table->old_count;
+}
+
+HashValue* hash_table_get(HashTable* table, const HashKey* key) {
+    migrate(table, HASH_MIGRATE_STEP);
+    uint64_t hash = hash_key(key);
+    HashEntry* entry = slots_find(table->slots, table->capacity, hash, key);
+    if (!entry && table->old_slots) entry = old_slots_find(table->old_slots, table->old_capacity, hash, key);
+    return entry ? &entry->value : NULL;
+}
+
+static int copy_value(HashValue* dst, const HashValue* src) {
+    HashValue copy = *src;
+    if (src->is_string) {
+        copy.text = tracked_strdup(src->text ? src->text : "", __FILE__, __LINE__, "hash_table_value");
+        if (!copy.text) return 0;
+    }
+    *dst = copy;
+    return 1;
+}
+
+int hash_table_put(HashTable* table, const HashKey* key, const HashValue* value) {
+    migrate(table, HASH_MIGRATE_STEP);
+    uint64_t hash = hash_key(key);
+    HashEntry* entry = slots_find(table->slots, table->capacity, hash, key);
+    if (!entry && table->old_slots) entry = old_slots_find(table->old_slots, table->old_capacity, hash, key);
+    if (entry) {
+        // Existing key: replace the value where it lies
+        HashValue replacement;
+        if (!copy_value(&replacement, value)) return 0;
+        if (entry->value.is_string) tracked_free(entry->value.text, __FILE__, __LINE__, "hash_table_value");
+        entry->value = replacement;
+        return 1;
+    }
+
+    if ((hash_table_size(table) + 1) * 8 > table->capacity * 7 && !grow(table)) return 0;
+
+    HashEntry fresh;
+    fresh.hash = hash;
+    fresh.key = *key;
+    if (key->is_string) {
+        char* text = (char*)tracked_malloc(key->length + 1, __FILE__, __LINE__, "hash_table_key");
+        if (!text) return 0;
+        memcpy(text, key->text, key->length);
+        text[key->length] = '\0';
+        fresh.key.text = text;
+    }
+    if (!copy_value(&fresh.value, value)) {
+        if (key->is_string) tracked_free((char*)fresh.key.text, __FILE__, __LINE__, "hash_table_key");
+        return 0;
+    }
+    slots_insert(table->slots, table->capacity, fresh);
+    table->count++;
+    return 1;
+}
+
+int hash_table_remove(HashTable* table, const HashKey* key) {
+    migrate(table, HASH_MIGRATE_STEP);
+    uint64_t hash = hash_key(key);
+    HashEntry* entry = slots_find(table->slots, table->capacity, hash, key);
+    if (entry) {
+        free_entry(entry);
+        // Backward shift: pull the following displaced entries one slot closer to home
+        size_t mask = table->capacity - 1;
+        size_t i = (size_t)(entry - table->slots);
+        for (;;) {
+            size_t next = (i + 1) & mask;
+            if (table->slots[next].hash == HASH_EMPTY || probe_distance(table->slots, mask, next) == 0) break;
+            table->slots[i] = table->slots[next];
+            i = next;
+        }
+        memset(&table->slots[i], 0, sizeof(HashEntry));
+        table->count--;
+        return 1;
+    }
+    if (table->old_slots) {
+        entry = old_slots_find(table->old_slots, table->old_capacity, hash, key);
+        if (entry) {
+            // Positions in the old table must stay put until it is drained
+            free_entry(entry);
+            memset(entry, 0, sizeof(HashEntry));
+            entry->hash = HASH_REMOVED;
+            table->old_count--;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int hash_table_next(const HashTable* table, size_t* cursor, const HashKey** key, const HashValue** value) {
+    size_t total = table->capacity + (table->old_slots ? table->old_capacity : 0);
+    while (*cursor < total) {
+        size_t i = (*cursor)++;
+        const HashEntry* entry = i < table->capacity ? &table->slots[i] : &table->old_slots[i - table->capacity];
+        if (entry->hash > HASH_REMOVED) {
+            *key = &entry->key;
+            *value = &entry->value;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,1153 @@
+/**
+ * @file json_codec.c
+ * @brief Myco JSON Codec - Native JSON reading, streaming and writing
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the JSON functions of the text_utils library. The
+ * parser builds MycoObject/MycoArray values directly from the text in one
+ * pass, the stream reader hands out the elements of a top-level array (or
+ * the records of an NDJSON document) one at a time, and the writer emits
+ * JSON into a single buffer that is either grown or flushed to a file.
+ *
+ * JSON Codec Features:
+ * - String bodies are scanned eight bytes at a time for quotes, backslashes
+ *   and control characters; plain runs are copied with one memcpy
+ * - Full escape handling including \uXXXX and surrogate pairs (UTF-8 output)
+ * - Nesting depth limit so hostile input cannot exhaust the C stack
+ * - Streaming iteration without materializing the whole document: a file
+ *   stream holds one 64 KB window (grown only to fit a larger element)
+ * - Buffered writer that never builds intermediate strings
+ *
+ * Value Mapping:
+ * - Objects become MycoObject, strings PROP_TYPE_STRING, integers
+ *   PROP_TYPE_NUMBER, numbers with a fraction or exponent PROP_TYPE_FLOAT,
+ *   true/false 1/0 and null 0
+ * - An integer outside the 64-bit range, or a float beyond the double range,
+ *   is a parse error rather than a silently clamped value
+ * - Objects cannot hold arrays, so nested arrays become objects keyed
+ *   "0".."n-1" plus "length"; the writer turns that shape back into an array
+ * - A top-level array of only strings or only integers becomes a MycoArray
+ * - Floats are written as the shortest text that reads back as the same
+ *   double, always with a '.' or exponent so they stay floats
+ */
+
+#include "json_codec.h"
+#include "memory_tracker.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+#define JSON_MAX_DEPTH 512              // Deepest nesting accepted by the parser
+#define JSON_FILE_BUFFER_SIZE 65536     // Writer buffer size, and stream read size, for files
+
+/*******************************************************************************
+ * BYTE SCANNING
+ ******************************************************************************/
+
+#define JSON_ONES  0x0101010101010101ULL
+#define JSON_HIGHS 0x8080808080808080ULL
+
+// Nonzero if any byte of word equals byte
+static uint64_t word_has_byte(uint64_t word, unsigned char byte) {
+    uint64_t x = word ^ (JSON_ONES * byte);
+    return (x - JSON_ONES) & ~x & JSON_HIGHS;
+}
+
+// Nonzero if any byte of word is below 0x20
+static uint64_t word_has_control(uint64_t word) {
+    return (word - JSON_ONES * 0x20) & ~word & JSON_HIGHS;
+}
+
+/**
+ * @brief Length of the leading run that contains no '"', '\\' or control byte
+ *
+ * Checks eight bytes per step (SWAR) and finishes byte by byte, so long
+ * string bodies cost a handful of word operations per eight characters.
+ */
+static size_t plain_run_length(const char* s, size_t len) {
+    size_t i = 0;
+    while (i + 8 <= len) {
+        uint64_t word;
+        memcpy(&word, s + i, sizeof(word));
+        if (word_has_byte(word, '"') | word_has_byte(word, '\\') | word_has_control(word)) break;
+        i += 8;
+    }
+    while (i < len) {
+        unsigned char c = (unsigned char)s[i];
+        if (c == '"' || c == '\\' || c < 0x20) break;
+        i++;
+    }
+    return i;
+}
+
+/*******************************************************************************
+ * PARSER
+ ******************************************************************************/
+
+typedef struct {
+    const char* text;
+    size_t len;
+    size_t pos;
+    char* error;
+    size_t error_size;
+    int failed;
+} JsonParser;
+
+// One parsed element, stored the way an object property is
+typedef struct {
+    PropertyType type;
+    void* value;
+} JsonSlot;
+
+static void json_fail(JsonParser* p, const char* message) {
+    if (p->failed) return;
+    p->failed = 1;
+    if (p->error && p->error_size > 0) {
+        snprintf(p->error, p->error_size, "%s at offset %zu", message, p->pos);
+    }
+}
+
+static void skip_whitespace(JsonParser* p) {
+    while (p->pos < p->len) {
+        char c = p->text[p->pos];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        p->pos++;
+    }
+}
+
+static void free_slot(JsonSlot* slot) {
+    if (slot->type == PROP_TYPE_STRING && slot->value) {
+        tracked_free(slot->value, __FILE__, __LINE__, "json_string");
+    } else if (slot->type == PROP_TYPE_OBJECT) {
+        json_free_object((MycoObject*)slot->value);
+    }
+    slot->value = NULL;
+}
+
+/**
+ * @brief Frees an object produced by the parser, including its strings and nested objects
+ */
+void json_free_object(MycoObject* obj) {
+    if (!obj) return;
+    for (int i = 0; i < obj->property_count; i++) {
+        JsonSlot slot = { obj->property_types[i], obj->property_values[i] };
+        free_slot(&slot);
+    }
+    destroy_object(obj);
+}
+
+// Append a property without the duplicate scan of object_set_property_typed (name is taken over)
+static int object_append(MycoObject* obj, char* name, void* value, PropertyType type) {
+    if (obj->property_count >= obj->capacity) {
+        int new_capacity = obj->capacity ? obj->capacity * 2 : 4;
+        char** names = (char**)tracked_realloc(obj->property_names, new_capacity * sizeof(char*), __FILE__, __LINE__, "object_set_property_names");
+        if (!names) return 0;
+        obj->property_names = names;
+        void** values = (void**)tracked_realloc(obj->property_values, new_capacity * sizeof(void*), __FILE__, __LINE__, "object_set_property_values");
+        if (!values) return 0;
+        obj->property_values = values;
+        PropertyType* types = (PropertyType*)tracked_realloc(obj->property_types, new_capacity * sizeof(PropertyType), __FILE__, __LINE__, "object_set_property_types");
+        if (!types) return 0;
+        obj->property_types = types;
+        obj->capacity = new_capacity;
+    }
+    obj->property_names[obj->property_count] = name;
+    obj->property_values[obj->property_count] = value;
+    obj->property_types[obj->property_count] = type;
+    obj->property_count++;
+    return 1;
+}
+
+static char* parse_string(JsonParser* p);
+static int parse_value(JsonParser* p, int depth, JsonSlot* out, JsonSlot** array_items, int* array_count);
+
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static long parse_hex4(JsonParser* p) {
+    if (p->pos + 4 > p->len) return -1;
+    long value = 0;
+    for (int i = 0; i < 4; i++) {
+        int digit = hex_value(p->text[p->pos + i]);
+        if (digit < 0) return -1;
+        value = value * 16 + digit;
+    }
+    p->pos += 4;
+    return value;
+}
+
+static size_t encode_utf8(unsigned long cp, char* out) {
+    if (cp < 0x80) { out[0] = (char)cp; return 1; }
+    if (cp < 0x800) { out[0] = (char)(0xC0 | (cp >> 6)); out[1] = (char)(0x80 | (cp & 0x3F)); return 2; }
+    if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        return 3;
+    }
+    out[0] = (char)(0xF0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    out[3] = (char)(0x80 | (cp & 0x3F));
+    return 4;
+}
+
+/**
+ * @brief Parses a string starting at the opening quote
+ * @return New tracked string, or NULL on error
+ *
+ * Decoded output is never longer than the escaped input, so a string with
+ * escapes is decoded into one allocation sized from the remaining input.
+ */
+static char* parse_string(JsonParser* p) {
+    p->pos++; // opening quote
+    size_t run = plain_run_length(p->text + p->pos, p->len - p->pos);
+
+    // Common case: no escapes at all
+    if (p->pos + run < p->len && p->text[p->pos + run] == '"') {
+        char* result = (char*)tracked_malloc(run + 1, __FILE__, __LINE__, "json_string");
+        if (!result) {
+            json_fail(p, "out of memory");
+            return NULL;
+        }
+        memcpy(result, p->text + p->pos, run);
+        result[run] = '\0';
+        p->pos += run + 1;
+        return result;
+    }
+
+    size_t capacity = p->len - p->pos + 1;
+    char* result = (char*)tracked_malloc(capacity, __FILE__, __LINE__, "json_string");
+    if (!result) {
+        json_fail(p, "out of memory");
+        return NULL;
+    }
+    size_t out = 0;
+    for (;;) {
+        memcpy(result + out, p->text + p->pos, run);
+        out += run;
+        p->pos += run;
+        if (p->pos >= p->len) {
+            json_fail(p, "unterminated string");
+            break;
+        }
+        char c = p->text[p->pos];
+        if (c == '"') {
+            p->pos++;
+            result[out] = '\0';
+            return result;
+        }
+        if (c != '\\') {
+            json_fail(p, "control character in string");
+            break;
+        }
+        if (p->pos + 1 >= p->len) {
+            json_fail(p, "unterminated string");
+            break;
+        }
+        char e = p->text[p->pos + 1];
+        p->pos += 2;
+        switch (e) {
+            case '"': result[out++] = '"'; break;
+            case '\\': result[out++] = '\\'; break;
+            case '/': result[out++] = '/'; break;
+            case 'b': result[out++] = '\b'; break;
+            case 'f': result[out++] = '\f'; break;
+            case 'n': result[out++] = '\n'; break;
+            case 'r': result[out++] = '\r'; break;
+            case 't': result[out++] = '\t'; break;
+            case 'u': {
+                long cp = parse_hex4(p);
+                if (cp < 0) {
+                    json_fail(p, "invalid \\u escape");
+                    break;
+                }
+                // Combine a surrogate pair; a lone surrogate becomes U+FFFD
+                if (cp >= 0xD800 && cp <= 0xDBFF && p->pos + 1 < p->len &&
+                    p->text[p->pos] == '\\' && p->text[p->pos + 1] == 'u') {
+                    size_t saved = p->pos;
+                    p->pos += 2;
+                    long low = parse_hex4(p);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    } else {
+                        p->pos = saved;
+                        cp = 0xFFFD;
+                    }
+                } else if (cp >= 0xD800 && cp <= 0xDFFF) {
+                    cp = 0xFFFD;
+                }
+                out += encode_utf8((unsigned long)cp, result + out);
+                break;
+            }
+            default:
+                json_fail(p, "invalid escape");
+                break;
+        }
+        if (p->failed) break;
+        run = plain_run_length(p->text + p->pos, p->len - p->pos);
+    }
+    tracked_free(result, __FILE__, __LINE__, "json_string");
+    return NULL;
+}
+
+// Float slots keep the bits of their double in the value pointer
+static void* float_slot_value(double value) {
+    void* slot = NULL;
+    memcpy(&slot, &value, sizeof(value));
+    return slot;
+}
+
+static double slot_float_value(void* slot) {
+    double value;
+    memcpy(&value, &slot, sizeof(value));
+    return value;
+}
+
+// Integers become PROP_TYPE_NUMBER slots, numbers with a fraction or exponent PROP_TYPE_FLOAT slots
+static int parse_number(JsonParser* p, JsonSlot* out) {
+    size_t start = p->pos;
+    int negative = 0;
+    if (p->text[p->pos] == '-') {
+        negative = 1;
+        p->pos++;
+    }
+    if (p->pos >= p->len || p->text[p->pos] < '0' || p->text[p->pos] > '9') {
+        json_fail(p, "invalid number");
+        return 0;
+    }
+    // Integers are accumulated directly; floats go through strtod
+    unsigned long long magnitude = 0;
+    int overflow = 0;
+    if (p->text[p->pos] == '0') {
+        p->pos++;
+    } else {
+        while (p->pos < p->len && p->text[p->pos] >= '0' && p->text[p->pos] <= '9') {
+            unsigned digit = (unsigned)(p->text[p->pos++] - '0');
+            if (magnitude > (ULLONG_MAX - digit) / 10) overflow = 1;
+            else magnitude = magnitude * 10 + digit;
+        }
+    }
+    int fractional = 0;
+    if (p->pos < p->len && p->text[p->pos] == '.') {
+        fractional = 1;
+        p->pos++;
+        if (p->pos >= p->len || p->text[p->pos] < '0' || p->text[p->pos] > '9') {
+            json_fail(p, "invalid number");
+            return 0;
+        }
+        while (p->pos < p->len && p->text[p->pos] >= '0' && p->text[p->pos] <= '9') p->pos++;
+    }
+    if (p->pos < p->len && (p->text[p->pos] == 'e' || p->text[p->pos] == 'E')) {
+        fractional = 1;
+        p->pos++;
+        if (p->pos < p->len && (p->text[p->pos] == '+' || p->text[p->pos] == '-')) p->pos++;
+        if (p->pos >= p->len || p->text[p->pos] < '0' || p->text[p->pos] > '9') {
+            json_fail(p, "invalid number");
+            return 0;
+        }
+        while (p->pos < p->len && p->text[p->pos] >= '0' && p->text[p->pos] <= '9') p->pos++;
+    }
+
+    if (fractional) {
+        double value = strtod(p->text + start, NULL);
+        if (isinf(value)) {
+            p->pos = start;
+            json_fail(p, "number out of float range");
+            return 0;
+        }
+        out->type = PROP_TYPE_FLOAT;
+        out->value = float_slot_value(value);
+        return 1;
+    }
+    // Integers must fit 64 bits
+    long long value = 0;
+    if (negative) {
+        if (magnitude > (unsigned long long)LLONG_MAX + 1) overflow = 1;
+        else value = magnitude == (unsigned long long)LLONG_MAX + 1 ? LLONG_MIN : -(long long)magnitude;
+    } else {
+        if (magnitude > (unsigned long long)LLONG_MAX) overflow = 1;
+        else value = (long long)magnitude;
+    }
+    if (overflow) {
+        p->pos = start;
+        json_fail(p, "number out of 64-bit integer range");
+        return 0;
+    }
+    out->value = (void*)value;
+    return 1;
+}
+
+static int match_literal(JsonParser* p, const char* word) {
+    size_t n = strlen(word);
+    if (p->pos + n > p->len || memcmp(p->text + p->pos, word, n) != 0) {
+        json_fail(p, "unexpected character");
+        return 0;
+    }
+    p->pos += n;
+    return 1;
+}
+
+static void free_items(JsonSlot* items, int count) {
+    for (int i = 0; i < count; i++) free_slot(&items[i]);
+    if (items) tracked_free(items, __FILE__, __LINE__, "json_array_items");
+}
+
+// Turns parsed array elements into the "0".."n-1" + "length" object shape (items are taken over)
+static MycoObject* items_to_object(JsonParser* p, JsonSlot* items, int count) {
+    MycoObject* obj = create_object(count + 1);
+    char name[24];
+    int i = 0;
+    if (obj) {
+        for (; i < count; i++) {
+            snprintf(name, sizeof(name), "%d", i);
+            char* owned = tracked_strdup(name, __FILE__, __LINE__, "eval");
+            if (!owned || !object_append(obj, owned, items[i].value, items[i].type)) {
+                if (owned) tracked_free(owned, __FILE__, __LINE__, "eval");
+                break;
+            }
+        }
+        char* length_name = i == count ? tracked_strdup("length", __FILE__, __LINE__, "eval") : NULL;
+        if (length_name && object_append(obj, length_name, (void*)(long long)count, PROP_TYPE_NUMBER)) {
+            if (items) tracked_free(items, __FILE__, __LINE__, "json_array_items");
+            return obj;
+        }
+        if (length_name) tracked_free(length_name, __FILE__, __LINE__, "eval");
+    }
+    // Failure: the object owns items [0, i), the rest are still ours
+    json_free_object(obj);
+    for (int j = i; j < count; j++) free_slot(&items[j]);
+    if (items) tracked_free(items, __FILE__, __LINE__, "json_array_items");
+    json_fail(p, "out of memory");
+    return NULL;
+}
+
+static int parse_array_items(JsonParser* p, int depth, JsonSlot** out_items, int* out_count) {
+    p->pos++; // [
+    JsonSlot* items = NULL;
+    int count = 0, capacity = 0;
+    skip_whitespace(p);
+    if (p->pos < p->len && p->text[p->pos] == ']') {
+        p->pos++;
+        *out_items = NULL;
+        *out_count = 0;
+        return 1;
+    }
+    for (;;) {
+        if (count >= capacity) {
+            int new_capacity = capacity ? capacity * 2 : 8;
+            JsonSlot* grown = (JsonSlot*)tracked_realloc(items, new_capacity * sizeof(JsonSlot), __FILE__, __LINE__, "json_array_items");
+            if (!grown) {
+                json_fail(p, "out of memory");
+                break;
+            }
+            items = grown;
+            capacity = new_capacity;
+        }
+        if (!parse_value(p, depth + 1, &items[count], NULL, NULL)) break;
+        count++;
+        skip_whitespace(p);
+        if (p->pos < p->len && p->text[p->pos] == ',') {
+            p->pos++;
+            continue;
+        }
+        if (p->pos < p->len && p->text[p->pos] == ']') {
+            p->pos++;
+            *out_items = items;
+            *out_count = count;
+            return 1;
+        }
+        json_fail(p, "expected ',' or ']'");
+        break;
+    }
+    free_items(items, count);
+    return 0;
+}
+
+static MycoObject* parse_object(JsonParser* p, int depth) {
+    p->pos++; // {
+    MycoObject* obj = create_object(4);
+    if (!obj) {
+        json_fail(p, "out of memory");
+        return NULL;
+    }
+    skip_whitespace(p);
+    if (p->pos < p->len && p->text[p->pos] == '}') {
+        p->pos++;
+        return obj;
+    }
+    for (;;) {
+        skip_whitespace(p);
+        if (p->pos >= p->len || p->text[p->pos] != '"') {
+            json_fail(p, "expected property name");
+            break;
+        }
+        char* name = parse_string(p);
+        if (!name) break;
+        skip_whitespace(p);
+        if (p->pos >= p->len || p->text[p->pos] != ':') {
+            tracked_free(name, __FILE__, __LINE__, "json_string");
+            json_fail(p, "expected ':'");
+            break;
+        }
+        p->pos++;
+        JsonSlot slot;
+        if (!parse_value(p, depth + 1, &slot, NULL, NULL)) {
+            tracked_free(name, __FILE__, __LINE__, "json_string");
+            break;
+        }
+
+        // Duplicate keys: the last one wins
+        int existing = -1;
+        for (int i = 0; i < obj->property_count; i++) {
+            if (strcmp(obj->property_names[i], name) == 0) {
+                existing = i;
+                break;
+            }
+        }
+        if (existing >= 0) {
+            JsonSlot old = { obj->property_types[existing], obj->property_values[existing] };
+            free_slot(&old);
+            obj->property_values[existing] = slot.value;
+            obj->property_types[existing] = slot.type;
+            tracked_free(name, __FILE__, __LINE__, "json_string");
+        } else if (!object_append(obj, name, slot.value, slot.type)) {
+            tracked_free(name, __FILE__, __LINE__, "json_string");
+            free_slot(&slot);
+            json_fail(p, "out of memory");
+            break;
+        }
+
+        skip_whitespace(p);
+        if (p->pos < p->len && p->text[p->pos] == ',') {
+            p->pos++;
+            continue;
+        }
+        if (p->pos < p->len && p->text[p->pos] == '}') {
+            p->pos++;
+            return obj;
+        }
+        json_fail(p, "expected ',' or '}'");
+        break;
+    }
+    json_free_object(obj);
+    return NULL;
+}
+
+/**
+ * @brief Parses any value into a property-shaped slot
+ * @param array_items When non-NULL, a top-level array is returned as raw items instead of an object
+ */
+static int parse_value(JsonParser* p, int depth, JsonSlot* out, JsonSlot** array_items, int* array_count) {
+    if (depth > JSON_MAX_DEPTH) {
+        json_fail(p, "nesting too deep");
+        return 0;
+    }
+    skip_whitespace(p);
+    if (p->pos >= p->len) {
+        json_fail(p, "unexpected end of input");
+        return 0;
+    }
+    out->type = PROP_TYPE_NUMBER;
+    out->value = NULL;
+    char c = p->text[p->pos];
+    switch (c) {
+        case '{': {
+            MycoObject* obj = parse_object(p, depth);
+            if (!obj) return 0;
+            out->type = PROP_TYPE_OBJECT;
+            out->value = obj;
+            return 1;
+        }
+        case '[': {
+            JsonSlot* items;
+            int count;
+            if (!parse_array_items(p, depth, &items, &count)) return 0;
+            if (array_items) {
+                *array_items = items;
+                *array_count = count;
+                return 1;
+            }
+            MycoObject* obj = items_to_object(p, items, count);
+            if (!obj) return 0;
+            out->type = PROP_TYPE_OBJECT;
+            out->value = obj;
+            return 1;
+        }
+        case '"': {
+            char* str = parse_string(p);
+            if (!str) return 0;
+            out->type = PROP_TYPE_STRING;
+            out->value = str;
+            return 1;
+        }
+        case 't':
+            if (!match_literal(p, "true")) return 0;
+            out->value = (void*)1LL;
+            return 1;
+        case 'f':
+            if (!match_literal(p, "false")) return 0;
+            return 1;
+        case 'n':
+            return match_literal(p, "null");
+        default:
+            if (c != '-' && (c < '0' || c > '9')) {
+                json_fail(p, "unexpected character");
+                return 0;
+            }
+            return parse_number(p, out);
+    }
+}
+
+// Builds the caller-facing value for one top-level element
+static int parse_top_level(JsonParser* p, JsonValue* out) {
+    memset(out, 0, sizeof(*out));
+    JsonSlot slot;
+    JsonSlot* items = NULL;
+    int count = -1;
+    if (!parse_value(p, 0, &slot, &items, &count)) return 0;
+
+    if (count >= 0) {
+        // Arrays of only strings or only integers map onto MycoArray; anything else keeps the object shape
+        int strings = 0, numbers = 0;
+        for (int i = 0; i < count; i++) {
+            if (items[i].type == PROP_TYPE_STRING) strings++;
+            else if (items[i].type == PROP_TYPE_NUMBER) numbers++;
+        }
+        if (strings == count || numbers == count) {
+            MycoArray* array = create_array(count, strings == count && count > 0);
+            if (!array) {
+                free_items(items, count);
+                json_fail(p, "out of memory");
+                return 0;
+            }
+            for (int i = 0; i < count; i++) {
+                if (array->is_string_array) {
+                    // Elements are moved in rather than copied by array_push
+                    array->str_elements[array->size++] = (char*)items[i].value;
+                } else {
+                    array->elements[array->size++] = (long long)items[i].value;
+                }
+            }
+            if (items) tracked_free(items, __FILE__, __LINE__, "json_array_items");
+            out->type = JSON_VALUE_ARRAY;
+            out->array = array;
+            return 1;
+        }
+        MycoObject* obj = items_to_object(p, items, count);
+        if (!obj) return 0;
+        out->type = JSON_VALUE_OBJECT;
+        out->object = obj;
+        return 1;
+    }
+
+    switch (slot.type) {
+        case PROP_TYPE_OBJECT:
+            out->type = JSON_VALUE_OBJECT;
+            out->object = (MycoObject*)slot.value;
+            break;
+        case PROP_TYPE_STRING:
+            out->type = JSON_VALUE_STRING;
+            out->string = (char*)slot.value;
+            break;
+        case PROP_TYPE_FLOAT:
+            out->type = JSON_VALUE_FLOAT;
+            out->float_number = slot_float_value(slot.value);
+            break;
+        default:
+            out->type = JSON_VALUE_NUMBER;
+            out->number = (long long)slot.value;
+            break;
+    }
+    return 1;
+}
+
+/**
+ * @brief Parses a complete JSON document
+ * @param text Document text (NUL-terminated at len)
+ * @param len Document length
+ * @param out Receives the value (free with json_value_free)
+ * @param error Receives a message with the byte offset on failure (may be NULL)
+ * @return 1 on success, 0 on a syntax error
+ */
+int json_parse(const char* text, size_t len, JsonValue* out, char* error, size_t error_size) {
+    JsonParser parser = { text, len, 0, error, error_size, 0 };
+    if (!parse_top_level(&parser, out)) return 0;
+    skip_whitespace(&parser);
+    if (parser.pos < parser.len) {
+        json_fail(&parser, "unexpected data after value");
+        json_value_free(out);
+        return 0;
+    }
+    return 1;
+}
+
+void json_value_free(JsonValue* value) {
+    if (!value) return;
+    if (value->string) tracked_free(value->string, __FILE__, __LINE__, "json_string");
+    if (value->object) json_free_object(value->object);
+    if (value->array) destroy_array(value->array);
+    memset(value, 0, sizeof(*value));
+}
+
+/*******************************************************************************
+ * STREAMING
+ ******************************************************************************/
+
+struct JsonStream {
+    char* text;         // Unconsumed input (NUL-terminated at len)
+    size_t len;
+    size_t capacity;
+    size_t pos;         // Start of the next element
+    FILE* file;         // Source of further input, NULL once it is all in text
+    int read_failed;
+    int in_array;       // Iterating the elements of one top-level array
+    int done;
+};
+
+/**
+ * @brief Reads the next chunk of a file stream into its window
+ *
+ * Input before stream->pos has been consumed and is dropped first, so the
+ * window only grows when a single element is larger than it.
+ * @param pos A position in the window, moved along with the data
+ * @return 1 if more input arrived, 0 at the end of the file
+ */
+static int stream_refill(JsonStream* stream, size_t* pos) {
+    if (!stream->file) return 0;
+    if (stream->pos > 0) {
+        memmove(stream->text, stream->text + stream->pos, stream->len - stream->pos);
+        stream->len -= stream->pos;
+        *pos -= stream->pos;
+        stream->pos = 0;
+    }
+    if (stream->capacity - stream->len - 1 < JSON_FILE_BUFFER_SIZE / 2) {
+        char* grown = (char*)tracked_realloc(stream->text, stream->capacity * 2, __FILE__, __LINE__, "json_stream_text");
+        if (!grown) {
+            stream->read_failed = 1;
+            return 0;
+        }
+        stream->text = grown;
+        stream->capacity *= 2;
+    }
+    size_t got = fread(stream->text + stream->len, 1, stream->capacity - stream->len - 1, stream->file);
+    stream->len += got;
+    stream->text[stream->len] = '\0';
+    if (got == 0) {
+        if (ferror(stream->file)) stream->read_failed = 1;
+        fclose(stream->file);
+        stream->file = NULL;
+    }
+    return got > 0;
+}
+
+// Position of the first non-whitespace byte at or after pos, reading on as needed
+static size_t stream_skip_whitespace(JsonStream* stream, size_t pos) {
+    for (;;) {
+        while (pos < stream->len) {
+            char c = stream->text[pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') return pos;
+            pos++;
+        }
+        if (!stream_refill(stream, &pos)) return pos;
+    }
+}
+
+/**
+ * @brief Reads on until the value starting at stream->pos is wholly in the window
+ *
+ * Tracks strings and bracket depth only; the parser does the validating.
+ * A bare scalar ends at the first delimiter after it, so it needs one byte
+ * of lookahead (or the end of the file).
+ */
+static void stream_load_value(JsonStream* stream) {
+    if (!stream->file) return;
+    size_t pos = stream->pos;
+    int depth = 0, in_string = 0, escaped = 0;
+    for (;;) {
+        while (pos < stream->len) {
+            char c = stream->text[pos++];
+            if (in_string) {
+                if (escaped) escaped = 0;
+                else if (c == '\\') escaped = 1;
+                else if (c == '"') {
+                    in_string = 0;
+                    if (depth == 0) return;
+                }
+            } else if (c == '"') {
+                in_string = 1;
+            } else if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth <= 0) return;
+            } else if (depth == 0 && (c == ',' || c == ' ' || c == '\n' || c == '\r' || c == '\t')) {
+                return;
+            }
+        }
+        if (!stream_refill(stream, &pos)) return;
+    }
+}
+
+static JsonStream* stream_create(char* text, size_t len, size_t capacity, FILE* file) {
+    JsonStream* stream = (JsonStream*)tracked_malloc(sizeof(JsonStream), __FILE__, __LINE__, "json_stream");
+    if (!stream) return NULL;
+    stream->text = text;
+    stream->len = len;
+    stream->capacity = capacity;
+    stream->pos = 0;
+    stream->file = file;
+    stream->read_failed = 0;
+    stream->done = 0;
+
+    size_t start = stream_skip_whitespace(stream, 0);
+    stream->in_array = start < stream->len && stream->text[start] == '[';
+    stream->pos = stream->in_array ? start + 1 : start;
+    return stream;
+}
+
+/**
+ * @brief Opens a stream over a document held in memory
+ *
+ * A document whose first token is '[' yields the elements of that array;
+ * any other document is read as a sequence of values separated by
+ * whitespace, which covers NDJSON.
+ * @param text Tracked buffer NUL-terminated at len; the stream takes it over
+ */
+JsonStream* json_stream_open(char* text, size_t len) {
+    JsonStream* stream = stream_create(text, len, len + 1, NULL);
+    if (!stream) tracked_free(text, __FILE__, __LINE__, "json_stream_text");
+    return stream;
+}
+
+/**
+ * @brief Opens a stream that reads a file in 64 KB chunks
+ * @return The stream, or NULL if the file cannot be opened
+ */
+JsonStream* json_stream_open_file(const char* filename) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) return NULL;
+    size_t capacity = JSON_FILE_BUFFER_SIZE;
+    char* text = (char*)tracked_malloc(capacity, __FILE__, __LINE__, "json_stream_text");
+    if (!text) {
+        fclose(file);
+        return NULL;
+    }
+    text[0] = '\0';
+    JsonStream* stream = stream_create(text, 0, capacity, file);
+    if (!stream) {
+        tracked_free(text, __FILE__, __LINE__, "json_stream_text");
+        fclose(file);
+    }
+    return stream;
+}
+
+/**
+ * @brief Parses the next element
+ * @return 1 with a value in out, 0 at the end of the stream, -1 on a syntax or read error
+ */
+int json_stream_next(JsonStream* stream, JsonValue* out, char* error, size_t error_size) {
+    if (!stream || stream->done) return 0;
+    stream->pos = stream_skip_whitespace(stream, stream->pos);
+    JsonParser parser = { stream->text, stream->len, stream->pos, error, error_size, 0 };
+    if (stream->read_failed) {
+        json_fail(&parser, "read error");
+        stream->done = 1;
+        return -1;
+    }
+
+    if (stream->in_array) {
+        if (stream->pos < stream->len && stream->text[stream->pos] == ']') {
+            stream->done = 1;
+            return 0;
+        }
+    } else if (stream->pos >= stream->len) {
+        stream->done = 1;
+        return 0;
+    }
+
+    stream_load_value(stream);
+    parser.text = stream->text;
+    parser.len = stream->len;
+    parser.pos = stream->pos;
+    if (stream->read_failed) {
+        json_fail(&parser, "read error");
+        stream->done = 1;
+        return -1;
+    }
+    if (!parse_top_level(&parser, out)) {
+        stream->done = 1;
+        return -1;
+    }
+
+    if (stream->in_array) {
+        stream->pos = parser.pos;
+        parser.pos = stream_skip_whitespace(stream, parser.pos);
+        parser.text = stream->text;
+        parser.len = stream->len;
+        if (parser.pos < parser.len && parser.text[parser.pos] == ',') {
+            parser.pos++;
+        } else if (parser.pos >= parser.len || parser.text[parser.pos] != ']') {
+            json_fail(&parser, "expected ',' or ']'");
+            json_value_free(out);
+            stream->done = 1;
+            return -1;
+        }
+    }
+    stream->pos = parser.pos;
+    return 1;
+}
+
+// 1 if another element follows (does not validate it)
+int json_stream_has_next(JsonStream* stream) {
+    if (!stream || stream->done) return 0;
+    stream->pos = stream_skip_whitespace(stream, stream->pos);
+    if (stream->pos >= stream->len) return 0;
+    return !stream->in_array || stream->text[stream->pos] != ']';
+}
+
+void json_stream_close(JsonStream* stream) {
+    if (!stream) return;
+    if (stream->file) fclose(stream->file);
+    tracked_free(stream->text, __FILE__, __LINE__, "json_stream_text");
+    tracked_free(stream, __FILE__, __LINE__, "json_stream");
+}
+
+/*******************************************************************************
+ * WRITER
+ ******************************************************************************/
+
+/**
+ * @brief Prepares a writer
+ * @param file Destination file, or NULL to collect the output in memory
+ */
+void json_writer_init(JsonWriter* writer, FILE* file) {
+    writer->file = file;
+    writer->len = 0;
+    writer->failed = 0;
+    writer->capacity = file ? JSON_FILE_BUFFER_SIZE : 256;
+    writer->data = (char*)tracked_malloc(writer->capacity, __FILE__, __LINE__, "json_writer");
+    if (!writer->data) {
+        writer->capacity = 0;
+        writer->failed = 1;
+    }
+}
+
+static void writer_flush(JsonWriter* writer) {
+    if (writer->file && writer->len > 0) {
+        if (fwrite(writer->data, 1, writer->len, writer->file) != writer->len) writer->failed = 1;
+        writer->len = 0;
+    }
+}
+
+static void writer_put(JsonWriter* writer, const char* bytes, size_t len) {
+    if (writer->failed) return;
+    if (writer->len + len > writer->capacity) {
+        if (writer->file) {
+            writer_flush(writer);
+            if (len > writer->capacity) {
+                // Too large for the buffer: write it straight through
+                if (fwrite(bytes, 1, len, writer->file) != len) writer->failed = 1;
+                return;
+            }
+        } else {
+            size_t new_capacity = writer->capacity * 2;
+            while (new_capacity < writer->len + len) new_capacity *= 2;
+            char* grown = (char*)tracked_realloc(writer->data, new_capacity, __FILE__, __LINE__, "json_writer");
+            if (!grown) {
+                writer->failed = 1;
+                return;
+            }
+            writer->data = grown;
+            writer->capacity = new_capacity;
+        }
+    }
+    memcpy(writer->data + writer->len, bytes, len);
+    writer->len += len;
+}
+
+void json_write_number(JsonWriter* writer, long long number) {
+    char digits[24];
+    int n = snprintf(digits, sizeof(digits), "%lld", number);
+    writer_put(writer, digits, (size_t)n);
+}
+
+/**
+ * @brief Writes the shortest text that reads back as the same double
+ *
+ * Values from 1e-5 up to 1e16 use plain notation with at least one decimal
+ * so they parse back as floats; NaN and infinities have no JSON form and
+ * are written as null.
+ */
+void json_write_float(JsonWriter* writer, double number) {
+    if (isnan(number) || isinf(number)) {
+        writer_put(writer, "null", 4);
+        return;
+    }
+    char digits[40];
+    int n = 0;
+    int found = 0;
+    double magnitude = fabs(number);
+    if (magnitude == 0 || (magnitude >= 1e-5 && magnitude < 1e16)) {
+        for (int decimals = 1; decimals <= 17 && !found; decimals++) {
+            n = snprintf(digits, sizeof(digits), "%.*f", decimals, number);
+            found = strtod(digits, NULL) == number;
+        }
+    }
+    for (int precision = 1; precision <= 17 && !found; precision++) {
+        n = snprintf(digits, sizeof(digits), "%.*g", precision, number);
+        found = strtod(digits, NULL) == number;
+    }
+    if (!strpbrk(digits, ".e")) {
+        memcpy(digits + n, ".0", 3);
+        n += 2;
+    }
+    writer_put(writer, digits, (size_t)n);
+}
+
+/**
+ * @brief Writes a quoted, escaped string
+ *
+ * Runs that need no escaping are found with the same word-at-a-time scan
+ * as the parser and copied in one piece.
+ */
+void json_write_string(JsonWriter* writer, const char* str, size_t len) {
+    writer_put(writer, "\"", 1);
+    size_t pos = 0;
+    while (pos < len) {
+        size_t run = plain_run_length(str + pos, len - pos);
+        writer_put(writer, str + pos, run);
+        pos += run;
+        if (pos >= len) break;
+        unsigned char c = (unsigned char)str[pos++];
+        char escape[8];
+        switch (c) {
+            case '"': writer_put(writer, "\\\"", 2); break;
+            case '\\': writer_put(writer, "\\\\", 2); break;
+            case '\n': writer_put(writer, "\\n", 2); break;
+            case '\r': writer_put(writer, "\\r", 2); break;
+            case '\t': writer_put(writer, "\\t", 2); break;
+            case '\b': writer_put(writer, "\\b", 2); break;
+            case '\f': writer_put(writer, "\\f", 2); break;
+            default:
+                snprintf(escape, sizeof(escape), "\\u%04x", c);
+                writer_put(writer, escape, 6);
+                break;
+        }
+    }
+    writer_put(writer, "\"", 1);
+}
+
+// Whether obj has exactly the "0".."n-1" + "length" shape the parser gives nested arrays
+static int is_array_shaped(MycoObject* obj) {
+    int n = obj->property_count - 1;
+    if (n < 0 || strcmp(obj->property_names[n], "length") != 0) return 0;
+    if (obj->property_types[n] != PROP_TYPE_NUMBER || (long long)obj->property_values[n] != n) return 0;
+    char name[24];
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "%d", i);
+        if (strcmp(obj->property_names[i], name) != 0) return 0;
+    }
+    return 1;
+}
+
+static void write_property_value(JsonWriter* writer, void* value, PropertyType type, int depth);
+
+static void write_object_at(JsonWriter* writer, MycoObject* obj, int depth) {
+    if (!obj || depth > JSON_MAX_DEPTH) {
+        writer_put(writer, "null", 4);
+        return;
+    }
+    if (is_array_shaped(obj)) {
+        writer_put(writer, "[", 1);
+        for (int i = 0; i < obj->property_count - 1; i++) {
+            if (i > 0) writer_put(writer, ",", 1);
+            write_property_value(writer, obj->property_values[i], obj->property_types[i], depth + 1);
+        }
+        writer_put(writer, "]", 1);
+        return;
+    }
+    writer_put(writer, "{", 1);
+    for (int i = 0; i < obj->property_count; i++) {
+        if (i > 0) writer_put(writer, ",", 1);
+        json_write_string(writer, obj->property_names[i], strlen(obj->property_names[i]));
+        writer_put(writer, ":", 1);
+        write_property_value(writer, obj->property_values[i], obj->property_types[i], depth + 1);
+    }
+    writer_put(writer, "}", 1);
+}
+
+static void write_property_value(JsonWriter* writer, void* value, PropertyType type, int depth) {
+    switch (type) {
+        case PROP_TYPE_STRING: {
+            const char* str = value ? (const char*)value : "";
+            json_write_string(writer, str, strlen(str));
+            break;
+        }
+        case PROP_TYPE_OBJECT:
+            write_object_at(writer, (MycoObject*)value, depth);
+            break;
+        case PROP_TYPE_FLOAT:
+            json_write_float(writer, slot_float_value(value));
+            break;
+        default:
+            json_write_number(writer, (long long)value);
+            break;
+    }
+}
+
+void json_write_object(JsonWriter* writer, MycoObject* obj) {
+    write_object_at(writer, obj, 0);
+}
+
+void json_write_array(JsonWriter* writer, MycoArray* array) {
+    writer_put(writer, "[", 1);
+    for (int i = 0; array && i < array->size; i++) {
+        if (i > 0) writer_put(writer, ",", 1);
+        if (array->is_string_array) {
+            const char* str = array->str_elements[i] ? array->str_elements[i] : "";
+            json_write_string(writer, str, strlen(str));
+        } else {
+            json_write_number(writer, array->elements[i]);
+        }
+    }
+    writer_put(writer, "]", 1);
+}
+
+/**
+ * @brief Completes the output
+ * @return In memory mode the NUL-terminated JSON text (caller frees), or NULL on failure;
+ *         in file mode the buffer is flushed and NULL is returned (check writer->failed)
+ */
+char* json_writer_finish(JsonWriter* writer, size_t* out_len) {
+    char* result = NULL;
+    if (writer->file) {
+        writer_flush(writer);
+    } else {
+        if (!writer->failed && writer->len + 1 > writer->capacity) {
+            char* grown = (char*)tracked_realloc(writer->data, writer->len + 1, __FILE__, __LINE__, "json_writer");
+            if (grown) {
+                writer->data = grown;
+                writer->capacity = writer->len + 1;
+            } else {
+                writer->failed = 1;
+            }
+        }
+        if (!writer->failed) {
+            writer->data[writer->len] = '\0';
+            result = writer->data;
+            writer->data = NULL;
+            if (out_len) *out_len = writer->len;
+        }
+    }
+    if (writer->data) tracked_free(writer->data, __FILE__, __LINE__, "json_writer");
+    writer->data = NULL;
+    writer->capacity = 0;
+    return result;
+}
@@ -0,0 +1,314 @@
+/**
+ * @file matrix.c
+ * @brief Myco Matrices - Dense row-major numeric matrices
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the matrix values of the data library. A matrix
+ * is one contiguous row-major buffer of int64 or float64 elements, so row
+ * scans are sequential memory reads and the kernels below run as plain C
+ * loops instead of interpreted index arithmetic over arrays of arrays.
+ *
+ * Matrix Features:
+ * - int64 and float64 element types (integer kernels switch to float64
+ *   when a bound check shows the result could overflow)
+ * - Row/column slicing and tiled transpose
+ * - Element-wise arithmetic and scaling
+ * - Sum, min, max and mean over all elements, columns or rows
+ * - Cache-blocked matrix multiply (i-k-j order: the innermost loop walks
+ *   rows of b and the result contiguously, so it vectorizes)
+ */
+
+#include "matrix.h"
+#include "memory_tracker.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MATRIX_TILE 32           // Transpose tile edge
+#define MATRIX_BLOCK_I 64        // Matmul block: rows of a
+#define MATRIX_BLOCK_K 64        // Matmul block: columns of a / rows of b
+#define MATRIX_BLOCK_J 256       // Matmul block: columns of b (64 x 256 doubles of b = 128 KB)
+
+// Integer kernels run only while every intermediate stays below this (margin under 2^63)
+#define MATRIX_INT_LIMIT 4.0e18
+
+/*******************************************************************************
+ * STORAGE
+ ******************************************************************************/
+
+Matrix* matrix_create(size_t rows, size_t cols, MatrixType type) {
+    Matrix* matrix = (Matrix*)tracked_malloc(sizeof(Matrix), __FILE__, __LINE__, "matrix");
+    if (!matrix) return NULL;
+    size_t count = rows * cols;
+    size_t bytes = (count > 0 ? count : 1) * (type == MATRIX_FLOAT64 ? sizeof(double) : sizeof(long long));
+    void* data = tracked_malloc(bytes, __FILE__, __LINE__, "matrix_data");
+    if (!data) {
+        tracked_free(matrix, __FILE__, __LINE__, "matrix");
+        return NULL;
+    }
+    memset(data, 0, bytes);
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->type = type;
+    matrix->ints = type == MATRIX_INT64 ? (long long*)data : NULL;
+    matrix->floats = type == MATRIX_FLOAT64 ? (double*)data : NULL;
+    return matrix;
+}
+
+void matrix_free(Matrix* matrix) {
+    if (!matrix) return;
+    if (matrix->ints) tracked_free(matrix->ints, __FILE__, __LINE__, "matrix_data");
+    if (matrix->floats) tracked_free(matrix->floats, __FILE__, __LINE__, "matrix_data");
+    tracked_free(matrix, __FILE__, __LINE__, "matrix");
+}
+
+Matrix* matrix_copy(const Matrix* matrix) {
+    Matrix* copy = matrix_create(matrix->rows, matrix->cols, matrix->type);
+    if (!copy) return NULL;
+    size_t count = matrix->rows * matrix->cols;
+    if (matrix->type == MATRIX_FLOAT64) memcpy(copy->floats, matrix->floats, count * sizeof(double));
+    else memcpy(copy->ints, matrix->ints, count * sizeof(long long));
+    return copy;
+}
+
+int matrix_promote(Matrix* matrix) {
+    if (matrix->type == MATRIX_FLOAT64) return 1;
+    size_t count = matrix->rows * matrix->cols;
+    double* floats = (double*)tracked_malloc((count > 0 ? count : 1) * sizeof(double), __FILE__, __LINE__, "matrix_data");
+    if (!floats) return 0;
+    for (size_t i = 0; i < count; i++) floats[i] = (double)matrix->ints[i];
+    tracked_free(matrix->ints, __FILE__, __LINE__, "matrix_data");
+    matrix->ints = NULL;
+    matrix->floats = floats;
+    matrix->type = MATRIX_FLOAT64;
+    return 1;
+}
+
+double matrix_float_at(const Matrix* matrix, size_t row, size_t col) {
+    size_t i = row * matrix->cols + col;
+    return matrix->type == MATRIX_FLOAT64 ? matrix->floats[i] : (double)matrix->ints[i];
+}
+
+// float64 view of a matrix: the matrix itself, or a promoted copy (*temp set) for int64
+static const Matrix* float_view(const Matrix* matrix, Matrix** temp) {
+    *temp = NULL;
+    if (matrix->type == MATRIX_FLOAT64) return matrix;
+    *temp = matrix_copy(matrix);
+    if (*temp && !matrix_promote(*temp)) {
+        matrix_free(*temp);
+        *temp = NULL;
+    }
+    return *temp;
+}
+
+static double max_abs(const Matrix* matrix) {
+    size_t count = matrix->rows * matrix->cols;
+    double best = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double v = fabs(matrix->type == MATRIX_FLOAT64 ? matrix->floats[i] : (double)matrix->ints[i]);
+        if (v > best) best = v;
+    }
+    return best;
+}
+
+/*******************************************************************************
+ * SLICING AND TRANSPOSE
+ ******************************************************************************/
+
+Matrix* matrix_slice(const Matrix* matrix, size_t row_start, size_t row_end, size_t col_start, size_t col_end) {
+    Matrix* slice = matrix_create(row_end - row_start, col_end - col_start, matrix->type);
+    if (!slice) return NULL;
+    size_t width = col_end - col_start;
+    for (size_t r = row_start; r < row_end; r++) {
+        size_t from = r * matrix->cols + col_start;
+        size_t to = (r - row_start) * width;
+        if (matrix->type == MATRIX_FLOAT64) memcpy(slice->floats + to, matrix->floats + from, width * sizeof(double));
+        else memcpy(slice->ints + to, matrix->ints + from, width * sizeof(long long));
+    }
+    return slice;
+}
+
+Matrix* matrix_transpose(const Matrix* matrix) {
+    size_t rows = matrix->rows, cols = matrix->cols;
+    Matrix* result = matrix_create(cols, rows, matrix->type);
+    if (!result) return NULL;
+    // Tile by tile, so both the reads and the strided writes stay within cached lines
+    for (size_t rr = 0; rr < rows; rr += MATRIX_TILE) {
+        size_t r_end = rr + MATRIX_TILE < rows ? rr + MATRIX_TILE : rows;
+        for (size_t cc = 0; cc < cols; cc += MATRIX_TILE) {
+            size_t c_end = cc + MATRIX_TILE < cols ? cc + MATRIX_TILE : cols;
+            for (size_t r = rr; r < r_end; r++) {
+                for (size_t c = cc; c < c_end; c++) {
+                    if (matrix->type == MATRIX_FLOAT64) result->floats[c * rows + r] = matrix->floats[r * cols + c];
+                    else result->ints[c * rows + r] = matrix->ints[r * cols + c];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+/*******************************************************************************
+ * ELEMENT-WISE ARITHMETIC
+ ******************************************************************************/
+
+Matrix* matrix_elementwise(const Matrix* a, const Matrix* b, MatrixOp op) {
+    size_t count = a->rows * a->cols;
+    int use_ints = a->type == MATRIX_INT64 && b->type == MATRIX_INT64 && op != MATRIX_DIV;
+    if (use_ints) {
+        double bound = op == MATRIX_MUL ? max_abs(a) * max_abs(b) : max_abs(a) + max_abs(b);
+        use_ints = bound < MATRIX_INT_LIMIT;
+    }
+    if (use_ints) {
+        Matrix* result = matrix_create(a->rows, a->cols, MATRIX_INT64);
+        if (!result) return NULL;
+        const long long* x = a->ints;
+        const long long* y = b->ints;
+        long long* z = result->ints;
+        switch (op) {
+            case MATRIX_ADD: for (size_t i = 0; i < count; i++) z[i] = x[i] + y[i]; break;
+            case MATRIX_SUB: for (size_t i = 0; i < count; i++) z[i] = x[i] - y[i]; break;
+            default: for (size_t i = 0; i < count; i++) z[i] = x[i] * y[i]; break;
+        }
+        return result;
+    }
+
+    Matrix* temp_a;
+    Matrix* temp_b;
+    const Matrix* fa = float_view(a, &temp_a);
+    const Matrix* fb = float_view(b, &temp_b);
+    Matrix* result = fa && fb ? matrix_create(a->rows, a->cols, MATRIX_FLOAT64) : NULL;
+    if (result) {
+        const double* x = fa->floats;
+        const double* y = fb->floats;
+        double* z = result->floats;
+        switch (op) {
+            case MATRIX_ADD: for (size_t i = 0; i < count; i++) z[i] = x[i] + y[i]; break;
+            case MATRIX_SUB: for (size_t i = 0; i < count; i++) z[i] = x[i] - y[i]; break;
+            case MATRIX_MUL: for (size_t i = 0; i < count; i++) z[i] = x[i] * y[i]; break;
+            case MATRIX_DIV: for (size_t i = 0; i < count; i++) z[i] = x[i] / y[i]; break;
+        }
+    }
+    matrix_free(temp_a);
+    matrix_free(temp_b);
+    return result;
+}
+
+Matrix* matrix_scale(const Matrix* matrix, int factor_is_float, long long int_factor, double float_factor) {
+    size_t count = matrix->rows * matrix->cols;
+    if (!factor_is_float && matrix->type == MATRIX_INT64 &&
+        max_abs(matrix) * fabs((double)int_factor) < MATRIX_INT_LIMIT) {
+        Matrix* result = matrix_create(matrix->rows, matrix->cols, MATRIX_INT64);
+        if (!result) return NULL;
+        for (size_t i = 0; i < count; i++) result->ints[i] = matrix->ints[i] * int_factor;
+        return result;
+    }
+    double factor = factor_is_float ? float_factor : (double)int_factor;
+    Matrix* temp;
+    const Matrix* source = float_view(matrix, &temp);
+    Matrix* result = source ? matrix_create(matrix->rows, matrix->cols, MATRIX_FLOAT64) : NULL;
+    if (result) {
+        for (size_t i = 0; i < count; i++) result->floats[i] = source->floats[i] * factor;
+    }
+    matrix_free(temp);
+    return result;
+}
+
+/*******************************************************************************
+ * REDUCTIONS
+ ******************************************************************************/
+
+Matrix* matrix_reduce(const Matrix* matrix, MatrixReduction reduction, int axis) {
+    size_t rows = matrix->rows, cols = matrix->cols;
+    size_t out_rows = axis == 1 ? rows : 1;
+    size_t out_cols = axis == 0 ? cols : 1;
+    // How many elements fold into each output
+    size_t span = axis == 0 ? rows : axis == 1 ? cols : rows * cols;
+
+    int use_ints = matrix->type == MATRIX_INT64 && reduction != MATRIX_MEAN;
+    if (use_ints && reduction == MATRIX_SUM) use_ints = max_abs(matrix) * (double)span < MATRIX_INT_LIMIT;
+    Matrix* result = matrix_create(out_rows, out_cols, use_ints ? MATRIX_INT64 : MATRIX_FLOAT64);
+    if (!result || span == 0) return result;
+
+    size_t outputs = out_rows * out_cols;
+    for (size_t o = 0; o < outputs; o++) {
+        // Output o folds a run of elements: a column (stride cols), a row, or everything
+        size_t start = axis == 0 ? o : axis == 1 ? o * cols : 0;
+        size_t stride = axis == 0 ? cols : 1;
+        if (use_ints) {
+            const long long* x = matrix->ints + start;
+            long long acc = x[0];
+            for (size_t i = 1; i < span; i++) {
+                long long v = x[i * stride];
+                if (reduction == MATRIX_SUM) acc += v;
+                else if (reduction == MATRIX_MIN ? v < acc : v > acc) acc = v;
+            }
+            result->ints[o] = acc;
+        } else {
+            double acc = matrix->type == MATRIX_FLOAT64 ? matrix->floats[start] : (double)matrix->ints[start];
+            for (size_t i = 1; i < span; i++) {
+                size_t at = start + i * stride;
+                double v = matrix->type == MATRIX_FLOAT64 ? matrix->floats[at] : (double)matrix->ints[at];
+                if (reduction == MATRIX_SUM || reduction == MATRIX_MEAN) acc += v;
+                else if (reduction == MATRIX_MIN ? v < acc : v > acc) acc = v;
+            }
+            result->floats[o] = reduction == MATRIX_MEAN ? acc / (double)span : acc;
+        }
+    }
+    return result;
+}
+
+/*******************************************************************************
+ * MATRIX MULTIPLY
+ ******************************************************************************/
+
+/**
+ * @brief c += a * b over blocks, for one element type
+ *
+ * The j loop is innermost: for a fixed a[i][k] it streams one row of b
+ * and one row of c, both contiguous. Blocking keeps the 64 x 256 panel of
+ * b in cache while every row of the i block reuses it.
+ */
+#define MATRIX_MATMUL_KERNEL(T, A, B, C, n, k, m)                                   \
+    for (size_t ii = 0; ii < (n); ii += MATRIX_BLOCK_I) {                           \
+        size_t i_end = ii + MATRIX_BLOCK_I < (n) ? ii + MATRIX_BLOCK_I : (n);       \
+        for (size_t kk = 0; kk < (k); kk += MATRIX_BLOCK_K) {                       \
+            size_t k_end = kk + MATRIX_BLOCK_K < (k) ? kk + MATRIX_BLOCK_K : (k);   \
+            for (size_t jj = 0; jj < (m); jj += MATRIX_BLOCK_J) {                   \
+                size_t j_end = jj + MATRIX_BLOCK_J < (m) ? jj + MATRIX_BLOCK_J : (m); \
+                for (size_t i = ii; i < i_end; i++) {                               \
+                    T* c_row = (C) + i * (m);                                       \
+                    for (size_t p = kk; p < k_end; p++) {                           \
+                        T scale = (A)[i * (k) + p];                                 \
+                        const T* b_row = (B) + p * (m);                             \
+                        for (size_t j = jj; j < j_end; j++) c_row[j] += scale * b_row[j]; \
+                    }                                                               \
+                }                                                                   \
+            }                                                                       \
+        }                                                                           \
+    }
+
+Matrix* matrix_matmul(const Matrix* a, const Matrix* b) {
+    size_t n = a->rows, k = a->cols, m = b->cols;
+    int use_ints = a->type == MATRIX_INT64 && b->type == MATRIX_INT64 &&
+                   max_abs(a) * max_abs(b) * (double)k < MATRIX_INT_LIMIT;
+    if (use_ints) {
+        Matrix* result = matrix_create(n, m, MATRIX_INT64);
+        if (!result) return NULL;
+        MATRIX_MATMUL_KERNEL(long long, a->ints, b->ints, result->ints, n, k, m)
+        return result;
+    }
+
+    Matrix* temp_a;
+    Matrix* temp_b;
+    const Matrix* fa = float_view(a, &temp_a);
+    const Matrix* fb = float_view(b, &temp_b);
+    Matrix* result = fa && fb ? matrix_create(n, m, MATRIX_FLOAT64) : NULL;
+    if (result) {
+        MATRIX_MATMUL_KERNEL(double, fa->floats, fb->floats, result->floats, n, k, m)
+    }
+    matrix_free(temp_a);
+    matrix_free(temp_b);
+    return result;
+}
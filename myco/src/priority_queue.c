@@ -0,0 +1,139 @@
+/**
+ * @file priority_queue.c
+ * @brief Myco Priority Queues - Contiguous 4-ary heaps
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the queue behind data.create_priority_queue(). A
+ * heap keeps only the front element ordered, so push and pop cost
+ * O(log n) instead of re-sorting the whole array after every insertion.
+ *
+ * Priority Queue Features:
+ * - 4-ary layout: half the depth of a binary heap, and the four children
+ *   of a node sit next to each other in memory
+ * - Min or max ordering chosen at creation
+ * - Numeric priorities with number or string payloads
+ * - O(n) bottom-up heapify of an existing array (Floyd's method)
+ */
+
+#include "priority_queue.h"
+#include "memory_tracker.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define HEAP_ARITY 4
+#define HEAP_MIN_CAPACITY 16
+
+// Whether a belongs in front of b
+static int heap_before(const PriorityQueue* queue, const PriorityItem* a, const PriorityItem* b) {
+    return queue->is_max ? a->priority > b->priority : a->priority < b->priority;
+}
+
+// Move the item at i up toward the root (hole technique: one write per level)
+static void sift_up(PriorityQueue* queue, size_t i) {
+    PriorityItem item = queue->items[i];
+    while (i > 0) {
+        size_t parent = (i - 1) / HEAP_ARITY;
+        if (!heap_before(queue, &item, &queue->items[parent])) break;
+        queue->items[i] = queue->items[parent];
+        i = parent;
+    }
+    queue->items[i] = item;
+}
+
+// Move the item at i down below every child that belongs in front of it
+static void sift_down(PriorityQueue* queue, size_t i) {
+    PriorityItem item = queue->items[i];
+    size_t n = queue->size;
+    for (;;) {
+        size_t first = i * HEAP_ARITY + 1;
+        if (first >= n) break;
+        size_t last = first + HEAP_ARITY < n ? first + HEAP_ARITY : n;
+        size_t best = first;
+        for (size_t c = first + 1; c < last; c++) {
+            if (heap_before(queue, &queue->items[c], &queue->items[best])) best = c;
+        }
+        if (!heap_before(queue, &queue->items[best], &item)) break;
+        queue->items[i] = queue->items[best];
+        i = best;
+    }
+    queue->items[i] = item;
+}
+
+static int reserve(PriorityQueue* queue, size_t needed) {
+    if (needed <= queue->capacity) return 1;
+    size_t capacity = queue->capacity ? queue->capacity : HEAP_MIN_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+    PriorityItem* items = (PriorityItem*)tracked_realloc(queue->items, capacity * sizeof(PriorityItem), __FILE__, __LINE__, "priority_queue_items");
+    if (!items) return 0;
+    queue->items = items;
+    queue->capacity = capacity;
+    return 1;
+}
+
+PriorityQueue* priority_queue_create(int is_max, size_t initial_capacity) {
+    PriorityQueue* queue = (PriorityQueue*)tracked_malloc(sizeof(PriorityQueue), __FILE__, __LINE__, "priority_queue");
+    if (!queue) return NULL;
+    queue->items = NULL;
+    queue->size = 0;
+    queue->capacity = 0;
+    queue->is_max = is_max;
+    if (!reserve(queue, initial_capacity > 0 ? initial_capacity : HEAP_MIN_CAPACITY)) {
+        tracked_free(queue, __FILE__, __LINE__, "priority_queue");
+        return NULL;
+    }
+    return queue;
+}
+
+void priority_queue_free(PriorityQueue* queue) {
+    if (!queue) return;
+    for (size_t i = 0; i < queue->size; i++) {
+        if (queue->items[i].is_string) tracked_free(queue->items[i].text, __FILE__, __LINE__, "priority_queue_payload");
+    }
+    tracked_free(queue->items, __FILE__, __LINE__, "priority_queue_items");
+    tracked_free(queue, __FILE__, __LINE__, "priority_queue");
+}
+
+int priority_queue_push(PriorityQueue* queue, const PriorityItem* item) {
+    if (!reserve(queue, queue->size + 1)) return 0;
+    PriorityItem copy = *item;
+    if (item->is_string) {
+        copy.text = tracked_strdup(item->text ? item->text : "", __FILE__, __LINE__, "priority_queue_payload");
+        if (!copy.text) return 0;
+    }
+    queue->items[queue->size] = copy;
+    sift_up(queue, queue->size++);
+    return 1;
+}
+
+const PriorityItem* priority_queue_peek(const PriorityQueue* queue) {
+    return queue->size > 0 ? &queue->items[0] : NULL;
+}
+
+int priority_queue_pop(PriorityQueue* queue, PriorityItem* out) {
+    if (queue->size == 0) return 0;
+    *out = queue->items[0];
+    queue->size--;
+    if (queue->size > 0) {
+        queue->items[0] = queue->items[queue->size];
+        sift_down(queue, 0);
+    }
+    return 1;
+}
+
+PriorityQueue* priority_queue_heapify(int is_max, const long long* priorities, size_t n) {
+    PriorityQueue* queue = priority_queue_create(is_max, n);
+    if (!queue) return NULL;
+    for (size_t i = 0; i < n; i++) {
+        queue->items[i].priority = priorities[i];
+        queue->items[i].is_string = 0;
+        queue->items[i].number = priorities[i];
+        queue->items[i].text = NULL;
+    }
+    queue->size = n;
+    // Sift down every internal node, deepest first
+    if (n > 1) {
+        for (size_t i = (n - 2) / HEAP_ARITY + 1; i-- > 0;) sift_down(queue, i);
+    }
+    return queue;
+}
@@ -0,0 +1,1059 @@
+/**
+ * @file regex_engine.c
+ * @brief Myco Regex Engine - Linear-time Regular Expressions
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the regular expression engine behind the regex
+ * functions of the text_utils library. Patterns are parsed into a small
+ * syntax tree and compiled to a Thompson NFA program. No backtracking is
+ * ever performed, so matching time is linear in the length of the text.
+ *
+ * Regex Engine Features:
+ * - Literals, '.', character classes with ranges and negation
+ * - Escapes \d \w \s \D \W \S \n \t \r and escaped metacharacters
+ * - Anchors ^ and $ (start and end of the whole text)
+ * - Capturing groups (...) and non-capturing groups (?:...)
+ * - Alternation and the quantifiers * + ? {m} {m,} {m,n}, greedy or lazy
+ *
+ * Execution Strategy:
+ * - A lazily built DFA answers "is there a match" and "does the whole
+ *   text match"; states are NFA instruction sets created on first use
+ *   and their byte transitions are cached
+ * - A Pike VM (parallel NFA simulation) finds leftmost-first match
+ *   boundaries and capture groups, only after the DFA reported a match
+ * - A literal prefix is located with the compiled substring searcher so
+ *   both engines skip straight to candidate positions
+ */
+
+#include "regex_engine.h"
+#include "string_kernels.h"
+#include "memory_tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define REGEX_MAX_PROGRAM 20000     // Instruction limit (counted repeats are expanded)
+#define REGEX_MAX_REPEAT 1000       // Largest {m,n} bound accepted
+#define DFA_MAX_STATES 4096         // Lazy DFA cache size before falling back to the NFA
+
+/*******************************************************************************
+ * SYNTAX TREE
+ ******************************************************************************/
+
+typedef enum {
+    NODE_EMPTY,
+    NODE_BYTE,          // value = byte
+    NODE_ANY,           // any byte except newline
+    NODE_CLASS,         // value = class index
+    NODE_BOL,
+    NODE_EOL,
+    NODE_CAT,           // left, right
+    NODE_ALT,           // left, right
+    NODE_REPEAT,        // left, min, max (-1 = unbounded), greedy
+    NODE_GROUP          // left, value = capture index (-1 = non-capturing)
+} RegexNodeType;
+
+typedef struct {
+    RegexNodeType type;
+    int value;
+    int left;
+    int right;
+    int min;
+    int max;
+    int greedy;
+} RegexNode;
+
+typedef enum {
+    OP_BYTE,            // x = byte
+    OP_CLASS,           // x = class index
+    OP_ANY,
+    OP_SPLIT,           // prefer x, then y
+    OP_JMP,             // x = target
+    OP_SAVE,            // x = capture slot
+    OP_BOL,
+    OP_EOL,
+    OP_MATCH
+} RegexOp;
+
+typedef struct {
+    RegexOp op;
+    int x;
+    int y;
+} RegexInst;
+
+/*******************************************************************************
+ * LAZY DFA
+ ******************************************************************************/
+
+typedef struct {
+    int* pcs;           // Sorted NFA pcs (consuming instructions, EOL and MATCH)
+    int pc_count;
+    int is_match;       // MATCH is in the set
+    int match_at_end;   // MATCH is reachable through EOL at the end of the text
+    int next[256];      // Cached transitions (-1 = not built yet)
+} DfaState;
+
+typedef struct {
+    int anchored;       // 0: a new thread starts at every position (search)
+    DfaState* states;
+    int state_count;
+    int state_capacity;
+    int* buckets;       // Hash of pc sets -> state index (-1 = empty)
+    int bucket_count;
+    int start_state[2]; // Start state when at the beginning of the text [0] or not [1]
+    int failed;         // Cache limit hit; callers use the NFA instead
+} Dfa;
+
+struct Regex {
+    RegexInst* program;
+    int program_len;
+    unsigned char (*classes)[32];
+    int class_count;
+    int group_count;
+    char* prefix;               // Literal bytes every match starts with
+    size_t prefix_len;
+    StringSearcher* prefix_searcher;
+    Dfa search_dfa;
+    Dfa full_dfa;
+    // Scratch space shared by closure computations and the Pike VM
+    int* marks;
+    int mark_generation;
+    int* stack;
+    int* set;
+};
+
+/*******************************************************************************
+ * PARSER
+ ******************************************************************************/
+
+typedef struct {
+    const char* pattern;
+    size_t len;
+    size_t pos;
+    RegexNode* nodes;
+    int node_count;
+    int node_capacity;
+    unsigned char (*classes)[32];
+    int class_count;
+    int class_capacity;
+    int group_count;
+    char* error;
+    size_t error_size;
+    int failed;
+} RegexParser;
+
+static void parser_fail(RegexParser* p, const char* message) {
+    if (p->failed) return;
+    p->failed = 1;
+    if (p->error && p->error_size > 0) {
+        snprintf(p->error, p->error_size, "%s at offset %zu", message, p->pos);
+    }
+}
+
+static int new_node(RegexParser* p, RegexNodeType type, int value, int left, int right) {
+    if (p->node_count >= p->node_capacity) {
+        int new_capacity = p->node_capacity ? p->node_capacity * 2 : 32;
+        RegexNode* grown = (RegexNode*)tracked_realloc(p->nodes, new_capacity * sizeof(RegexNode), __FILE__, __LINE__, "regex_nodes");
+        if (!grown) {
+            parser_fail(p, "out of memory");
+            return -1;
+        }
+        p->nodes = grown;
+        p->node_capacity = new_capacity;
+    }
+    RegexNode* node = &p->nodes[p->node_count];
+    node->type = type;
+    node->value = value;
+    node->left = left;
+    node->right = right;
+    node->min = 0;
+    node->max = 0;
+    node->greedy = 1;
+    return p->node_count++;
+}
+
+static int new_class(RegexParser* p) {
+    if (p->class_count >= p->class_capacity) {
+        int new_capacity = p->class_capacity ? p->class_capacity * 2 : 8;
+        unsigned char (*grown)[32] = tracked_realloc(p->classes, new_capacity * 32, __FILE__, __LINE__, "regex_classes");
+        if (!grown) {
+            parser_fail(p, "out of memory");
+            return -1;
+        }
+        p->classes = grown;
+        p->class_capacity = new_capacity;
+    }
+    memset(p->classes[p->class_count], 0, 32);
+    return p->class_count++;
+}
+
+static void class_add(unsigned char* bits, int c) {
+    bits[c >> 3] |= (unsigned char)(1 << (c & 7));
+}
+
+static void class_add_range(unsigned char* bits, int from, int to) {
+    for (int c = from; c <= to; c++) class_add(bits, c);
+}
+
+// Add a \d \w \s style shorthand (or its negation) to a class bitmap
+static int class_add_shorthand(unsigned char* bits, char kind) {
+    unsigned char set[32];
+    memset(set, 0, sizeof(set));
+    switch (kind) {
+        case 'd': case 'D':
+            class_add_range(set, '0', '9');
+            break;
+        case 'w': case 'W':
+            class_add_range(set, '0', '9');
+            class_add_range(set, 'a', 'z');
+            class_add_range(set, 'A', 'Z');
+            class_add(set, '_');
+            break;
+        case 's': case 'S':
+            class_add(set, ' ');
+            class_add_range(set, '\t', '\r');
+            break;
+        default:
+            return 0;
+    }
+    int negate = (kind == 'D' || kind == 'W' || kind == 'S');
+    for (int i = 0; i < 32; i++) bits[i] |= negate ? (unsigned char)~set[i] : set[i];
+    return 1;
+}
+
+// Translate a single-character escape (\n, \t, \.) to its byte
+static int escape_byte(char c) {
+    switch (c) {
+        case 'n': return '\n';
+        case 't': return '\t';
+        case 'r': return '\r';
+        case 'f': return '\f';
+        case 'v': return '\v';
+        case '0': return '\0';
+        default: return (unsigned char)c;
+    }
+}
+
+static int parse_alternation(RegexParser* p);
+
+static int parse_class(RegexParser* p) {
+    int index = new_class(p);
+    if (index < 0) return -1;
+    unsigned char bits[32];
+    memset(bits, 0, sizeof(bits));
+
+    int negate = 0;
+    if (p->pos < p->len && p->pattern[p->pos] == '^') {
+        negate = 1;
+        p->pos++;
+    }
+
+    int first = 1;
+    while (p->pos < p->len && (p->pattern[p->pos] != ']' || first)) {
+        first = 0;
+        int c = (unsigned char)p->pattern[p->pos++];
+        if (c == '\\' && p->pos < p->len) {
+            char e = p->pattern[p->pos++];
+            if (class_add_shorthand(bits, e)) continue;
+            c = escape_byte(e);
+        }
+        // Range a-z (a trailing '-' is literal)
+        if (p->pos + 1 < p->len && p->pattern[p->pos] == '-' && p->pattern[p->pos + 1] != ']') {
+            p->pos++;
+            int hi = (unsigned char)p->pattern[p->pos++];
+            if (hi == '\\' && p->pos < p->len) hi = escape_byte(p->pattern[p->pos++]);
+            if (hi < c) {
+                parser_fail(p, "invalid character class range");
+                return -1;
+            }
+            class_add_range(bits, c, hi);
+        } else {
+            class_add(bits, c);
+        }
+    }
+    if (p->pos >= p->len) {
+        parser_fail(p, "missing ]");
+        return -1;
+    }
+    p->pos++;
+
+    for (int i = 0; i < 32; i++) p->classes[index][i] = negate ? (unsigned char)~bits[i] : bits[i];
+    return new_node(p, NODE_CLASS, index, -1, -1);
+}
+
+static int parse_atom(RegexParser* p) {
+    char c = p->pattern[p->pos++];
+    switch (c) {
+        case '(': {
+            int capture = -1;
+            if (p->pos + 1 < p->len && p->pattern[p->pos] == '?' && p->pattern[p->pos + 1] == ':') {
+                p->pos += 2;
+            } else {
+                if (p->group_count + 1 >= REGEX_MAX_GROUPS) {
+                    parser_fail(p, "too many capture groups");
+                    return -1;
+                }
+                capture = ++p->group_count;
+            }
+            int inner = parse_alternation(p);
+            if (p->failed) return -1;
+            if (p->pos >= p->len || p->pattern[p->pos] != ')') {
+                parser_fail(p, "missing )");
+                return -1;
+            }
+            p->pos++;
+            return new_node(p, NODE_GROUP, capture, inner, -1);
+        }
+        case '[':
+            return parse_class(p);
+        case '.':
+            return new_node(p, NODE_ANY, 0, -1, -1);
+        case '^':
+            return new_node(p, NODE_BOL, 0, -1, -1);
+        case '$':
+            return new_node(p, NODE_EOL, 0, -1, -1);
+        case '\\': {
+            if (p->pos >= p->len) {
+                parser_fail(p, "trailing backslash");
+                return -1;
+            }
+            char e = p->pattern[p->pos++];
+            int index = -1;
+            if (strchr("dDwWsS", e)) {
+                index = new_class(p);
+                if (index < 0) return -1;
+                class_add_shorthand(p->classes[index], e);
+                return new_node(p, NODE_CLASS, index, -1, -1);
+            }
+            return new_node(p, NODE_BYTE, escape_byte(e), -1, -1);
+        }
+        case '*': case '+': case '?':
+            p->pos--;
+            parser_fail(p, "quantifier without operand");
+            return -1;
+        default:
+            return new_node(p, NODE_BYTE, (unsigned char)c, -1, -1);
+    }
+}
+
+// Parse "{m}", "{m,}" or "{m,n}"; returns 0 (and consumes nothing) if the brace is literal
+static int parse_braces(RegexParser* p, int* min, int* max) {
+    size_t pos = p->pos + 1;
+    int lo = 0, hi = -1, digits = 0;
+    while (pos < p->len && p->pattern[pos] >= '0' && p->pattern[pos] <= '9') {
+        lo = lo * 10 + (p->pattern[pos++] - '0');
+        if (lo > REGEX_MAX_REPEAT) lo = REGEX_MAX_REPEAT + 1;
+        digits++;
+    }
+    if (!digits) return 0;
+    if (pos < p->len && p->pattern[pos] == ',') {
+        pos++;
+        if (pos < p->len && p->pattern[pos] >= '0' && p->pattern[pos] <= '9') {
+            hi = 0;
+            while (pos < p->len && p->pattern[pos] >= '0' && p->pattern[pos] <= '9') {
+                hi = hi * 10 + (p->pattern[pos++] - '0');
+                if (hi > REGEX_MAX_REPEAT) hi = REGEX_MAX_REPEAT + 1;
+            }
+        }
+    } else {
+        hi = lo;
+    }
+    if (pos >= p->len || p->pattern[pos] != '}') return 0;
+    p->pos = pos + 1;
+    if (lo > REGEX_MAX_REPEAT || hi > REGEX_MAX_REPEAT || (hi >= 0 && hi < lo)) {
+        parser_fail(p, "invalid repeat count");
+        return -1;
+    }
+    *min = lo;
+    *max = hi;
+    return 1;
+}
+
+static int parse_repeat(RegexParser* p) {
+    int atom = parse_atom(p);
+    while (!p->failed && p->pos < p->len) {
+        char c = p->pattern[p->pos];
+        int min, max;
+        if (c == '*') { min = 0; max = -1; p->pos++; }
+        else if (c == '+') { min = 1; max = -1; p->pos++; }
+        else if (c == '?') { min = 0; max = 1; p->pos++; }
+        else if (c == '{') {
+            int braces = parse_braces(p, &min, &max);
+            if (braces < 0) return -1;
+            if (braces == 0) break;
+        } else {
+            break;
+        }
+        int greedy = 1;
+        if (p->pos < p->len && p->pattern[p->pos] == '?') {
+            greedy = 0;
+            p->pos++;
+        }
+        int node = new_node(p, NODE_REPEAT, 0, atom, -1);
+        if (node < 0) return -1;
+        p->nodes[node].min = min;
+        p->nodes[node].max = max;
+        p->nodes[node].greedy = greedy;
+        atom = node;
+    }
+    return atom;
+}
+
+static int parse_concatenation(RegexParser* p) {
+    int result = -1;
+    while (!p->failed && p->pos < p->len && p->pattern[p->pos] != '|' && p->pattern[p->pos] != ')') {
+        int next = parse_repeat(p);
+        if (p->failed) return -1;
+        result = result < 0 ? next : new_node(p, NODE_CAT, 0, result, next);
+    }
+    return result < 0 ? new_node(p, NODE_EMPTY, 0, -1, -1) : result;
+}
+
+static int parse_alternation(RegexParser* p) {
+    int left = parse_concatenation(p);
+    while (!p->failed && p->pos < p->len && p->pattern[p->pos] == '|') {
+        p->pos++;
+        int right = parse_concatenation(p);
+        left = new_node(p, NODE_ALT, 0, left, right);
+    }
+    return left;
+}
+
+/*******************************************************************************
+ * COMPILER
+ ******************************************************************************/
+
+typedef struct {
+    RegexInst* program;
+    int len;
+    int capacity;
+    RegexNode* nodes;
+    int failed;
+} RegexCompiler;
+
+static int emit(RegexCompiler* c, RegexOp op, int x, int y) {
+    if (c->failed) return -1;
+    if (c->len >= REGEX_MAX_PROGRAM) {
+        c->failed = 1;
+        return -1;
+    }
+    if (c->len >= c->capacity) {
+        int new_capacity = c->capacity ? c->capacity * 2 : 64;
+        RegexInst* grown = (RegexInst*)tracked_realloc(c->program, new_capacity * sizeof(RegexInst), __FILE__, __LINE__, "regex_program");
+        if (!grown) {
+            c->failed = 1;
+            return -1;
+        }
+        c->program = grown;
+        c->capacity = new_capacity;
+    }
+    c->program[c->len].op = op;
+    c->program[c->len].x = x;
+    c->program[c->len].y = y;
+    return c->len++;
+}
+
+static void compile_node(RegexCompiler* c, int index) {
+    if (c->failed) return;
+    RegexNode* node = &c->nodes[index];
+    switch (node->type) {
+        case NODE_EMPTY:
+            break;
+        case NODE_BYTE:
+            emit(c, OP_BYTE, node->value, 0);
+            break;
+        case NODE_ANY:
+            emit(c, OP_ANY, 0, 0);
+            break;
+        case NODE_CLASS:
+            emit(c, OP_CLASS, node->value, 0);
+            break;
+        case NODE_BOL:
+            emit(c, OP_BOL, 0, 0);
+            break;
+        case NODE_EOL:
+            emit(c, OP_EOL, 0, 0);
+            break;
+        case NODE_CAT:
+            compile_node(c, node->left);
+            compile_node(c, node->right);
+            break;
+        case NODE_ALT: {
+            int split = emit(c, OP_SPLIT, 0, 0);
+            compile_node(c, node->left);
+            int jump = emit(c, OP_JMP, 0, 0);
+            if (c->failed) return;
+            c->program[split].x = split + 1;
+            c->program[split].y = c->len;
+            compile_node(c, node->right);
+            if (c->failed) return;
+            c->program[jump].x = c->len;
+            break;
+        }
+        case NODE_GROUP:
+            if (node->value >= 0) emit(c, OP_SAVE, node->value * 2, 0);
+            compile_node(c, node->left);
+            if (node->value >= 0) emit(c, OP_SAVE, node->value * 2 + 1, 0);
+            break;
+        case NODE_REPEAT: {
+            int min = node->min, max = node->max, greedy = node->greedy, child = node->left;
+            // Mandatory copies
+            for (int i = 0; i < min; i++) compile_node(c, child);
+            if (max < 0) {
+                // Kleene star over the child: L: split body, out; body; jmp L
+                int split = emit(c, OP_SPLIT, 0, 0);
+                compile_node(c, child);
+                emit(c, OP_JMP, split, 0);
+                if (c->failed) return;
+                c->program[split].x = greedy ? split + 1 : c->len;
+                c->program[split].y = greedy ? c->len : split + 1;
+                break;
+            }
+            // Optional copies, each guarded by a split that can skip to the end
+            int optional = max - min;
+            int* splits = optional > 0 ? (int*)tracked_malloc(optional * sizeof(int), __FILE__, __LINE__, "regex_repeat_splits") : NULL;
+            if (optional > 0 && !splits) {
+                c->failed = 1;
+                return;
+            }
+            for (int i = 0; i < optional; i++) {
+                splits[i] = emit(c, OP_SPLIT, 0, 0);
+                compile_node(c, child);
+            }
+            if (!c->failed) {
+                for (int i = 0; i < optional; i++) {
+                    c->program[splits[i]].x = greedy ? splits[i] + 1 : c->len;
+                    c->program[splits[i]].y = greedy ? c->len : splits[i] + 1;
+                }
+            }
+            if (splits) tracked_free(splits, __FILE__, __LINE__, "regex_repeat_splits");
+            break;
+        }
+    }
+}
+
+/*******************************************************************************
+ * CLOSURE (shared by the DFA and the Pike VM)
+ ******************************************************************************/
+
+static int class_has(const unsigned char* bits, unsigned char c) {
+    return (bits[c >> 3] >> (c & 7)) & 1;
+}
+
+static int inst_consumes(const Regex* re, const RegexInst* inst, unsigned char c) {
+    switch (inst->op) {
+        case OP_BYTE: return c == (unsigned char)inst->x;
+        case OP_ANY: return c != '\n';
+        case OP_CLASS: return class_has(re->classes[inst->x], c);
+        default: return 0;
+    }
+}
+
+static void next_generation(Regex* re) {
+    re->mark_generation++;
+    if (re->mark_generation == 0x7fffffff) {
+        memset(re->marks, 0, re->program_len * sizeof(int));
+        re->mark_generation = 1;
+    }
+}
+
+/**
+ * @brief Epsilon closure of pc into a pc set (for the DFA)
+ * @param at_start Whether ^ holds at this position
+ * @param follow_eol Whether $ holds at this position
+ *
+ * Only consuming instructions, EOL (when not followed) and MATCH are
+ * recorded; the caller must have started a new mark generation.
+ */
+static void closure_into(Regex* re, int start_pc, int at_start, int follow_eol, int* set, int* set_count) {
+    int top = 0;
+    re->stack[top++] = start_pc;
+    while (top > 0) {
+        int pc = re->stack[--top];
+        if (re->marks[pc] == re->mark_generation) continue;
+        re->marks[pc] = re->mark_generation;
+        RegexInst* inst = &re->program[pc];
+        switch (inst->op) {
+            case OP_JMP:
+                re->stack[top++] = inst->x;
+                break;
+            case OP_SPLIT:
+                re->stack[top++] = inst->y;
+                re->stack[top++] = inst->x;
+                break;
+            case OP_SAVE:
+                re->stack[top++] = pc + 1;
+                break;
+            case OP_BOL:
+                if (at_start) re->stack[top++] = pc + 1;
+                break;
+            case OP_EOL:
+                if (follow_eol) re->stack[top++] = pc + 1;
+                else set[(*set_count)++] = pc;
+                break;
+            default:
+                set[(*set_count)++] = pc;
+                break;
+        }
+    }
+}
+
+/*******************************************************************************
+ * LAZY DFA
+ ******************************************************************************/
+
+static int compare_ints(const void* a, const void* b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static unsigned int hash_pcs(const int* pcs, int count) {
+    unsigned int h = 2166136261u;
+    for (int i = 0; i < count; i++) {
+        h ^= (unsigned int)pcs[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void dfa_init(Dfa* dfa, int anchored) {
+    memset(dfa, 0, sizeof(*dfa));
+    dfa->anchored = anchored;
+    dfa->start_state[0] = -1;
+    dfa->start_state[1] = -1;
+}
+
+static void dfa_free(Dfa* dfa) {
+    for (int i = 0; i < dfa->state_count; i++) {
+        tracked_free(dfa->states[i].pcs, __FILE__, __LINE__, "regex_dfa_pcs");
+    }
+    if (dfa->states) tracked_free(dfa->states, __FILE__, __LINE__, "regex_dfa_states");
+    if (dfa->buckets) tracked_free(dfa->buckets, __FILE__, __LINE__, "regex_dfa_buckets");
+    dfa_init(dfa, dfa->anchored);
+}
+
+static int dfa_rehash(Dfa* dfa, int bucket_count) {
+    int* buckets = (int*)tracked_malloc(bucket_count * sizeof(int), __FILE__, __LINE__, "regex_dfa_buckets");
+    if (!buckets) return 0;
+    for (int i = 0; i < bucket_count; i++) buckets[i] = -1;
+    for (int i = 0; i < dfa->state_count; i++) {
+        unsigned int slot = hash_pcs(dfa->states[i].pcs, dfa->states[i].pc_count) & (unsigned int)(bucket_count - 1);
+        while (buckets[slot] >= 0) slot = (slot + 1) & (unsigned int)(bucket_count - 1);
+        buckets[slot] = i;
+    }
+    if (dfa->buckets) tracked_free(dfa->buckets, __FILE__, __LINE__, "regex_dfa_buckets");
+    dfa->buckets = buckets;
+    dfa->bucket_count = bucket_count;
+    return 1;
+}
+
+/**
+ * @brief Finds or creates the DFA state for a pc set
+ * @return State index, or -1 if the cache is full
+ */
+static int dfa_intern(Regex* re, Dfa* dfa, int* pcs, int count) {
+    qsort(pcs, count, sizeof(int), compare_ints);
+    unsigned int h = hash_pcs(pcs, count);
+
+    if (dfa->bucket_count) {
+        unsigned int slot = h & (unsigned int)(dfa->bucket_count - 1);
+        while (dfa->buckets[slot] >= 0) {
+            DfaState* state = &dfa->states[dfa->buckets[slot]];
+            if (state->pc_count == count && memcmp(state->pcs, pcs, count * sizeof(int)) == 0) {
+                return dfa->buckets[slot];
+            }
+            slot = (slot + 1) & (unsigned int)(dfa->bucket_count - 1);
+        }
+    }
+
+    if (dfa->state_count >= DFA_MAX_STATES) {
+        dfa->failed = 1;
+        return -1;
+    }
+    if (dfa->state_count >= dfa->state_capacity) {
+        int new_capacity = dfa->state_capacity ? dfa->state_capacity * 2 : 16;
+        DfaState* grown = (DfaState*)tracked_realloc(dfa->states, new_capacity * sizeof(DfaState), __FILE__, __LINE__, "regex_dfa_states");
+        if (!grown) {
+            dfa->failed = 1;
+            return -1;
+        }
+        dfa->states = grown;
+        dfa->state_capacity = new_capacity;
+    }
+
+    DfaState* state = &dfa->states[dfa->state_count];
+    state->pcs = (int*)tracked_malloc((count ? count : 1) * sizeof(int), __FILE__, __LINE__, "regex_dfa_pcs");
+    if (!state->pcs) {
+        dfa->failed = 1;
+        return -1;
+    }
+    memcpy(state->pcs, pcs, count * sizeof(int));
+    state->pc_count = count;
+    state->is_match = 0;
+    state->match_at_end = 0;
+    for (int i = 0; i < 256; i++) state->next[i] = -1;
+
+    // Classify: direct MATCH, or MATCH reachable once $ is satisfied.
+    // pcs may alias re->set, so only the state's own copy is read from here on.
+    for (int i = 0; i < count; i++) {
+        if (re->program[state->pcs[i]].op == OP_MATCH) state->is_match = 1;
+    }
+    state->match_at_end = state->is_match;
+    if (!state->match_at_end) {
+        next_generation(re);
+        int end_count = 0;
+        for (int i = 0; i < count; i++) {
+            if (re->program[state->pcs[i]].op == OP_EOL) closure_into(re, state->pcs[i] + 1, 0, 1, re->set, &end_count);
+        }
+        for (int i = 0; i < end_count; i++) {
+            if (re->program[re->set[i]].op == OP_MATCH) state->match_at_end = 1;
+        }
+    }
+
+    int index = dfa->state_count++;
+    if (dfa->state_count * 2 > dfa->bucket_count) {
+        if (!dfa_rehash(dfa, dfa->bucket_count ? dfa->bucket_count * 2 : 64)) {
+            dfa->failed = 1;
+            return -1;
+        }
+    } else {
+        unsigned int slot = h & (unsigned int)(dfa->bucket_count - 1);
+        while (dfa->buckets[slot] >= 0) slot = (slot + 1) & (unsigned int)(dfa->bucket_count - 1);
+        dfa->buckets[slot] = index;
+    }
+    return index;
+}
+
+static int dfa_start(Regex* re, Dfa* dfa, int at_start) {
+    int which = at_start ? 0 : 1;
+    if (dfa->start_state[which] >= 0) return dfa->start_state[which];
+    int* set = re->set;
+    int count = 0;
+    next_generation(re);
+    closure_into(re, 0, at_start, 0, set, &count);
+    int state = dfa_intern(re, dfa, set, count);
+    dfa->start_state[which] = state;
+    return state;
+}
+
+static int dfa_step(Regex* re, Dfa* dfa, int state_index, unsigned char c) {
+    int cached = dfa->states[state_index].next[c];
+    if (cached >= 0) return cached;
+
+    int* set = re->set;
+    int count = 0;
+    next_generation(re);
+    DfaState* state = &dfa->states[state_index];
+    for (int i = 0; i < state->pc_count; i++) {
+        int pc = state->pcs[i];
+        if (inst_consumes(re, &re->program[pc], c)) closure_into(re, pc + 1, 0, 0, set, &count);
+    }
+    // Searching: a new match attempt may begin after every byte
+    if (!dfa->anchored) closure_into(re, 0, 0, 0, set, &count);
+
+    int next = dfa_intern(re, dfa, set, count);
+    if (next >= 0) dfa->states[state_index].next[c] = next;
+    return next;
+}
+
+/**
+ * @brief Runs the DFA over text[start..len)
+ * @return 1 match, 0 no match, -1 the DFA gave up (state limit)
+ *
+ * Unanchored: stops at the first position where any match ends.
+ * Anchored: accepts only if a match ends exactly at the end of the text.
+ */
+static int dfa_run(Regex* re, Dfa* dfa, const char* text, size_t len, size_t start) {
+    if (dfa->failed) return -1;
+    int state = dfa_start(re, dfa, start == 0);
+    if (state < 0) return -1;
+    for (size_t pos = start; pos < len; pos++) {
+        if (!dfa->anchored && dfa->states[state].is_match) return 1;
+        state = dfa_step(re, dfa, state, (unsigned char)text[pos]);
+        if (state < 0) return -1;
+        if (dfa->anchored && dfa->states[state].pc_count == 0) return 0;
+    }
+    return dfa->states[state].is_match || dfa->states[state].match_at_end;
+}
+
+/*******************************************************************************
+ * PIKE VM
+ ******************************************************************************/
+
+typedef struct {
+    int* pcs;
+    long* caps;         // count * slot_count capture offsets
+    int count;
+} ThreadList;
+
+/**
+ * Adds the thread at pc (and everything reachable through epsilon moves)
+ * to the list in priority order. caps holds this thread's capture offsets
+ * and is restored before returning.
+ */
+static void add_thread(Regex* re, ThreadList* list, int pc, long* caps, int slot_count, size_t pos, size_t len) {
+    if (re->marks[pc] == re->mark_generation) return;
+    re->marks[pc] = re->mark_generation;
+    RegexInst* inst = &re->program[pc];
+    switch (inst->op) {
+        case OP_JMP:
+            add_thread(re, list, inst->x, caps, slot_count, pos, len);
+            break;
+        case OP_SPLIT:
+            add_thread(re, list, inst->x, caps, slot_count, pos, len);
+            add_thread(re, list, inst->y, caps, slot_count, pos, len);
+            break;
+        case OP_SAVE: {
+            long saved = caps[inst->x];
+            caps[inst->x] = (long)pos;
+            add_thread(re, list, pc + 1, caps, slot_count, pos, len);
+            caps[inst->x] = saved;
+            break;
+        }
+        case OP_BOL:
+            if (pos == 0) add_thread(re, list, pc + 1, caps, slot_count, pos, len);
+            break;
+        case OP_EOL:
+            if (pos == len) add_thread(re, list, pc + 1, caps, slot_count, pos, len);
+            break;
+        default:
+            list->pcs[list->count] = pc;
+            memcpy(list->caps + (size_t)list->count * slot_count, caps, slot_count * sizeof(long));
+            list->count++;
+            break;
+    }
+}
+
+/**
+ * @brief Leftmost-first search with captures, starting at start
+ * @return 1 and fills groups on a match, 0 otherwise
+ */
+static int pike_search(Regex* re, const char* text, size_t len, size_t start, int anchored, long* groups) {
+    int slot_count = (re->group_count + 1) * 2;
+    size_t list_bytes = (size_t)re->program_len * slot_count * sizeof(long);
+    ThreadList lists[2];
+    lists[0].pcs = (int*)tracked_malloc(re->program_len * sizeof(int), __FILE__, __LINE__, "regex_threads");
+    lists[1].pcs = (int*)tracked_malloc(re->program_len * sizeof(int), __FILE__, __LINE__, "regex_threads");
+    lists[0].caps = (long*)tracked_malloc(list_bytes, __FILE__, __LINE__, "regex_thread_caps");
+    lists[1].caps = (long*)tracked_malloc(list_bytes, __FILE__, __LINE__, "regex_thread_caps");
+    long* caps = (long*)tracked_malloc(slot_count * sizeof(long), __FILE__, __LINE__, "regex_caps");
+    int matched = 0;
+
+    if (lists[0].pcs && lists[1].pcs && lists[0].caps && lists[1].caps && caps) {
+        ThreadList* current = &lists[0];
+        ThreadList* next = &lists[1];
+        current->count = 0;
+        next_generation(re);
+
+        for (size_t pos = start; ; pos++) {
+            if (!matched && (!anchored || pos == start)) {
+                // Nothing alive: jump ahead to the next place the literal prefix occurs
+                if (current->count == 0 && re->prefix_searcher && !anchored && pos < len) {
+                    const char* hit = string_searcher_find(re->prefix_searcher, text + pos, len - pos);
+                    if (!hit) break;
+                    if ((size_t)(hit - text) != pos) {
+                        pos = (size_t)(hit - text);
+                        next_generation(re);
+                    }
+                }
+                for (int i = 0; i < slot_count; i++) caps[i] = -1;
+                add_thread(re, current, 0, caps, slot_count, pos, len);
+            }
+            if (current->count == 0) {
+                // An unanchored search keeps starting threads up to the end of the text
+                if (anchored || matched || pos >= len) break;
+                next_generation(re);
+                continue;
+            }
+
+            next->count = 0;
+            next_generation(re);
+            for (int i = 0; i < current->count; i++) {
+                int pc = current->pcs[i];
+                long* thread_caps = current->caps + (size_t)i * slot_count;
+                RegexInst* inst = &re->program[pc];
+                if (inst->op == OP_MATCH) {
+                    // Leftmost-first: lower-priority threads are cut off
+                    memcpy(groups, thread_caps, slot_count * sizeof(long));
+                    matched = 1;
+                    break;
+                }
+                if (pos < len && inst_consumes(re, inst, (unsigned char)text[pos])) {
+                    add_thread(re, next, pc + 1, thread_caps, slot_count, pos + 1, len);
+                }
+            }
+            ThreadList* swap = current;
+            current = next;
+            next = swap;
+            if (pos >= len) {
+                // Threads waiting on MATCH after the last byte
+                for (int i = 0; !matched && i < current->count; i++) {
+                    if (re->program[current->pcs[i]].op == OP_MATCH) {
+                        memcpy(groups, current->caps + (size_t)i * slot_count, slot_count * sizeof(long));
+                        matched = 1;
+                    }
+                }
+                break;
+            }
+        }
+    }
+
+    if (lists[0].pcs) tracked_free(lists[0].pcs, __FILE__, __LINE__, "regex_threads");
+    if (lists[1].pcs) tracked_free(lists[1].pcs, __FILE__, __LINE__, "regex_threads");
+    if (lists[0].caps) tracked_free(lists[0].caps, __FILE__, __LINE__, "regex_thread_caps");
+    if (lists[1].caps) tracked_free(lists[1].caps, __FILE__, __LINE__, "regex_thread_caps");
+    if (caps) tracked_free(caps, __FILE__, __LINE__, "regex_caps");
+    return matched;
+}
+
+/*******************************************************************************
+ * PUBLIC API
+ ******************************************************************************/
+
+/**
+ * @brief Compiles a pattern
+ * @param pattern Pattern bytes
+ * @param pattern_len Pattern length
+ * @param error Receives a message on failure (may be NULL)
+ * @param error_size Size of the error buffer
+ * @return Compiled regex (free with regex_free), or NULL on a syntax error
+ */
+Regex* regex_compile(const char* pattern, size_t pattern_len, char* error, size_t error_size) {
+    RegexParser parser;
+    memset(&parser, 0, sizeof(parser));
+    parser.pattern = pattern;
+    parser.len = pattern_len;
+    parser.error = error;
+    parser.error_size = error_size;
+
+    int root = parse_alternation(&parser);
+    if (!parser.failed && parser.pos < parser.len) parser_fail(&parser, "unmatched )");
+
+    RegexCompiler compiler;
+    memset(&compiler, 0, sizeof(compiler));
+    compiler.nodes = parser.nodes;
+    if (!parser.failed) {
+        // Whole match is group 0: SAVE 0, pattern, SAVE 1, MATCH
+        emit(&compiler, OP_SAVE, 0, 0);
+        compile_node(&compiler, root);
+        emit(&compiler, OP_SAVE, 1, 0);
+        emit(&compiler, OP_MATCH, 0, 0);
+        if (compiler.failed) parser_fail(&parser, "pattern too large");
+    }
+    if (parser.nodes) tracked_free(parser.nodes, __FILE__, __LINE__, "regex_nodes");
+
+    Regex* re = NULL;
+    if (!parser.failed) {
+        re = (Regex*)tracked_malloc(sizeof(Regex), __FILE__, __LINE__, "regex");
+    }
+    if (!re) {
+        if (compiler.program) tracked_free(compiler.program, __FILE__, __LINE__, "regex_program");
+        if (parser.classes) tracked_free(parser.classes, __FILE__, __LINE__, "regex_classes");
+        if (!parser.failed) parser_fail(&parser, "out of memory");
+        return NULL;
+    }
+
+    memset(re, 0, sizeof(*re));
+    re->program = compiler.program;
+    re->program_len = compiler.len;
+    re->classes = parser.classes;
+    re->class_count = parser.class_count;
+    re->group_count = parser.group_count;
+    re->marks = (int*)tracked_malloc(re->program_len * sizeof(int), __FILE__, __LINE__, "regex_marks");
+    // Every unvisited pc pushes at most two successors during a closure
+    re->stack = (int*)tracked_malloc((re->program_len * 2 + 2) * sizeof(int), __FILE__, __LINE__, "regex_stack");
+    re->set = (int*)tracked_malloc(re->program_len * sizeof(int), __FILE__, __LINE__, "regex_set");
+    if (!re->marks || !re->stack || !re->set) {
+        regex_free(re);
+        if (error && error_size) snprintf(error, error_size, "out of memory");
+        return NULL;
+    }
+    memset(re->marks, 0, re->program_len * sizeof(int));
+    re->mark_generation = 0;
+    dfa_init(&re->search_dfa, 0);
+    dfa_init(&re->full_dfa, 1);
+
+    // Literal prefix: the run of BYTE instructions right after SAVE 0
+    int pc = 1;
+    while (pc < re->program_len && re->program[pc].op == OP_BYTE) pc++;
+    if (pc > 1) {
+        re->prefix_len = (size_t)(pc - 1);
+        re->prefix = (char*)tracked_malloc(re->prefix_len, __FILE__, __LINE__, "regex_prefix");
+        if (re->prefix) {
+            for (int i = 1; i < pc; i++) re->prefix[i - 1] = (char)re->program[i].x;
+            re->prefix_searcher = string_searcher_create(re->prefix, re->prefix_len);
+        } else {
+            re->prefix_len = 0;
+        }
+    }
+    return re;
+}
+
+void regex_free(Regex* re) {
+    if (!re) return;
+    dfa_free(&re->search_dfa);
+    dfa_free(&re->full_dfa);
+    if (re->prefix_searcher) string_searcher_destroy(re->prefix_searcher);
+    if (re->prefix) tracked_free(re->prefix, __FILE__, __LINE__, "regex_prefix");
+    if (re->program) tracked_free(re->program, __FILE__, __LINE__, "regex_program");
+    if (re->classes) tracked_free(re->classes, __FILE__, __LINE__, "regex_classes");
+    if (re->marks) tracked_free(re->marks, __FILE__, __LINE__, "regex_marks");
+    if (re->stack) tracked_free(re->stack, __FILE__, __LINE__, "regex_stack");
+    if (re->set) tracked_free(re->set, __FILE__, __LINE__, "regex_set");
+    tracked_free(re, __FILE__, __LINE__, "regex");
+}
+
+int regex_group_count(const Regex* re) {
+    return re ? re->group_count : 0;
+}
+
+// Does any match start at or after start?
+static int regex_exists_from(Regex* re, const char* text, size_t len, size_t start) {
+    if (re->prefix_searcher) {
+        // Every match begins with the prefix, so the DFA can start at its first occurrence
+        const char* hit = string_searcher_find(re->prefix_searcher, text + start, len - start);
+        if (!hit) return 0;
+        start = (size_t)(hit - text);
+    }
+    int result = dfa_run(re, &re->search_dfa, text, len, start);
+    if (result >= 0) return result;
+
+    long groups[REGEX_MAX_GROUPS * 2];
+    return pike_search(re, text, len, start, 0, groups);
+}
+
+/**
+ * @brief Tests whether the pattern matches anywhere in the text
+ */
+int regex_is_match(Regex* re, const char* text, size_t len) {
+    if (!re || !text) return 0;
+    return regex_exists_from(re, text, len, 0);
+}
+
+/**
+ * @brief Tests whether the pattern matches the entire text
+ */
+int regex_full_match(Regex* re, const char* text, size_t len) {
+    if (!re || !text) return 0;
+    int result = dfa_run(re, &re->full_dfa, text, len, 0);
+    if (result >= 0) return result;
+
+    // DFA gave up: find the leftmost-first anchored match, then require it to span the text
+    long groups[REGEX_MAX_GROUPS * 2];
+    return pike_search(re, text, len, 0, 1, groups) && groups[1] == (long)len;
+}
+
+/**
+ * @brief Finds the leftmost match starting at or after start
+ * @param groups Receives 2 * (group_count + 1) offsets; unset groups are -1
+ * @return 1 if a match was found, 0 otherwise
+ *
+ * The DFA first rejects texts without any match, so the capture-tracking
+ * NFA only runs when there is something to report.
+ */
+int regex_search(Regex* re, const char* text, size_t len, size_t start, long* groups) {
+    if (!re || !text || start > len) return 0;
+    if (!regex_exists_from(re, text, len, start)) return 0;
+    return pike_search(re, text, len, start, 0, groups);
+}
@@ -0,0 +1,290 @@
+/**
+ * @file string_kernels.c
+ * @brief Myco String Kernels - Substring search, split, join and replace
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the byte-level kernels behind the find(), split(),
+ * join() and replace() builtins and the compiled searchers of the
+ * text_utils library. Every kernel works on explicit lengths, sizes its
+ * output exactly in a counting pass and then fills it in a single copy
+ * pass, so no result is ever reallocated or rescanned with strcat/strstr.
+ *
+ * String Kernel Features:
+ * - Precompiled searchers whose tables are built once per needle
+ * - memchr based first-byte filter for short needles (vectorized by the C library)
+ * - Horspool bad-character shifts for long needles
+ * - Result arrays presized from a counting pass
+ * - Exact output sizes for join and replace
+ * - split treats the delimiter as a set of separator characters and skips
+ *   empty fields, as strtok does ("a,,b" gives 2 fields)
+ */
+
+#include "string_kernels.h"
+#include "memory_tracker.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * SEARCH
+ ******************************************************************************/
+
+// Needles at least this long skip ahead with Horspool shifts instead of memchr
+#define SEARCH_SHIFT_TABLE_MIN_LEN 16
+
+// Precompute the search tables for a needle (the needle itself is borrowed)
+static void searcher_init(StringSearcher* searcher, const char* needle, size_t needle_len) {
+    searcher->needle = (char*)needle;
+    searcher->needle_len = needle_len;
+    searcher->use_shift_table = needle_len >= SEARCH_SHIFT_TABLE_MIN_LEN;
+    if (!searcher->use_shift_table) return;
+
+    for (int i = 0; i < 256; i++) searcher->shift[i] = needle_len;
+    for (size_t i = 0; i + 1 < needle_len; i++) {
+        searcher->shift[(unsigned char)needle[i]] = needle_len - 1 - i;
+    }
+}
+
+/**
+ * @brief Compiles a needle into a reusable searcher
+ * @param needle Needle bytes (copied)
+ * @param needle_len Needle length
+ * @return New searcher (free with string_searcher_destroy), or NULL on allocation failure
+ */
+StringSearcher* string_searcher_create(const char* needle, size_t needle_len) {
+    StringSearcher* searcher = (StringSearcher*)tracked_malloc(sizeof(StringSearcher), __FILE__, __LINE__, "string_searcher");
+    if (!searcher) return NULL;
+    char* copy = (char*)tracked_malloc(needle_len + 1, __FILE__, __LINE__, "string_searcher_needle");
+    if (!copy) {
+        tracked_free(searcher, __FILE__, __LINE__, "string_searcher");
+        return NULL;
+    }
+    memcpy(copy, needle, needle_len);
+    copy[needle_len] = '\0';
+    searcher_init(searcher, copy, needle_len);
+    return searcher;
+}
+
+void string_searcher_destroy(StringSearcher* searcher) {
+    if (!searcher) return;
+    tracked_free(searcher->needle, __FILE__, __LINE__, "string_searcher_needle");
+    tracked_free(searcher, __FILE__, __LINE__, "string_searcher");
+}
+
+/**
+ * @brief Finds the first occurrence of the searcher's needle in haystack
+ * @return Pointer to the match inside haystack, or NULL if there is none
+ *
+ * Short needles jump between candidate positions with memchr on the first
+ * byte and confirm with memcmp; long needles use the precomputed Horspool
+ * table so mismatches skip up to a full needle length.
+ */
+const char* string_searcher_find(const StringSearcher* searcher, const char* haystack, size_t haystack_len) {
+    const char* needle = searcher->needle;
+    size_t needle_len = searcher->needle_len;
+    if (needle_len == 0) return haystack;
+    if (needle_len > haystack_len) return NULL;
+    if (needle_len == 1) return (const char*)memchr(haystack, (unsigned char)needle[0], haystack_len);
+
+    const char* last = haystack + (haystack_len - needle_len);
+    if (searcher->use_shift_table) {
+        unsigned char tail = (unsigned char)needle[needle_len - 1];
+        const char* pos = haystack;
+        while (pos <= last) {
+            unsigned char c = (unsigned char)pos[needle_len - 1];
+            if (c == tail && memcmp(pos, needle, needle_len - 1) == 0) return pos;
+            pos += searcher->shift[c];
+        }
+        return NULL;
+    }
+
+    const char* pos = haystack;
+    while (pos <= last) {
+        pos = (const char*)memchr(pos, (unsigned char)needle[0], (size_t)(last - pos) + 1);
+        if (!pos) return NULL;
+        if (memcmp(pos + 1, needle + 1, needle_len - 1) == 0) return pos;
+        pos++;
+    }
+    return NULL;
+}
+
+size_t string_searcher_count(const StringSearcher* searcher, const char* haystack, size_t haystack_len) {
+    if (searcher->needle_len == 0) return 0;
+    size_t count = 0;
+    const char* pos = haystack;
+    const char* end = haystack + haystack_len;
+    while ((pos = string_searcher_find(searcher, pos, (size_t)(end - pos))) != NULL) {
+        count++;
+        pos += searcher->needle_len;
+    }
+    return count;
+}
+
+const char* string_find_bytes(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len) {
+    StringSearcher searcher;
+    searcher_init(&searcher, needle, needle_len);
+    return string_searcher_find(&searcher, haystack, haystack_len);
+}
+
+size_t string_count_occurrences(const char* haystack, size_t haystack_len, const char* needle, size_t needle_len) {
+    StringSearcher searcher;
+    searcher_init(&searcher, needle, needle_len);
+    return string_searcher_count(&searcher, haystack, haystack_len);
+}
+
+/*******************************************************************************
+ * SPLIT / JOIN / REPLACE
+ ******************************************************************************/
+
+static char* copy_piece(const char* start, size_t len) {
+    char* piece = (char*)tracked_malloc(len + 1, __FILE__, __LINE__, "string_split_piece");
+    if (!piece) return NULL;
+    memcpy(piece, start, len);
+    piece[len] = '\0';
+    return piece;
+}
+
+// Offset of the first byte at or after pos that is (or is not) a delimiter, memchr for a single delimiter
+static size_t scan_fields(const char* str, size_t len, size_t pos, const unsigned char* is_delimiter,
+                          const char* delimiter, size_t delimiter_len, int want_delimiter) {
+    if (want_delimiter && delimiter_len == 1) {
+        const char* hit = (const char*)memchr(str + pos, delimiter[0], len - pos);
+        return hit ? (size_t)(hit - str) : len;
+    }
+    while (pos < len && is_delimiter[(unsigned char)str[pos]] != want_delimiter) pos++;
+    return pos;
+}
+
+/**
+ * @brief Splits a string on runs of delimiter characters
+ *
+ * Like strtok, every character of the delimiter is a separator on its own,
+ * runs of separators count as one and leading or trailing separators give
+ * no empty fields ("a,,b" and ",a,b," both give ["a", "b"]).
+ * @param str Source bytes
+ * @param len Source length
+ * @param delimiter Separator characters; an empty delimiter splits into single characters
+ * @param delimiter_len Delimiter length
+ * @return New string array (empty for an empty source), or NULL on allocation failure
+ */
+MycoArray* string_split(const char* str, size_t len, const char* delimiter, size_t delimiter_len) {
+    if (len == 0) return create_array(1, 1);
+
+    if (delimiter_len == 0) {
+        MycoArray* array = create_array((int)len, 1);
+        if (!array) return NULL;
+        for (size_t i = 0; i < len; i++) {
+            array->str_elements[array->size++] = copy_piece(str + i, 1);
+        }
+        return array;
+    }
+
+    unsigned char is_delimiter[256] = { 0 };
+    for (size_t i = 0; i < delimiter_len; i++) is_delimiter[(unsigned char)delimiter[i]] = 1;
+
+    // Counting pass: the array is allocated once at its final size
+    size_t pieces = 0;
+    size_t pos = scan_fields(str, len, 0, is_delimiter, delimiter, delimiter_len, 0);
+    while (pos < len) {
+        pieces++;
+        pos = scan_fields(str, len, pos, is_delimiter, delimiter, delimiter_len, 1);
+        pos = scan_fields(str, len, pos, is_delimiter, delimiter, delimiter_len, 0);
+    }
+    MycoArray* array = create_array(pieces > 0 ? (int)pieces : 1, 1);
+    if (!array) return NULL;
+
+    // Copy pass: one allocation per field, written straight into the array
+    pos = scan_fields(str, len, 0, is_delimiter, delimiter, delimiter_len, 0);
+    while (pos < len) {
+        size_t end = scan_fields(str, len, pos, is_delimiter, delimiter, delimiter_len, 1);
+        array->str_elements[array->size++] = copy_piece(str + pos, end - pos);
+        pos = scan_fields(str, len, end, is_delimiter, delimiter, delimiter_len, 0);
+    }
+    return array;
+}
+
+/**
+ * @brief Joins array elements with a separator
+ * @param array String or number array
+ * @param separator Separator bytes
+ * @param separator_len Separator length
+ * @param out_len Set to the length of the result (may be NULL)
+ * @return New NUL-terminated string, or NULL on allocation failure
+ */
+char* string_join(MycoArray* array, const char* separator, size_t separator_len, size_t* out_len) {
+    int count = array ? array->size : 0;
+    char num_str[32];
+
+    // Sizing pass: exact length, numbers included
+    size_t total = count > 1 ? (size_t)(count - 1) * separator_len : 0;
+    for (int i = 0; i < count; i++) {
+        if (array->is_string_array) {
+            if (array->str_elements[i]) total += strlen(array->str_elements[i]);
+        } else {
+            total += (size_t)snprintf(num_str, sizeof(num_str), "%lld", array->elements[i]);
+        }
+    }
+
+    char* result = (char*)tracked_malloc(total + 1, __FILE__, __LINE__, "string_join_result");
+    if (!result) return NULL;
+
+    // Copy pass
+    char* dest = result;
+    for (int i = 0; i < count; i++) {
+        if (i > 0 && separator_len > 0) {
+            memcpy(dest, separator, separator_len);
+            dest += separator_len;
+        }
+        if (array->is_string_array) {
+            const char* element = array->str_elements[i];
+            if (element) {
+                size_t element_len = strlen(element);
+                memcpy(dest, element, element_len);
+                dest += element_len;
+            }
+        } else {
+            int written = snprintf(num_str, sizeof(num_str), "%lld", array->elements[i]);
+            memcpy(dest, num_str, (size_t)written);
+            dest += written;
+        }
+    }
+    *dest = '\0';
+    if (out_len) *out_len = total;
+    return result;
+}
+
+/**
+ * @brief Replaces every non-overlapping occurrence of old_str with new_str
+ * @return New NUL-terminated string (a plain copy when nothing matches), or NULL on allocation failure
+ */
+char* string_replace_all(const char* str, size_t len, const char* old_str, size_t old_len,
+                         const char* new_str, size_t new_len, size_t* out_len) {
+    StringSearcher searcher;
+    searcher_init(&searcher, old_str, old_len);
+    size_t count = old_len ? string_searcher_count(&searcher, str, len) : 0;
+    size_t total = len - count * old_len + count * new_len;
+
+    char* result = (char*)tracked_malloc(total + 1, __FILE__, __LINE__, "string_replace_result");
+    if (!result) return NULL;
+
+    if (count == 0) {
+        memcpy(result, str, len);
+    } else {
+        char* dest = result;
+        const char* start = str;
+        const char* end = str + len;
+        const char* match;
+        while ((match = string_searcher_find(&searcher, start, (size_t)(end - start))) != NULL) {
+            memcpy(dest, start, (size_t)(match - start));
+            dest += match - start;
+            memcpy(dest, new_str, new_len);
+            dest += new_len;
+            start = match + old_len;
+        }
+        memcpy(dest, start, (size_t)(end - start));
+    }
+    result[total] = '\0';
+    if (out_len) *out_len = total;
+    return result;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file string_template.c
+ * @brief Myco String Templates - Compile-once string interpolation
+ * @version 1.0.0
+ * @author Myco Development Team
+ *
+ * This file implements the templates behind polish.create_template() and
+ * polish.interpolate_string(). A template is scanned once into literal
+ * segments and ${name} slots; rendering resolves the slots, sums the exact
+ * output length and fills a single allocation.
+ *
+ * String Template Features:
+ * - ${name} and dotted ${user.name} slots, resolved by a caller callback
+ * - $${ writes a literal "${"; an unterminated ${ is kept as literal text
+ * - Unresolved slots are written back unchanged
+ * - One allocation per render, sized before any byte is copied
+ */
+
+#include "string_template.h"
+#include "memory_tracker.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Slots resolved with stack scratch space before falling back to the heap
+#define TEMPLATE_STACK_SLOTS 16
+
+static int add_part(StringTemplate* tpl, int* capacity, const char* text, size_t len, int is_slot) {
+    if (len == 0 && !is_slot) return 1;
+    // Adjacent literal segments (around "$${") are merged when contiguous
+    if (!is_slot && tpl->part_count > 0) {
+        TemplatePart* last = &tpl->parts[tpl->part_count - 1];
+        if (!last->is_slot && last->text + last->len == text) {
+            last->len += len;
+            tpl->literal_len += len;
+            return 1;
+        }
+    }
+    if (tpl->part_count >= *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 8;
+        TemplatePart* grown = (TemplatePart*)tracked_realloc(tpl->parts, new_capacity * sizeof(TemplatePart), __FILE__, __LINE__, "template_parts");
+        if (!grown) return 0;
+        tpl->parts = grown;
+        *capacity = new_capacity;
+    }
+    TemplatePart* part = &tpl->parts[tpl->part_count++];
+    part->text = text;
+    part->len = len;
+    part->is_slot = is_slot;
+    if (is_slot) tpl->slot_count++;
+    else tpl->literal_len += len;
+    return 1;
+}
+
+/**
+ * @brief Splits a template into literal segments and slots
+ * @param text Template text (need not be NUL-terminated)
+ * @param len Template length
+ * @return Compiled template (free with string_template_free), or NULL on allocation failure
+ */
+StringTemplate* string_template_compile(const char* text, size_t len) {
+    StringTemplate* tpl = (StringTemplate*)tracked_malloc(sizeof(StringTemplate), __FILE__, __LINE__, "string_template");
+    if (!tpl) return NULL;
+    memset(tpl, 0, sizeof(*tpl));
+    tpl->storage = (char*)tracked_malloc(len + 1, __FILE__, __LINE__, "template_storage");
+    if (!tpl->storage) {
+        tracked_free(tpl, __FILE__, __LINE__, "string_template");
+        return NULL;
+    }
+    memcpy(tpl->storage, text, len);
+    tpl->storage[len] = '\0';
+
+    // Slot names are terminated in place by overwriting their closing '}'
+    char* s = tpl->storage;
+    int capacity = 0;
+    size_t literal_start = 0;
+    size_t i = 0;
+    int ok = 1;
+    while (ok && i < len) {
+        char* dollar = (char*)memchr(s + i, '$', len - i);
+        if (!dollar) break;
+        i = (size_t)(dollar - s);
+        if (i + 2 < len && s[i + 1] == '$' && s[i + 2] == '{') {
+            // "$${" -> literal "${"
+            ok = add_part(tpl, &capacity, s + literal_start, i - literal_start, 0) &&
+                 add_part(tpl, &capacity, s + i + 1, 2, 0);
+            i += 3;
+            literal_start = i;
+            continue;
+        }
+        if (i + 1 < len && s[i + 1] == '{') {
+            char* close = (char*)memchr(s + i + 2, '}', len - i - 2);
+            if (close) {
+                ok = add_part(tpl, &capacity, s + literal_start, i - literal_start, 0);
+                *close = '\0';
+                if (ok) ok = add_part(tpl, &capacity, s + i + 2, (size_t)(close - (s + i + 2)), 1);
+                i = (size_t)(close - s) + 1;
+                literal_start = i;
+                continue;
+            }
+        }
+        i++;
+    }
+    if (ok) ok = add_part(tpl, &capacity, s + literal_start, len - literal_start, 0);
+    if (!ok) {
+        string_template_free(tpl);
+        return NULL;
+    }
+    return tpl;
+}
+
+void string_template_free(StringTemplate* tpl) {
+    if (!tpl) return;
+    if (tpl->parts) tracked_free(tpl->parts, __FILE__, __LINE__, "template_parts");
+    tracked_free(tpl->storage, __FILE__, __LINE__, "template_storage");
+    tracked_free(tpl, __FILE__, __LINE__, "string_template");
+}
+
+/**
+ * @brief Renders a template
+ * @param resolve Callback that maps a slot name to its text
+ * @param context Passed through to the callback
+ * @param out_len Set to the rendered length (may be NULL)
+ * @return New NUL-terminated string, or NULL on allocation failure
+ *
+ * All slots are resolved first so the output is allocated exactly once.
+ */
+char* string_template_render(const StringTemplate* tpl, TemplateResolver resolve, void* context, size_t* out_len) {
+    const char* stack_values[TEMPLATE_STACK_SLOTS];
+    size_t stack_lens[TEMPLATE_STACK_SLOTS];
+    char stack_scratch[TEMPLATE_STACK_SLOTS][TEMPLATE_SCRATCH_SIZE];
+
+    const char** values = stack_values;
+    size_t* lens = stack_lens;
+    char (*scratch)[TEMPLATE_SCRATCH_SIZE] = stack_scratch;
+    int on_heap = tpl->slot_count > TEMPLATE_STACK_SLOTS;
+    if (on_heap) {
+        values = (const char**)tracked_malloc(tpl->slot_count * sizeof(char*), __FILE__, __LINE__, "template_values");
+        lens = (size_t*)tracked_malloc(tpl->slot_count * sizeof(size_t), __FILE__, __LINE__, "template_values");
+        scratch = tracked_malloc((size_t)tpl->slot_count * TEMPLATE_SCRATCH_SIZE, __FILE__, __LINE__, "template_values");
+    }
+
+    char* result = NULL;
+    if (values && lens && scratch) {
+        // Resolve pass: exact output length
+        size_t total = tpl->literal_len;
+        int slot = 0;
+        for (int i = 0; i < tpl->part_count; i++) {
+            const TemplatePart* part = &tpl->parts[i];
+            if (!part->is_slot) continue;
+            values[slot] = resolve(context, part->text, &lens[slot], scratch[slot]);
+            total += values[slot] ? lens[slot] : part->len + 3;
+            slot++;
+        }
+
+        // Copy pass
+        result = (char*)tracked_malloc(total + 1, __FILE__, __LINE__, "template_render");
+        if (result) {
+            char* dest = result;
+            slot = 0;
+            for (int i = 0; i < tpl->part_count; i++) {
+                const TemplatePart* part = &tpl->parts[i];
+                if (!part->is_slot) {
+                    memcpy(dest, part->text, part->len);
+                    dest += part->len;
+                } else if (values[slot]) {
+                    memcpy(dest, values[slot], lens[slot]);
+                    dest += lens[slot];
+                    slot++;
+                } else {
+                    *dest++ = '$';
+                    *dest++ = '{';
+                    memcpy(dest, part->text, part->len);
+                    dest += part->len;
+                    *dest++ = '}';
+                    slot++;
+                }
+            }
+            *dest = '\0';
+            if (out_len) *out_len = total;
+        }
+    }
+
+    if (on_heap) {
+        if (values) tracked_free((void*)values, __FILE__, __LINE__, "template_values");
+        if (lens) tracked_free(lens, __FILE__, __LINE__, "template_values");
+        if (scratch) tracked_free(scratch, __FILE__, __LINE__, "template_values");
+    }
+    return result;
+}
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+"""
+BENCHMARK REGRESSION CHECK
+Compares two recorded benchmark runs and flags statistically clear slowdowns
+
+Reads the JSON lines written by record_results.py. For every benchmark in
+both runs it reports the change in mean time with a 95% confidence interval
+(Welch's t-interval on the samples). A benchmark regresses when the new run
+is slower by more than the threshold and the whole interval lies above zero.
+Exits with status 1 when anything regressed, so scripts and CI can gate on it.
+"""
+
+import argparse
+import glob
+import json
+import math
+import os
+import sys
+
+SCRIPT_DIR = os.path.dirname(os.path.abspath(__file__))
+RESULTS_DIR = os.path.join(SCRIPT_DIR, "results")
+
+# Two-sided 95% Student t critical values by degrees of freedom
+T_95 = [12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042]
+
+def t_critical(df):
+    """95% critical value, rounding df down so the interval errs wide"""
+    df = int(df)
+    if df < 1:
+        return float("inf")
+    if df <= len(T_95):
+        return T_95[df - 1]
+    if df < 60:
+        return 2.021
+    if df < 120:
+        return 2.000
+    return 1.960
+
+def load_run(path):
+    """(language, benchmark) -> record"""
+    records = {}
+    with open(path, encoding="utf-8") as f:
+        for line_number, line in enumerate(f, 1):
+            if not line.strip():
+                continue
+            try:
+                record = json.loads(line)
+            except json.JSONDecodeError as e:
+                sys.exit(f"❌ {path}:{line_number}: invalid JSON record ({e})")
+            records[(record["language"], record["benchmark"])] = record
+    return records
+
+def latest_runs():
+    """The two most recent run files in the results directory, oldest first"""
+    runs = sorted(glob.glob(os.path.join(RESULTS_DIR, "benchmarks_*.jsonl")))
+    if len(runs) < 2:
+        sys.exit("❌ Need two recorded runs in results/ (run ./run_all_benchmarks.sh twice) or pass BASE and NEW")
+    return runs[-2], runs[-1]
+
+def compare(base, new):
+    """Relative change of the mean and its 95% interval, or None where undefined"""
+    base_samples, new_samples = base["samples"], new["samples"]
+    base_mean = sum(base_samples) / len(base_samples)
+    new_mean = sum(new_samples) / len(new_samples)
+    if base_mean <= 0:
+        return None, None
+    change = (new_mean - base_mean) / base_mean
+
+    if len(base_samples) < 2 or len(new_samples) < 2:
+        return change, None
+    base_var = base["stddev"] ** 2 / len(base_samples)
+    new_var = new["stddev"] ** 2 / len(new_samples)
+    error = math.sqrt(base_var + new_var)
+    if error == 0:
+        return change, (change, change)
+    # Welch-Satterthwaite degrees of freedom
+    df = (base_var + new_var) ** 2 / (base_var ** 2 / (len(base_samples) - 1) +
+                                      new_var ** 2 / (len(new_samples) - 1))
+    margin = t_critical(df) * error / base_mean
+    return change, (change - margin, change + margin)
+
+def format_percent(value):
+    return f"{value * 100:+.1f}%"
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two benchmark runs and flag regressions")
+    parser.add_argument("base", nargs="?", help="baseline run (default: second newest in results/)")
+    parser.add_argument("new", nargs="?", help="candidate run (default: newest in results/)")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="slowdown in percent that counts as a regression (default 5)")
+    parser.add_argument("--min-time", type=float, default=100.0,
+                        help="ignore benchmarks whose baseline mean is below this many microseconds (default 100)")
+    parser.add_argument("--language", help="only compare this suite, e.g. Myco")
+    args = parser.parse_args()
+
+    if bool(args.base) != bool(args.new):
+        parser.error("pass both BASE and NEW, or neither")
+    base_path, new_path = (args.base, args.new) if args.base else latest_runs()
+    base_run, new_run = load_run(base_path), load_run(new_path)
+
+    print(f"Baseline:  {base_path}")
+    print(f"Candidate: {new_path}")
+    print(f"Regression threshold: {args.threshold:.1f}% (95% confidence)\n")
+    print(f"{'Benchmark':<40} {'Base (us)':>12} {'New (us)':>12} {'Change':>9}  {'95% CI':<20} Verdict")
+
+    regressions = []
+    for key, base in base_run.items():
+        if args.language and key[0] != args.language:
+            continue
+        new = new_run.get(key)
+        label = f"{key[0]}: {key[1]}"
+        if new is None:
+            print(f"{label:<40} {base['mean']:>12.0f} {'-':>12} {'':>9}  {'':<20} missing")
+            continue
+
+        change, interval = compare(base, new)
+        if change is None or base["mean"] < args.min_time:
+            verdict = "too fast to judge"
+        elif interval is None:
+            verdict = "single sample"
+        elif interval[0] > 0 and change * 100 > args.threshold:
+            verdict = "REGRESSION"
+            regressions.append(label)
+        elif interval[1] < 0 and -change * 100 > args.threshold:
+            verdict = "improvement"
+        else:
+            verdict = "ok"
+        change_text = format_percent(change) if change is not None else "n/a"
+        interval_text = f"[{format_percent(interval[0])}, {format_percent(interval[1])}]" if interval else ""
+        print(f"{label:<40} {base['mean']:>12.0f} {new['mean']:>12.0f} {change_text:>9}  {interval_text:<20} {verdict}")
+
+    print()
+    if regressions:
+        print(f"❌ {len(regressions)} regression(s): {', '.join(regressions)}")
+        return 1
+    print("✅ No regressions")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,93 @@
+#!/usr/bin/env python3
+"""
+BENCHMARK RESULT RECORDER
+Turns raw benchmark suite output into one JSON record per benchmark per run
+
+Each suite prints "<Benchmark Name>: <N> microseconds" once per benchmark.
+Given the output of several repetitions of one suite, this writes one JSON
+line per benchmark holding every sample plus its summary statistics, which
+compare_results.py reads.
+"""
+
+import argparse
+import json
+import math
+import re
+import subprocess
+import sys
+
+# "Simple Loop (1M): 23468 microseconds" (Myco prints it without the spaces)
+RESULT_LINE = re.compile(r"^\s*([^:\n]+?):\s*(\d+(?:\.\d+)?)\s*microseconds", re.MULTILINE)
+
+def parse_output(text):
+    """Benchmark name -> microseconds, in suite order, from one suite run"""
+    # Every suite repeats its results after this banner; only the first listing counts
+    text = text.split("BENCHMARK RESULTS")[0]
+    results = {}
+    for match in RESULT_LINE.finditer(text):
+        name = match.group(1).strip()
+        if name.startswith("Total Benchmark Time") or name in results:
+            continue
+        results[name] = float(match.group(2))
+    return results
+
+def summarize(samples):
+    """Summary statistics for one benchmark's samples"""
+    ordered = sorted(samples)
+    n = len(ordered)
+    mean = sum(ordered) / n
+    variance = sum((x - mean) ** 2 for x in ordered) / (n - 1) if n > 1 else 0.0
+    middle = n // 2
+    median = ordered[middle] if n % 2 else (ordered[middle - 1] + ordered[middle]) / 2
+    return {
+        "min": ordered[0],
+        "median": median,
+        "mean": mean,
+        "stddev": math.sqrt(variance),
+    }
+
+def current_commit():
+    """Short hash of the checked-out commit, or None outside a git tree"""
+    try:
+        return subprocess.run(["git", "rev-parse", "--short", "HEAD"], capture_output=True,
+                              text=True, check=True).stdout.strip()
+    except (OSError, subprocess.CalledProcessError):
+        return None
+
+def main():
+    parser = argparse.ArgumentParser(description="Record benchmark suite output as JSON lines")
+    parser.add_argument("--run", required=True, help="run identifier (the suite timestamp)")
+    parser.add_argument("--language", required=True, help="suite language, e.g. Myco")
+    parser.add_argument("--output", required=True, help="JSON lines file to append to")
+    parser.add_argument("outputs", nargs="+", help="raw output of each repetition of the suite")
+    args = parser.parse_args()
+
+    samples = {}
+    for path in args.outputs:
+        with open(path, encoding="utf-8", errors="replace") as f:
+            for name, value in parse_output(f.read()).items():
+                samples.setdefault(name, []).append(value)
+
+    if not samples:
+        print(f"❌ No benchmark results found in {args.language} output", file=sys.stderr)
+        return 1
+
+    commit = current_commit()
+    with open(args.output, "a", encoding="utf-8") as out:
+        for name, values in samples.items():
+            record = {
+                "run": args.run,
+                "commit": commit,
+                "language": args.language,
+                "benchmark": name,
+                "unit": "microseconds",
+                "samples": values,
+            }
+            record.update(summarize(values))
+            out.write(json.dumps(record) + "\n")
+
+    print(f"Recorded {len(samples)} {args.language} benchmarks to {args.output}")
+    return 0
+
+if __name__ == "__main__":
+    sys.exit(main())
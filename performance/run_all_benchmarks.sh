@@ -8,31 +8,46 @@ set -e
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 RESULTS_DIR="$SCRIPT_DIR/results"
 TIMESTAMP=$(date +"%Y%m%d_%H%M%S")
+RUNS=${BENCH_RUNS:-5}                      # Repetitions of each suite (samples per benchmark)
+RECORDS_FILE="$RESULTS_DIR/benchmarks_${TIMESTAMP}.jsonl"
+RAW_DIR=$(mktemp -d)
+trap 'rm -rf "$RAW_DIR"' EXIT
 
 echo "=== MYCO PERFORMANCE BENCHMARK SUITE ==="
 echo "Running standardized benchmarks across all languages"
 echo "Timestamp: $TIMESTAMP"
+echo "Runs per suite: $RUNS"
 echo ""
 
 # Create results directory
 mkdir -p "$RESULTS_DIR"
 
-# Function to run benchmark and capture output
+# Function to run a suite $RUNS times and record one JSON line per benchmark
 run_benchmark() {
     local name=$1
     local command=$2
-    local output_file="$RESULTS_DIR/${name}_${TIMESTAMP}.txt"
+    local outputs=()
     
     echo "Running $name benchmark..."
     echo "Command: $command"
     
-    # Run benchmark and capture output
-    if eval "$command" > "$output_file" 2>&1; then
+    # Raw output stays in a scratch directory; only a failing run's output is kept
+    for run in $(seq 1 "$RUNS"); do
+        local output_file="$RAW_DIR/${name}_${run}.txt"
+        if ! eval "$command" > "$output_file" 2>&1; then
+            cp "$output_file" "$RESULTS_DIR/${name}_${TIMESTAMP}_failed.txt"
+            echo "❌ $name failed (run $run of $RUNS)"
+            echo "Check output: $RESULTS_DIR/${name}_${TIMESTAMP}_failed.txt"
+            return 1
+        fi
+        outputs+=("$output_file")
+    done
+    
+    if python3 "$SCRIPT_DIR/record_results.py" --run "$TIMESTAMP" --language "$name" \
+            --output "$RECORDS_FILE" "${outputs[@]}"; then
         echo "✅ $name completed successfully"
-        echo "Results saved to: $output_file"
     else
-        echo "❌ $name failed"
-        echo "Check output: $output_file"
+        echo "❌ $name produced no benchmark results"
         return 1
     fi
     
@@ -88,10 +103,10 @@ run_benchmark "Python" "python3 $SCRIPT_DIR/python/benchmarks.py"
 
 echo "=== BENCHMARK COMPLETION SUMMARY ==="
 
-# Extract and display total times
-myco_time=$(extract_total_time "$RESULTS_DIR/Myco_${TIMESTAMP}.txt")
-c_time=$(extract_total_time "$RESULTS_DIR/C_${TIMESTAMP}.txt")
-python_time=$(extract_total_time "$RESULTS_DIR/Python_${TIMESTAMP}.txt")
+# Extract and display total times (from the last run of each suite)
+myco_time=$(extract_total_time "$RAW_DIR/Myco_${RUNS}.txt")
+c_time=$(extract_total_time "$RAW_DIR/C_${RUNS}.txt")
+python_time=$(extract_total_time "$RAW_DIR/Python_${RUNS}.txt")
 
 echo "Total Benchmark Times:"
 echo "  Myco:   $myco_time microseconds"
@@ -116,7 +131,7 @@ fi
 
 echo ""
 echo "=== RESULTS FILES ==="
-echo "All benchmark results saved to: $RESULTS_DIR/"
+echo "Benchmark records saved to: $RECORDS_FILE"
 echo "Timestamp: $TIMESTAMP"
 
 # Create summary file
@@ -135,9 +150,7 @@ cat > "$summary_file" << EOF
 - **Python:** ${python_ratio:-N/A}x
 
 ## Individual Results
-- [Myco Results](Myco_${TIMESTAMP}.txt)
-- [C Results](C_${TIMESTAMP}.txt)
-- [Python Results](Python_${TIMESTAMP}.txt)
+- [Benchmark records](benchmarks_${TIMESTAMP}.jsonl) ($RUNS runs per suite)
 
 ## Environment
 - **OS:** $(uname -s)
@@ -148,6 +161,16 @@ cat > "$summary_file" << EOF
 EOF
 
 echo "Summary saved to: $summary_file"
+
+# Regression check against a baseline run (BENCH_BASELINE=results/benchmarks_<timestamp>.jsonl)
+if [ -n "$BENCH_BASELINE" ]; then
+    echo ""
+    echo "=== REGRESSION CHECK ==="
+    if ! python3 "$SCRIPT_DIR/compare_results.py" --threshold "${BENCH_THRESHOLD:-5}" \
+            "$BENCH_BASELINE" "$RECORDS_FILE"; then
+        exit 1
+    fi
+fi
 echo ""
 echo "🎉 All benchmarks completed successfully!"
 echo "📊 Results available in: $RESULTS_DIR/"